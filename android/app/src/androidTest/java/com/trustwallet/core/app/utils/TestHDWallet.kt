@@ -7,11 +7,9 @@ import wallet.core.jni.HDVersion
 import wallet.core.jni.HDWallet
 import wallet.core.jni.Mnemonic
 import wallet.core.jni.Purpose
-import java.security.InvalidParameterException
 import org.junit.Assert.assertEquals
 import org.junit.Assert.assertFalse
 import org.junit.Assert.assertTrue
-import org.junit.Assert.fail
 import org.junit.Test
 
 class TestHDWallet {
@@ -40,13 +38,7 @@ class TestHDWallet {
     @Test
     fun testCreateFromSpanishMnemonic() {
         val mnemonic = "llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut"
-        try {
-            HDWallet(mnemonic, "")
-            fail("Missing exception")
-        } catch (ex: Exception) {
-            assertTrue(ex is InvalidParameterException)
-        }
-        val wallet = HDWallet(mnemonic, "", false)
+        val wallet = HDWallet(mnemonic, "")
         val address = wallet.getAddressForCoin(CoinType.ETHEREUM)
 
         assertEquals(address, "0xa4531dE99E22B2166d340E7221669DF565c52024")
@@ -0,0 +1,60 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace TW::Benchmark {
+
+/// A named benchmark, registered with TW_BENCHMARK.
+struct Entry {
+    std::string name;
+    std::function<void()> function;
+};
+
+/// All registered benchmarks, in registration order.
+std::vector<Entry>& registry();
+
+/// Helper for static registration of benchmarks.
+struct Registration {
+    Registration(const char* name, std::function<void()> function) {
+        registry().push_back(Entry{name, std::move(function)});
+    }
+};
+
+/// Prints one result line: name, iterations, and average time per iteration.
+void report(const std::string& name, std::size_t iterations, std::chrono::nanoseconds elapsed);
+
+/// Prevents the compiler from optimizing away the computation of a value.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// Runs body() the given number of times, and reports the average duration.
+template <typename Body>
+void measure(const std::string& name, std::size_t iterations, Body&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        body();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    report(name, iterations, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed));
+}
+
+} // namespace TW::Benchmark
+
+/// Defines and registers a benchmark function.
+#define TW_BENCHMARK(group, name)                                                                  \
+    static void benchmark_##group##_##name();                                                      \
+    static const TW::Benchmark::Registration registration_##group##_##name(#group "." #name,       \
+                                                                           benchmark_##group##_##name); \
+    static void benchmark_##group##_##name()
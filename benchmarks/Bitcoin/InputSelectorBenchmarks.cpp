@@ -0,0 +1,50 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Bitcoin/InputSelector.h"
+#include "Bitcoin/UTXO.h"
+
+#include <random>
+#include <string>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+/// Generates UTXOs with random amounts between 1000 and 10M satoshis.
+std::vector<UTXO> randomUTXOs(size_t count) {
+    std::mt19937_64 random(count);
+    std::vector<UTXO> utxos(count);
+    for (auto& utxo : utxos) {
+        utxo.amount = 1000 + static_cast<Amount>(random() % 10'000'000);
+    }
+    return utxos;
+}
+
+void benchmarkSelect(size_t utxoCount, size_t iterations) {
+    const auto utxos = randomUTXOs(utxoCount);
+    const auto sum = InputSelector<UTXO>::sum(utxos);
+    auto selector = InputSelector<UTXO>(utxos);
+    // a small and a large target, the latter needs many inputs
+    for (const auto target : {sum / 1000, sum / 4}) {
+        Benchmark::measure("select, utxos: " + std::to_string(utxoCount) + ", target: " + std::to_string(target),
+                           iterations, [&] {
+            auto selected = selector.select(static_cast<int64_t>(target), 10);
+            Benchmark::doNotOptimize(selected);
+        });
+    }
+}
+
+} // namespace
+
+TW_BENCHMARK(Bitcoin, InputSelectorSelect) {
+    benchmarkSelect(1'000, 100);
+    benchmarkSelect(10'000, 10);
+    benchmarkSelect(100'000, 2);
+}
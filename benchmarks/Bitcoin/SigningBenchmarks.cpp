@@ -0,0 +1,107 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "BinaryCoding.h"
+#include "Bitcoin/Script.h"
+#include "Bitcoin/SigningInput.h"
+#include "Bitcoin/Transaction.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <string>
+#include <vector>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+/// Builds a send-max input spending `count` P2WPKH UTXOs, spread over `keyCount` keys.
+SigningInput buildP2WPKHInput(size_t count, size_t keyCount = 1) {
+    SigningInput input;
+    input.hashType = TWBitcoinSigHashTypeAll;
+    input.useMaxAmount = true;
+    input.byteFee = 1;
+    input.toAddress = "bc1q2dsdlq3343vk29runkgv4yc292hmq53jedfjmp";
+    input.changeAddress = "1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU";
+    input.coinType = TWCoinTypeBitcoin;
+
+    std::vector<Script> scripts;
+    for (size_t k = 0; k < keyCount; ++k) {
+        auto keyData = parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866");
+        keyData[0] ^= static_cast<byte>(k);
+        keyData[1] ^= static_cast<byte>(k >> 8);
+        const auto key = PrivateKey(keyData);
+        const auto pubKeyHash = Hash::sha256ripemd(key.getPublicKey(TWPublicKeyTypeSECP256k1).bytes.data(), PublicKey::secp256k1Size);
+        input.privateKeys.push_back(key);
+        scripts.push_back(Script::buildPayToWitnessPublicKeyHash(pubKeyHash));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        UTXO utxo;
+        utxo.script = scripts[i % keyCount];
+        utxo.amount = 100'000 + static_cast<Amount>(i);
+        Data seed;
+        encode32LE(static_cast<uint32_t>(i), seed);
+        utxo.outPoint = OutPoint(Hash::sha256(seed), 0, UINT32_MAX);
+        input.utxos.push_back(utxo);
+    }
+    return input;
+}
+
+void benchmarkSign(size_t inputCount, size_t iterations) {
+    const auto input = buildP2WPKHInput(inputCount);
+    Benchmark::measure("sign P2WPKH, inputs: " + std::to_string(inputCount), iterations, [&] {
+        auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+        Benchmark::doNotOptimize(result);
+    });
+}
+
+} // namespace
+
+TW_BENCHMARK(Bitcoin, SignSegwitInputs) {
+    benchmarkSign(10, 20);
+    benchmarkSign(100, 5);
+    benchmarkSign(1000, 1);
+}
+
+TW_BENCHMARK(Bitcoin, SignSweepManyKeys) {
+    for (const auto count : {50, 200, 500}) {
+        const auto input = buildP2WPKHInput(count, count);
+        Benchmark::measure("sign P2WPKH sweep, keys and inputs: " + std::to_string(count), 1, [&] {
+            auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(input);
+            Benchmark::doNotOptimize(result);
+        });
+    }
+}
+
+TW_BENCHMARK(Bitcoin, PlanSegwitInputs) {
+    for (const auto count : {100, 1000, 3000}) {
+        const auto input = buildP2WPKHInput(count);
+        Benchmark::measure("plan P2WPKH send-max, utxos: " + std::to_string(count), 20, [&] {
+            auto plan = TransactionBuilder::plan(input);
+            Benchmark::doNotOptimize(plan);
+        });
+    }
+}
+
+TW_BENCHMARK(Bitcoin, PlanCandidateLimit) {
+    for (const auto count : {10'000, 100'000}) {
+        auto input = buildP2WPKHInput(count);
+        input.useMaxAmount = false;
+        input.amount = 1'000'000;
+        input.maxCandidateUtxos = 1000;
+        Benchmark::measure("plan P2WPKH, utxos: " + std::to_string(count) + ", candidates: 1000", 5, [&] {
+            auto plan = TransactionBuilder::plan(input);
+            Benchmark::doNotOptimize(plan);
+        });
+    }
+}
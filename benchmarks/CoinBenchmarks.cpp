@@ -0,0 +1,61 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Coin.h"
+#include "DerivationPath.h"
+
+#include <string>
+
+using namespace TW;
+
+namespace {
+
+const size_t iterations = 1'000'000;
+
+} // namespace
+
+TW_BENCHMARK(Coin, Registry) {
+    Benchmark::measure("p2pkhPrefix + hrp + curve", iterations, [&] {
+        Benchmark::doNotOptimize(TW::p2pkhPrefix(TWCoinTypeBitcoin));
+        Benchmark::doNotOptimize(TW::hrp(TWCoinTypeCosmos));
+        Benchmark::doNotOptimize(TW::curve(TWCoinTypeSolana));
+    });
+    Benchmark::measure("derivationPath", iterations, [&] {
+        Benchmark::doNotOptimize(TW::derivationPath(TWCoinTypeEthereum));
+    });
+    Benchmark::measure("derivationPath, alternative", iterations, [&] {
+        Benchmark::doNotOptimize(TW::derivationPath(TWCoinTypeBitcoin, TWDerivationBitcoinLegacy));
+    });
+
+    const std::string address = "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed";
+    Benchmark::measure("validateAddress, Ethereum", iterations / 10, [&] {
+        Benchmark::doNotOptimize(TW::validateAddress(TWCoinTypeEthereum, address));
+    });
+}
+
+TW_BENCHMARK(Coin, DerivationPath) {
+    const std::string string = "m/84'/0'/0'/0/12";
+    const auto path = DerivationPath(string);
+
+    Benchmark::measure("parse", iterations, [&] {
+        Benchmark::doNotOptimize(DerivationPath(string));
+    });
+    Benchmark::measure("string", iterations, [&] {
+        Benchmark::doNotOptimize(path.string());
+    });
+    Benchmark::measure("format", iterations, [&] {
+        char buffer[DerivationPath::maxStringSize];
+        Benchmark::doNotOptimize(path.format(buffer));
+        Benchmark::doNotOptimize(buffer);
+    });
+    Benchmark::measure("copy and set address", iterations, [&] {
+        auto copy = path;
+        copy.setAddress(13);
+        Benchmark::doNotOptimize(copy);
+    });
+}
@@ -0,0 +1,81 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Coin.h"
+#include "Data.h"
+#include "Hash.h"
+#include "PublicKey.h"
+
+#include <TrezorCrypto/sha3.h>
+
+#include <string>
+#include <vector>
+
+using namespace TW;
+
+namespace {
+
+const size_t count = 1'000;
+
+/// Extended public keys with pseudo-random coordinates, enough for hashing
+std::vector<PublicKey> publicKeys() {
+    std::vector<PublicKey> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto bytes = Data{0x04};
+        append(bytes, Hash::sha512(TW::data(std::to_string(i))));
+        keys.emplace_back(bytes, TWPublicKeyTypeSECP256k1Extended);
+    }
+    return keys;
+}
+
+} // namespace
+
+TW_BENCHMARK(Ethereum, Keccak256) {
+    const auto keys = publicKeys();
+    std::vector<const byte*> messages;
+    for (const auto& key : keys) {
+        messages.push_back(key.bytes.data() + 1);
+    }
+
+    Benchmark::measure("keccak256 of 64 bytes x 1000, one by one", 100, [&] {
+        Hash::Digest<Hash::sha256Size> digest;
+        for (const auto* message : messages) {
+            keccak_256(message, 64, digest.data());
+            Benchmark::doNotOptimize(digest);
+        }
+    });
+    Benchmark::measure("keccak256 of 64 bytes x 1000, 4 lanes", 100, [&] {
+        Benchmark::doNotOptimize(Hash::keccak256(messages, 64));
+    });
+}
+
+TW_BENCHMARK(Ethereum, ChecksumAddresses) {
+    // every EVM coin dispatched to the Ethereum entry
+    std::vector<TWCoinType> coins;
+    for (const auto coin : TW::getCoinTypes()) {
+        if (TW::blockchain(coin) == TWBlockchainEthereum) {
+            coins.push_back(coin);
+        }
+    }
+    const auto keys = publicKeys();
+    const auto suffix = " x " + std::to_string(count) + ", " + std::to_string(coins.size()) + " coins";
+
+    Benchmark::measure("addresses" + suffix + ", one by one", 1, [&] {
+        for (const auto coin : coins) {
+            for (const auto& key : keys) {
+                Benchmark::doNotOptimize(TW::deriveAddress(coin, key));
+            }
+        }
+    });
+    Benchmark::measure("addresses" + suffix + ", batch", 1, [&] {
+        for (const auto coin : coins) {
+            Benchmark::doNotOptimize(TW::deriveAddresses(coin, keys, TWDerivationDefault));
+        }
+    });
+}
@@ -0,0 +1,78 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Coin.h"
+#include "DerivationPath.h"
+#include "HDWallet.h"
+
+#include <string>
+#include <vector>
+
+using namespace TW;
+
+namespace {
+
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+void benchmarkReceiveAddresses(TWCoinType coin, uint32_t count) {
+    const auto wallet = HDWallet(mnemonic, "");
+    auto path = TW::derivationPath(coin);
+    Benchmark::measure("derive " + std::to_string(count) + " receive addresses, coin " + std::to_string(coin), 1, [&] {
+        for (uint32_t index = 0; index < count; ++index) {
+            path.setAddress(index);
+            const auto address = TW::deriveAddress(coin, wallet.getKey(coin, path));
+            Benchmark::doNotOptimize(address);
+        }
+    });
+}
+
+void benchmarkBatchAddresses(TWCoinType coin, uint32_t count) {
+    const auto wallet = HDWallet(mnemonic, "");
+    const auto xpub = wallet.getExtendedPublicKey(TW::purpose(coin), coin, TW::xpubVersion(coin));
+    for (const size_t threads : {1, 2, 4, 8, 16}) {
+        const auto suffix = std::to_string(count) + " receive addresses, coin " + std::to_string(coin) + ", " + std::to_string(threads) + " threads";
+        Benchmark::measure("derive " + suffix, 1, [&] {
+            Benchmark::doNotOptimize(wallet.deriveAddresses(coin, TWDerivationDefault, 0, 0, 0, count, threads));
+        });
+        if (xpub.empty()) {
+            continue;
+        }
+        Benchmark::measure("derive from xpub " + suffix, 1, [&] {
+            Benchmark::doNotOptimize(HDWallet::deriveAddressesFromExtended(xpub, coin, TWDerivationDefault, 0, 0, count, threads));
+        });
+    }
+}
+
+} // namespace
+
+TW_BENCHMARK(HDWallet, DeriveReceiveAddresses) {
+    benchmarkReceiveAddresses(TWCoinTypeBitcoin, 10'000);
+    benchmarkReceiveAddresses(TWCoinTypeEthereum, 10'000);
+}
+
+TW_BENCHMARK(HDWallet, DeriveAddressesBatch) {
+    benchmarkBatchAddresses(TWCoinTypeBitcoin, 10'000);
+    benchmarkBatchAddresses(TWCoinTypeEthereum, 10'000);
+    benchmarkBatchAddresses(TWCoinTypeAlgorand, 10'000);
+}
+
+TW_BENCHMARK(HDWallet, MnemonicSeeds) {
+    // 100 wallets restored from mnemonics, one PBKDF2 of 2048 iterations each
+    std::vector<std::string> mnemonics;
+    for (auto i = 0; i < 100; ++i) {
+        mnemonics.push_back(HDWallet(128, "").getMnemonic());
+    }
+    Benchmark::measure("100 wallets from mnemonics, one by one", 1, [&] {
+        for (const auto& mnemonic : mnemonics) {
+            Benchmark::doNotOptimize(HDWallet(mnemonic, "").getSeed());
+        }
+    });
+    Benchmark::measure("100 wallets from mnemonics, 4 seeds at a time", 1, [&] {
+        Benchmark::doNotOptimize(HDWallet::fromMnemonics(mnemonics, ""));
+    });
+}
@@ -0,0 +1,154 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Base58.h"
+#include "Coin.h"
+#include "Data.h"
+#include "Hash.h"
+#include "PublicKey.h"
+
+#include <TrezorCrypto/sha2.h>
+
+#include <string>
+#include <vector>
+
+using namespace TW;
+
+namespace {
+
+const size_t iterations = 200'000;
+
+} // namespace
+
+TW_BENCHMARK(Hash, ShortMessages) {
+    const auto message = Hash::sha256(TW::data("message"));
+
+    Benchmark::measure("sha256d, Data", iterations, [&] {
+        Benchmark::doNotOptimize(Hash::sha256d(message.data(), message.size()));
+    });
+    Benchmark::measure("sha256d, fixed-size digest", iterations, [&] {
+        Benchmark::doNotOptimize(Hash::digest<Hash::HasherSha256d>(message));
+    });
+    Benchmark::measure("sha256ripemd, fixed-size digest", iterations, [&] {
+        Benchmark::doNotOptimize(Hash::digest<Hash::HasherSha256ripemd>(message));
+    });
+
+    auto context = Hash::Context(Hash::HasherSha256d);
+    Hash::Digest<Hash::sha256Size> digest;
+    Benchmark::measure("sha256d, reused context", iterations, [&] {
+        context.update(message).final(digest.data());
+        Benchmark::doNotOptimize(digest);
+    });
+}
+
+TW_BENCHMARK(Hash, Sha256Instructions) {
+    // 1 MiB for throughput (MB/s = 1.049e6 / us per iteration), 32 bytes for short-message latency
+    const auto large = Data(1 << 20, 0x61);
+    const auto small = Data(32, 0x61);
+    Hash::Digest<Hash::sha256Size> digest;
+    for (const auto enabled : {true, false}) {
+        if (enabled && !sha2_hw_supported()) {
+            continue;
+        }
+        sha2_hw_set_enabled(enabled);
+        const std::string suffix = enabled ? ", SHA instructions" : ", portable";
+        Benchmark::measure("sha256 1 MiB" + suffix, 50, [&] {
+            sha256_Raw(large.data(), large.size(), digest.data());
+            Benchmark::doNotOptimize(digest);
+        });
+        Benchmark::measure("sha1 1 MiB" + suffix, 50, [&] {
+            sha1_Raw(large.data(), large.size(), digest.data());
+            Benchmark::doNotOptimize(digest);
+        });
+        Benchmark::measure("sha256 32 bytes" + suffix, iterations, [&] {
+            sha256_Raw(small.data(), small.size(), digest.data());
+            Benchmark::doNotOptimize(digest);
+        });
+        Benchmark::measure("sha256d 32 bytes" + suffix, iterations, [&] {
+            Benchmark::doNotOptimize(Hash::digest<Hash::HasherSha256d>(small));
+        });
+    }
+    sha2_hw_set_enabled(1);
+}
+
+TW_BENCHMARK(Hash, PublicKeyHashBatch) {
+    // 10^6 33-byte compressed public keys
+    const size_t count = 1'000'000;
+    std::vector<Data> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto key = Hash::sha256(TW::data(std::to_string(i)));
+        key.insert(key.begin(), 0x02);
+        keys.push_back(std::move(key));
+    }
+    std::vector<const byte*> pointers;
+    pointers.reserve(count);
+    for (const auto& key : keys) {
+        pointers.push_back(key.data());
+    }
+
+    // one by one, with and without SHA instructions: many CPUs with AVX2 do not have them
+    for (const auto enabled : {true, false}) {
+        if (enabled && !sha2_hw_supported()) {
+            continue;
+        }
+        sha2_hw_set_enabled(enabled);
+        const std::string suffix = enabled ? ", SHA instructions" : ", portable";
+        Benchmark::measure("sha256 x 10^6, one by one" + suffix, 1, [&] {
+            Hash::Digest<Hash::sha256Size> digest;
+            for (const auto& key : keys) {
+                sha256_Raw(key.data(), key.size(), digest.data());
+                Benchmark::doNotOptimize(digest);
+            }
+        });
+        Benchmark::measure("sha256ripemd x 10^6, one by one" + suffix, 1, [&] {
+            for (const auto& key : keys) {
+                Benchmark::doNotOptimize(Hash::digest<Hash::HasherSha256ripemd>(key));
+            }
+        });
+    }
+    sha2_hw_set_enabled(1);
+
+    Benchmark::measure("sha256 x 10^6, 8 lanes", 1, [&] {
+        uint8_t digests[8][SHA256_DIGEST_LENGTH];
+        for (size_t i = 0; i < count; i += 8) {
+            sha256_Raw_x8(&pointers[i], PublicKey::secp256k1Size, digests);
+            Benchmark::doNotOptimize(digests);
+        }
+    });
+    Benchmark::measure("sha256ripemd x 10^6, batch", 1, [&] {
+        Benchmark::doNotOptimize(Hash::sha256ripemd(pointers, PublicKey::secp256k1Size));
+    });
+
+    std::vector<PublicKey> publicKeys;
+    for (size_t i = 0; i < count / 10; ++i) {
+        publicKeys.emplace_back(keys[i], TWPublicKeyTypeSECP256k1);
+    }
+    Benchmark::measure("P2WPKH addresses x 10^5, one by one", 1, [&] {
+        for (const auto& publicKey : publicKeys) {
+            Benchmark::doNotOptimize(TW::deriveAddress(TWCoinTypeBitcoin, publicKey));
+        }
+    });
+    Benchmark::measure("P2WPKH addresses x 10^5, batch", 1, [&] {
+        Benchmark::doNotOptimize(TW::deriveAddresses(TWCoinTypeBitcoin, publicKeys, TWDerivationDefault));
+    });
+}
+
+TW_BENCHMARK(Hash, Base58Check) {
+    auto payload = Data{0x00};
+    const auto publicKey = TW::data("public key");
+    append(payload, Hash::sha256ripemd(publicKey.data(), publicKey.size()));
+    const auto encoded = Base58::bitcoin.encodeCheck(payload);
+
+    Benchmark::measure("encodeCheck", iterations / 4, [&] {
+        Benchmark::doNotOptimize(Base58::bitcoin.encodeCheck(payload));
+    });
+    Benchmark::measure("decodeCheck", iterations / 4, [&] {
+        Benchmark::doNotOptimize(Base58::bitcoin.decodeCheck(encoded));
+    });
+}
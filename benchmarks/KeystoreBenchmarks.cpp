@@ -0,0 +1,42 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Data.h"
+#include "Keystore/StoredKey.h"
+
+#include <TrezorCrypto/scrypt.h>
+
+#include <boost/variant/get.hpp>
+#include <string>
+#include <utility>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+TW_BENCHMARK(Keystore, DecryptEncryptionLevels) {
+    const auto password = TW::data("password");
+    const auto mnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+    for (const auto& [level, name] : {std::pair{TWStoredKeyEncryptionLevelMinimal, "minimal"},
+                                      std::pair{TWStoredKeyEncryptionLevelWeak, "weak"},
+                                      std::pair{TWStoredKeyEncryptionLevelStandard, "standard"}}) {
+        const auto key = StoredKey::createWithMnemonic("name", password, mnemonic, level);
+        const auto& params = boost::get<ScryptParameters>(key.payload.params.kdfParams);
+        const auto suffix = std::string(name) + " (n " + std::to_string(params.n) + ", p " + std::to_string(params.p) + ")";
+        const auto iterations = level == TWStoredKeyEncryptionLevelStandard ? 2 : 10;
+
+        Benchmark::measure("scrypt, lanes one after the other, " + suffix, iterations, [&] {
+            Data derivedKey(params.defaultDesiredKeyLength);
+            scrypt(password.data(), password.size(), params.salt.data(), params.salt.size(), params.n, params.r, params.p,
+                   derivedKey.data(), derivedKey.size());
+            Benchmark::doNotOptimize(derivedKey);
+        });
+        Benchmark::measure("decrypt, " + suffix, iterations, [&] {
+            Benchmark::doNotOptimize(key.payload.decrypt(password));
+        });
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "BinaryCoding.h"
+#include "Data.h"
+#include "Hash.h"
+#include "Mnemonic.h"
+
+#include <TrezorCrypto/bip39.h>
+
+#include <string>
+#include <vector>
+
+using namespace TW;
+
+TW_BENCHMARK(Mnemonic, BulkValidation) {
+    // 10^5 phrases of 12 and 24 words from deterministic entropy
+    const size_t count = 100'000;
+    std::vector<std::string> mnemonics;
+    mnemonics.reserve(count);
+    char buffer[BIP39_MAX_WORDS * (BIP39_MAX_WORD_LENGTH + 1)];
+    for (size_t i = 0; i < count; ++i) {
+        Data seed;
+        encode64LE(i, seed);
+        const auto entropy = Hash::sha256(seed);
+        mnemonics.emplace_back(mnemonic_from_data(entropy.data(), i % 2 == 0 ? 16 : 32, buffer, sizeof(buffer)));
+    }
+    std::vector<std::string> words;
+    for (size_t i = 0; i < BIP39_WORDS; ++i) {
+        words.emplace_back(mnemonic_get_word(static_cast<int>(i)));
+    }
+
+    Benchmark::measure("isValid x 10^5", 1, [&] {
+        for (const auto& mnemonic : mnemonics) {
+            Benchmark::doNotOptimize(Mnemonic::isValid(mnemonic));
+        }
+    });
+    Benchmark::measure("isValid, English wordlist table x 10^5", 1, [&] {
+        for (const auto& mnemonic : mnemonics) {
+            Benchmark::doNotOptimize(Mnemonic::isValid(mnemonic, Mnemonic::Language::English));
+        }
+    });
+    Benchmark::measure("detectLanguage x 10^5", 1, [&] {
+        for (const auto& mnemonic : mnemonics) {
+            Benchmark::doNotOptimize(Mnemonic::detectLanguage(mnemonic));
+        }
+    });
+    Benchmark::measure("isValidWord, whole wordlist", 50, [&] {
+        for (const auto& word : words) {
+            Benchmark::doNotOptimize(Mnemonic::isValidWord(word));
+        }
+    });
+    Benchmark::measure("suggest, every first word prefix", 50, [&] {
+        for (const auto& word : words) {
+            Benchmark::doNotOptimize(Mnemonic::suggest(word.substr(0, 3)));
+        }
+    });
+}
@@ -0,0 +1,48 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Data.h"
+#include "PrivateKey.h"
+
+#include <TrezorCrypto/ecdsa.h>
+
+#include <string>
+
+using namespace TW;
+
+namespace {
+
+void benchmarkGetPublicKey(const std::string& name, TWPublicKeyType type, size_t iterations) {
+    auto bytes = Data(PrivateKey::size, 0x11);
+    uint32_t counter = 0;
+    Benchmark::measure(name, iterations, [&] {
+        bytes[0] = static_cast<byte>(++counter);
+        bytes[1] = static_cast<byte>(counter >> 8);
+        Benchmark::doNotOptimize(PrivateKey(bytes).getPublicKey(type));
+    });
+}
+
+} // namespace
+
+TW_BENCHMARK(PrivateKey, GetPublicKey) {
+#if USE_PRECOMPUTED_CP_SERVER
+    ecdsa_set_server_tables(0);
+    benchmarkGetPublicKey("secp256k1 public key, default table", TWPublicKeyTypeSECP256k1, 2000);
+    benchmarkGetPublicKey("nist256p1 public key, default table", TWPublicKeyTypeNIST256p1, 2000);
+    ecdsa_set_server_tables(1);
+    // build the tables outside of the measurement
+    benchmarkGetPublicKey("secp256k1 public key, building server table", TWPublicKeyTypeSECP256k1, 1);
+    benchmarkGetPublicKey("nist256p1 public key, building server table", TWPublicKeyTypeNIST256p1, 1);
+    benchmarkGetPublicKey("secp256k1 public key, server table", TWPublicKeyTypeSECP256k1, 2000);
+    benchmarkGetPublicKey("nist256p1 public key, server table", TWPublicKeyTypeNIST256p1, 2000);
+#else
+    benchmarkGetPublicKey("secp256k1 public key", TWPublicKeyTypeSECP256k1, 2000);
+    benchmarkGetPublicKey("nist256p1 public key", TWPublicKeyTypeNIST256p1, 2000);
+#endif
+    benchmarkGetPublicKey("ed25519 public key", TWPublicKeyTypeED25519, 2000);
+}
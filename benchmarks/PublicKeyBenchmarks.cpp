@@ -0,0 +1,49 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "Data.h"
+#include "Hash.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <string>
+#include <vector>
+
+using namespace TW;
+
+namespace {
+
+void benchmarkVerify(const std::string& name, TWCurve curve, TWPublicKeyType type, size_t count) {
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> signatures;
+    std::vector<Data> messages;
+    for (size_t i = 0; i < count; ++i) {
+        const auto key = PrivateKey(Hash::sha256(TW::data("key" + std::to_string(i))));
+        const auto digest = Hash::sha256(TW::data("message" + std::to_string(i)));
+        publicKeys.push_back(key.getPublicKey(type));
+        signatures.push_back(key.sign(digest, curve));
+        messages.push_back(digest);
+    }
+
+    const auto suffix = ", " + std::to_string(count) + " signatures";
+    Benchmark::measure(name + " verify" + suffix, 3, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            Benchmark::doNotOptimize(publicKeys[i].verify(signatures[i], messages[i]));
+        }
+    });
+    Benchmark::measure(name + " verifyBatch" + suffix, 3, [&] {
+        Benchmark::doNotOptimize(PublicKey::verifyBatch(publicKeys, signatures, messages));
+    });
+}
+
+} // namespace
+
+TW_BENCHMARK(PublicKey, VerifyBatch) {
+    benchmarkVerify("secp256k1", TWCurveSECP256k1, TWPublicKeyTypeSECP256k1, 1000);
+    benchmarkVerify("nist256p1", TWCurveNIST256p1, TWPublicKeyTypeNIST256p1, 1000);
+}
@@ -0,0 +1,82 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include "BinaryCoding.h"
+#include "Bitcoin/Script.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Decred/Signer.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "Zcash/Transaction.h"
+#include "Zcash/TransactionBuilder.h"
+
+#include <string>
+
+using namespace TW;
+
+namespace {
+
+/// Builds a send-max input spending `count` P2PKH UTXOs of a single key.
+/// The public key hash is computed with `hashPublicKey`, which differs between chains.
+template <typename HashPublicKey>
+Bitcoin::Proto::SigningInput buildP2PKHInput(size_t count, const std::string& toAddress, TWCoinType coin, HashPublicKey hashPublicKey) {
+    const auto key = parse_hex("a9684f5bebd0e1208aae2e02bc9e9163bd1965ad23d8538644e1df8b99b99559");
+    const auto publicKey = PrivateKey(key).getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto script = Bitcoin::Script::buildPayToPublicKeyHash(hashPublicKey(publicKey.bytes));
+
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_use_max_amount(true);
+    input.set_byte_fee(1);
+    input.set_to_address(toAddress);
+    input.set_change_address(toAddress);
+    input.set_coin_type(coin);
+    input.add_private_key(key.data(), key.size());
+
+    for (size_t i = 0; i < count; ++i) {
+        Data seed;
+        encode32LE(static_cast<uint32_t>(i), seed);
+        const auto hash = Hash::sha256(seed);
+        auto& utxo = *input.add_utxo();
+        utxo.mutable_out_point()->set_hash(hash.data(), hash.size());
+        utxo.mutable_out_point()->set_index(0);
+        utxo.mutable_out_point()->set_sequence(UINT32_MAX);
+        utxo.set_amount(100'000 + static_cast<int64_t>(i));
+        utxo.set_script(script.bytes.data(), script.bytes.size());
+    }
+    return input;
+}
+
+} // namespace
+
+TW_BENCHMARK(Zcash, SignManyInputs) {
+    for (const auto count : {10, 100, 500}) {
+        auto input = buildP2PKHInput(count, "t1QahNjDdibyE4EdYkawUSKBBcVTSqv64CS", TWCoinTypeZcash, [](const Data& publicKey) {
+            return Hash::sha256ripemd(publicKey.data(), publicKey.size());
+        });
+        *input.mutable_plan() = Zcash::TransactionBuilder::plan(input).proto();
+        Benchmark::measure("sign P2PKH, inputs: " + std::to_string(count), 1, [&] {
+            auto result = Bitcoin::TransactionSigner<Zcash::Transaction, Zcash::TransactionBuilder>::sign(input);
+            Benchmark::doNotOptimize(result);
+        });
+    }
+}
+
+TW_BENCHMARK(Decred, SignManyInputs) {
+    for (const auto count : {10, 100, 500}) {
+        auto input = buildP2PKHInput(count, "Dsesp1V6DZDEtcq2behmBVKdYqKMdkh96hL", TWCoinTypeDecred, [](const Data& publicKey) {
+            return Hash::ripemd(Hash::blake256(publicKey));
+        });
+        *input.mutable_plan() = Decred::Signer::plan(input);
+        Benchmark::measure("sign P2PKH, inputs: " + std::to_string(count), 1, [&] {
+            auto output = Decred::Signer::sign(input);
+            Benchmark::doNotOptimize(output);
+        });
+    }
+}
@@ -0,0 +1,40 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <string>
+
+namespace TW::Benchmark {
+
+std::vector<Entry>& registry() {
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+void report(const std::string& name, std::size_t iterations, std::chrono::nanoseconds elapsed) {
+    const double total = static_cast<double>(elapsed.count());
+    const double perIteration = iterations > 0 ? total / static_cast<double>(iterations) : 0;
+    std::printf("%-56s %10zu iterations %14.3f us/iter %12.3f ms total\n", name.c_str(), iterations,
+                perIteration / 1e3, total / 1e6);
+    std::fflush(stdout);
+}
+
+} // namespace TW::Benchmark
+
+/// Runs all benchmarks, or only those whose name contains the first argument.
+int main(int argc, char* argv[]) {
+    const std::string filter = argc > 1 ? argv[1] : "";
+    for (const auto& entry : TW::Benchmark::registry()) {
+        if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        std::printf("# %s\n", entry.name.c_str());
+        entry.function();
+    }
+    return 0;
+}
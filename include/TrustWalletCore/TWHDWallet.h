@@ -10,6 +10,7 @@
 #include "TWCoinType.h"
 #include "TWCurve.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWHDVersion.h"
 #include "TWDerivation.h"
 #include "TWPrivateKey.h"
@@ -82,6 +83,12 @@ struct TWPrivateKey *_Nonnull TWHDWalletGetKey(struct TWHDWallet *_Nonnull walle
 TW_EXPORT_METHOD
 struct TWPrivateKey *_Nonnull TWHDWalletGetDerivedKey(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, uint32_t account, uint32_t change, uint32_t address);
 
+/// Generates `count` consecutive addresses, starting at `firstIndex`, for the specified coin, derivation, account and change,
+/// on up to `threads` threads (0 for one per core); the result does not depend on the thread count.
+/// Elements are UTF-8 address strings; empty if the coin's derivation path has no account/change/address levels, or on error. Returned object needs to be deleted.
+TW_EXPORT_METHOD
+struct TWDataVector *_Nonnull TWHDWalletGetAddressesDerivation(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, enum TWDerivation derivation, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count, uint32_t threads);
+
 /// Returns the extended private key (for default 0 account). Returned object needs to be deleted.
 TW_EXPORT_METHOD
 TWString *_Nonnull TWHDWalletGetExtendedPrivateKey(struct TWHDWallet *_Nonnull wallet, enum TWPurpose purpose, enum TWCoinType coin, enum TWHDVersion version);
@@ -110,4 +117,10 @@ TWString *_Nonnull TWHDWalletGetExtendedPublicKeyDerivation(struct TWHDWallet *_
 TW_EXPORT_STATIC_METHOD
 struct TWPublicKey *_Nullable TWHDWalletGetPublicKeyFromExtended(TWString *_Nonnull extended, enum TWCoinType coin, TWString *_Nonnull derivationPath);
 
+/// Generates `count` consecutive addresses, starting at `firstIndex`, of a change branch of an extended public key,
+/// on up to `threads` threads (0 for one per core).
+/// Elements are UTF-8 address strings; empty on invalid input. Returned object needs to be deleted.
+TW_EXPORT_STATIC_METHOD
+struct TWDataVector *_Nonnull TWHDWalletGetAddressesFromExtended(TWString *_Nonnull extended, enum TWCoinType coin, enum TWDerivation derivation, uint32_t change, uint32_t firstIndex, uint32_t count, uint32_t threads);
+
 TW_EXTERN_C_END
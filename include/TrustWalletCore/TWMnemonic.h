@@ -14,11 +14,11 @@ TW_EXTERN_C_BEGIN
 TW_EXPORT_STRUCT
 struct TWMnemonic;
 
-/// Determines whether a BIP39 English mnemonic phrase is valid.
+/// Determines whether a BIP39 mnemonic phrase is valid in any supported language, after NFKD normalisation.
 TW_EXPORT_STATIC_METHOD
 bool TWMnemonicIsValid(TWString *_Nonnull mnemonic);
 
-/// Determines whether word is a valid BIP39 English menemonic word.
+/// Determines whether word is a valid BIP39 mnemonic word in any supported language, after NFKD normalisation.
 TW_EXPORT_STATIC_METHOD
 bool TWMnemonicIsValidWord(TWString *_Nonnull word);
 
@@ -8,6 +8,7 @@
 
 #include "TWBase.h"
 #include "TWData.h"
+#include "TWDataVector.h"
 #include "TWPublicKeyType.h"
 #include "TWString.h"
 
@@ -43,6 +44,12 @@ TWData *_Nonnull TWPublicKeyData(struct TWPublicKey *_Nonnull pk);
 TW_EXPORT_METHOD
 bool TWPublicKeyVerify(struct TWPublicKey *_Nonnull pk, TWData *_Nonnull signature, TWData *_Nonnull message);
 
+/// Verifies a batch of signatures of the same key type: the i-th signature of the i-th message by the i-th public key.
+/// Returns one byte per signature, 1 if it verifies and 0 if it does not or its public key is invalid;
+/// null if the sizes differ. Returned object needs to be deleted.
+TW_EXPORT_STATIC_METHOD
+TWData *_Nullable TWPublicKeyVerifyBatch(const struct TWDataVector *_Nonnull publicKeys, enum TWPublicKeyType type, const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages);
+
 TW_EXPORT_METHOD
 bool TWPublicKeyVerifyAsDER(struct TWPublicKey *_Nonnull pk, TWData *_Nonnull signature, TWData *_Nonnull message);
 
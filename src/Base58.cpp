@@ -67,7 +67,8 @@ Data Base58::decodeCheck(const char* begin, const char* end, Hash::Hasher hasher
     }
 
     // re-calculate the checksum, ensure it matches the included 4-byte checksum
-    auto hash = Hash::hash(hasher, result.data(), result.size() - 4);
+    Hash::Digest<Hash::maxDigestSize> hash;
+    Hash::Context(hasher).update(result.data(), result.size() - 4).final(hash.data());
     if (!std::equal(hash.begin(), hash.begin() + 4, result.end() - 4)) {
         return {};
     }
@@ -143,8 +144,11 @@ Data Base58::decode(const char* begin, const char* end) const {
 
 std::string Base58::encodeCheck(const byte* begin, const byte* end, Hash::Hasher hasher) const {
     // add 4-byte hash check to the end
-    Data dataWithCheck(begin, end);
-    auto hash = Hash::hash(hasher, begin, end - begin);
+    Data dataWithCheck;
+    dataWithCheck.reserve(end - begin + 4);
+    dataWithCheck.assign(begin, end);
+    Hash::Digest<Hash::maxDigestSize> hash;
+    Hash::Context(hasher).update(begin, end - begin).final(hash.data());
     dataWithCheck.insert(dataWithCheck.end(), hash.begin(), hash.begin() + 4);
     return encode(dataWithCheck);
 }
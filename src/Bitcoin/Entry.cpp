@@ -11,8 +11,12 @@
 #include "SegwitAddress.h"
 #include "Signer.h"
 
+#include "../Hash.h"
+
 #include <TrezorCrypto/cash_addr.h>
 
+#include <algorithm>
+
 using namespace TW::Bitcoin;
 using namespace TW;
 using namespace std;
@@ -66,32 +70,38 @@ string Entry::normalizeAddress(TWCoinType coin, const string& address) const {
     }
 }
 
-string Entry::deriveAddress(TWCoinType coin, TWDerivation derivation, const PublicKey& publicKey,
-                            byte p2pkh, const char* hrp) const {
+namespace {
+
+/// Address types derived from a public key hash
+enum class KeyHashAddress {
+    None,
+    P2PKH,
+    P2WPKH,
+};
+
+KeyHashAddress keyHashAddress(TWCoinType coin, TWDerivation derivation) {
     switch (coin) {
     case TWCoinTypeBitcoin:
     case TWCoinTypeLitecoin:
         switch (derivation) {
         case TWDerivationBitcoinLegacy:
         case TWDerivationLitecoinLegacy:
-            return Address(publicKey, p2pkh).string();
+            return KeyHashAddress::P2PKH;
 
         case TWDerivationBitcoinSegwit:
         case TWDerivationDefault:
         default:
-            return SegwitAddress(publicKey, hrp).string();
+            return KeyHashAddress::P2WPKH;
         }
 
     case TWCoinTypeDigiByte:
     case TWCoinTypeViacoin:
     case TWCoinTypeBitcoinGold:
-        return SegwitAddress(publicKey, hrp).string();
+        return KeyHashAddress::P2WPKH;
 
     case TWCoinTypeBitcoinCash:
-        return BitcoinCashAddress(publicKey).string();
-
     case TWCoinTypeECash:
-        return ECashAddress(publicKey).string();
+        return KeyHashAddress::None;
 
     case TWCoinTypeDash:
     case TWCoinTypeDogecoin:
@@ -100,8 +110,64 @@ string Entry::deriveAddress(TWCoinType coin, TWDerivation derivation, const Publ
     case TWCoinTypeRavencoin:
     case TWCoinTypeFiro:
     default:
+        return KeyHashAddress::P2PKH;
+    }
+}
+
+} // namespace
+
+string Entry::deriveAddress(TWCoinType coin, TWDerivation derivation, const PublicKey& publicKey,
+                            byte p2pkh, const char* hrp) const {
+    switch (keyHashAddress(coin, derivation)) {
+    case KeyHashAddress::P2PKH:
         return Address(publicKey, p2pkh).string();
+    case KeyHashAddress::P2WPKH:
+        return SegwitAddress(publicKey, hrp).string();
+    case KeyHashAddress::None:
+        break;
+    }
+
+    switch (coin) {
+    case TWCoinTypeECash:
+        return ECashAddress(publicKey).string();
+    case TWCoinTypeBitcoinCash:
+    default:
+        return BitcoinCashAddress(publicKey).string();
+    }
+}
+
+vector<string> Entry::deriveAddresses(TWCoinType coin, TWDerivation derivation, const vector<PublicKey>& publicKeys,
+                                      byte p2pkh, const char* hrp) const {
+    const auto type = keyHashAddress(coin, derivation);
+    const auto compressed = all_of(publicKeys.begin(), publicKeys.end(), [](const PublicKey& publicKey) {
+        return publicKey.type == TWPublicKeyTypeSECP256k1;
+    });
+    if (type == KeyHashAddress::None || !compressed) {
+        return CoinEntry::deriveAddresses(coin, derivation, publicKeys, p2pkh, hrp);
+    }
+
+    // hash the keys together, then build the addresses from their hashes
+    vector<const byte*> keys;
+    keys.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        keys.push_back(publicKey.bytes.data());
+    }
+    const auto hashes = Hash::sha256ripemd(keys, PublicKey::secp256k1Size);
+
+    vector<string> addresses;
+    addresses.reserve(publicKeys.size());
+    for (const auto& hash : hashes) {
+        if (type == KeyHashAddress::P2WPKH) {
+            addresses.push_back(SegwitAddress(hrp, 0, Data(hash.begin(), hash.end())).string());
+        } else {
+            Data payload;
+            payload.reserve(1 + hash.size());
+            payload.push_back(p2pkh);
+            payload.insert(payload.end(), hash.begin(), hash.end());
+            addresses.push_back(Address(payload).string());
+        }
     }
+    return addresses;
 }
 
 template<typename CashAddress>
@@ -9,8 +9,10 @@
 #include "UTXO.h"
 
 #include <algorithm>
+#include <limits>
 #include <optional>
 #include <cassert>
+#include <utility>
 
 using namespace TW;
 using namespace TW::Bitcoin;
@@ -46,25 +48,6 @@ InputSelector<TypeWithAmount>::filterThreshold(const std::vector<TypeWithAmount>
     return filtered;
 }
 
-// Slice Array
-// [0,1,2,3,4,5,6,7,8,9].eachSlices(3)
-// >
-// [[0, 1, 2], [1, 2, 3], [2, 3, 4], [3, 4, 5], [4, 5, 6], [5, 6, 7], [6, 7, 8],
-// [7, 8, 9]]
-template <typename TypeWithAmount>
-static inline std::vector<std::vector<TypeWithAmount>>
-slice(const std::vector<TypeWithAmount>& inputs, size_t sliceSize) {
-    std::vector<std::vector<TypeWithAmount>> slices;
-    for (auto i = 0; i <= inputs.size() - sliceSize; ++i) {
-        slices.emplace_back();
-        slices[i].reserve(sliceSize);
-        for (auto j = i; j < i + sliceSize; j++) {
-            slices[i].push_back(inputs[j]);
-        }
-    }
-    return slices;
-}
-
 template <typename TypeWithAmount>
 std::vector<TypeWithAmount>
 InputSelector<TypeWithAmount>::select(int64_t targetValue, int64_t byteFee, int64_t numOutputs) {
@@ -82,22 +65,41 @@ InputSelector<TypeWithAmount>::select(int64_t targetValue, int64_t byteFee, int6
     // definitions for the following caluculation
     const auto doubleTargetValue = targetValue * 2;
 
-    // Get all possible utxo selections up to a maximum size, sort by total amount, increasing
+    // Candidate selections are windows of consecutive inputs, sorted by amount, increasing
     std::vector<TypeWithAmount> sorted = inputs;
     std::sort(sorted.begin(), sorted.end(),
               [](const TypeWithAmount& lhs, const TypeWithAmount& rhs) {
                   return lhs.amount < rhs.amount;
               });
 
-    // Precompute maximum amount possible to obtain with given number of inputs
+    // Precompute prefix sums, the sum of a window is the difference of two of them.
+    // As amounts are increasing, the sums of the windows of a given size are non-decreasing
+    // in the window start, so windows can be searched by binary search.
     const auto n = sorted.size();
-    std::vector<uint64_t> maxWithXInputs = std::vector<uint64_t>();
-    maxWithXInputs.push_back(0);
-    int64_t maxSum = 0;
-    for (auto i = 0; i < n; ++i) {
-        maxSum += sorted[n - 1 - i].amount;
-        maxWithXInputs.push_back(maxSum);
+    std::vector<uint64_t> prefixSum(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        prefixSum[i + 1] = prefixSum[i] + sorted[i].amount;
     }
+    auto windowSum = [&prefixSum](size_t start, size_t size) -> uint64_t {
+        return prefixSum[start + size] - prefixSum[start];
+    };
+
+    // Returns the first window start in [first, last) with sum at least value, or last if none
+    auto firstWindowAtLeast = [&windowSum](size_t first, size_t last, size_t size, uint64_t value) {
+        while (first < last) {
+            const auto middle = first + (last - first) / 2;
+            if (windowSum(middle, size) < value) {
+                first = middle + 1;
+            } else {
+                last = middle;
+            }
+        }
+        return first;
+    };
+
+    auto window = [&sorted](size_t start, size_t size) {
+        return std::vector<TypeWithAmount>(sorted.begin() + start, sorted.begin() + start + size);
+    };
 
     // difference from 2x targetValue
     auto distFrom2x = [doubleTargetValue](int64_t val) -> int64_t {
@@ -113,47 +115,34 @@ InputSelector<TypeWithAmount>::select(int64_t targetValue, int64_t byteFee, int6
     //    (1) bigger than what we need
     //    (2) closer to 2x the amount,
     //    (3) and does not produce dust change.
+    //    On equal distance, the window starting first is taken.
     for (size_t numInputs = 1; numInputs <= n; ++numInputs) {
         const auto fee = feeCalculator.calculate(numInputs, numOutputs, byteFee);
         const auto targetWithFeeAndDust = targetValue + fee + dustThreshold;
-        if (maxWithXInputs[numInputs] < targetWithFeeAndDust) {
+        const auto numWindows = n - numInputs + 1;
+        const auto first = firstWindowAtLeast(0, numWindows, numInputs, targetWithFeeAndDust);
+        if (first == numWindows) {
             // no way to satisfy with only numInputs inputs, skip
             continue;
         }
-        auto slices = slice(sorted, static_cast<size_t>(numInputs));
-
-        slices.erase(
-            std::remove_if(slices.begin(), slices.end(),
-                           [targetWithFeeAndDust](const std::vector<TypeWithAmount>& slice) {
-                               return sum(slice) < targetWithFeeAndDust;
-                           }),
-            slices.end());
-        if (!slices.empty()) {
-            std::sort(slices.begin(), slices.end(),
-                      [distFrom2x](const std::vector<TypeWithAmount>& lhs,
-                                   const std::vector<TypeWithAmount>& rhs) {
-                          return distFrom2x(sum(lhs)) < distFrom2x(sum(rhs));
-                      });
-            return filterOutDust(slices.front(), byteFee);
+        // closest to 2x is either the first window reaching 2x, or the last one below it
+        auto best = firstWindowAtLeast(first, numWindows, numInputs, doubleTargetValue);
+        if (best > first && (best == numWindows ||
+                             distFrom2x(windowSum(best - 1, numInputs)) <= distFrom2x(windowSum(best, numInputs)))) {
+            // first of the windows having the same sum as the last one below 2x
+            best = firstWindowAtLeast(first, best, numInputs, windowSum(best - 1, numInputs));
         }
+        return filterOutDust(window(best, numInputs), byteFee);
     }
 
     // 2. If not, find a valid combination of outputs even if they produce dust change.
     for (size_t numInputs = 1; numInputs <= n; ++numInputs) {
         const auto fee = feeCalculator.calculate(numInputs, numOutputs, byteFee);
         const auto targetWithFee = targetValue + fee;
-        if (maxWithXInputs[numInputs] < targetWithFee) {
-            // no way to satisfy with only numInputs inputs, skip
-            continue;
-        }
-        auto slices = slice(sorted, static_cast<size_t>(numInputs));
-        slices.erase(std::remove_if(slices.begin(), slices.end(),
-                                    [targetWithFee](const std::vector<TypeWithAmount>& slice) {
-                                        return sum(slice) < targetWithFee;
-                                    }),
-                     slices.end());
-        if (!slices.empty()) {
-            return filterOutDust(slices.front(), byteFee);
+        const auto numWindows = n - numInputs + 1;
+        const auto first = firstWindowAtLeast(0, numWindows, numInputs, targetWithFee);
+        if (first < numWindows) {
+            return filterOutDust(window(first, numInputs), byteFee);
         }
     }
 
@@ -200,6 +189,138 @@ std::vector<TypeWithAmount> InputSelector<TypeWithAmount>::selectSimple(int64_t
     return {};
 }
 
+template <typename TypeWithAmount>
+std::vector<TypeWithAmount>
+InputSelector<TypeWithAmount>::selectBranchAndBound(int64_t targetValue, int64_t byteFee,
+                                                    int64_t numOutputs, size_t maxIterations) {
+    // if target value is zero, no UTXOs are needed
+    if (targetValue == 0 || inputs.empty()) {
+        return {};
+    }
+
+    const int64_t inputFee = feeCalculator.calculateSingleInput(byteFee);
+    const int64_t outputsFee = feeCalculator.calculate(0, numOutputs, byteFee);
+    // cost of a change output: its fee, plus the fee of spending it later
+    const int64_t costOfChange = feeCalculator.calculate(0, numOutputs + 1, byteFee) - outputsFee + inputFee;
+    const int64_t target = targetValue + outputsFee;
+
+    // Candidates with positive effective value, largest first
+    std::vector<std::pair<int64_t, size_t>> candidates; // effective value, index in inputs
+    int64_t available = 0;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const int64_t effectiveValue = static_cast<int64_t>(inputs[i].amount) - inputFee;
+        if (effectiveValue > 0) {
+            candidates.emplace_back(effectiveValue, i);
+            available += effectiveValue;
+        }
+    }
+    if (available < target) {
+        return {};
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    // Depth-first search, inclusion branch first.  `selection` holds the positions of the included
+    // candidates, `available` the effective value of the candidates not yet decided on.
+    std::vector<size_t> selection;
+    std::vector<size_t> bestSelection;
+    int64_t value = 0;
+    int64_t bestExcess = std::numeric_limits<int64_t>::max();
+    size_t position = 0;
+    for (size_t iteration = 0; iteration < maxIterations; ++iteration, ++position) {
+        bool backtrack = false;
+        if (value + available < target || value > target + costOfChange) {
+            // cannot reach the target, or overshoots it
+            backtrack = true;
+        } else if (value >= target) {
+            // match
+            if (value - target < bestExcess) {
+                bestExcess = value - target;
+                bestSelection = selection;
+                if (bestExcess == 0) {
+                    break;
+                }
+            }
+            backtrack = true;
+        }
+
+        if (backtrack) {
+            if (selection.empty()) {
+                // searched all
+                break;
+            }
+            // Undecide the candidates after the last included one, then exclude that one
+            for (--position; position > selection.back(); --position) {
+                available += candidates[position].first;
+            }
+            value -= candidates[position].first;
+            selection.pop_back();
+        } else {
+            available -= candidates[position].first;
+            // Skip including a candidate of the same value as the previous one, if that was excluded:
+            // it would only lead to equivalent selections
+            if (selection.empty() || position - 1 == selection.back() ||
+                candidates[position].first != candidates[position - 1].first) {
+                selection.push_back(position);
+                value += candidates[position].first;
+            }
+        }
+    }
+
+    std::vector<TypeWithAmount> selected;
+    for (auto position : bestSelection) {
+        selected.push_back(inputs[candidates[position].second]);
+    }
+    return selected;
+}
+
+template <typename TypeWithAmount>
+typename InputSelector<TypeWithAmount>::Candidates
+InputSelector<TypeWithAmount>::selectCandidates(const std::vector<TypeWithAmount>& inputs, size_t maxCount,
+                                                const std::function<int64_t(const TypeWithAmount&)>& value) {
+    Candidates candidates;
+
+    // Min-heap of the kept inputs (value, index), its top is the worst kept one:
+    // the lowest value, on equal value the latest
+    using Entry = std::pair<int64_t, size_t>;
+    const auto worseFirst = [](const Entry& lhs, const Entry& rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    };
+    std::vector<Entry> heap;
+    heap.reserve(std::min(maxCount, inputs.size()));
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto inputValue = value(inputs[i]);
+        if (inputValue <= 0) {
+            ++candidates.dustCount;
+            continue;
+        }
+        if (heap.size() < maxCount) {
+            heap.emplace_back(inputValue, i);
+            std::push_heap(heap.begin(), heap.end(), worseFirst);
+            continue;
+        }
+        // later inputs replace a kept one only if strictly better
+        if (maxCount == 0 || inputValue <= heap.front().first) {
+            ++candidates.truncatedCount;
+            candidates.truncatedAmount += inputs[i].amount;
+            continue;
+        }
+        ++candidates.truncatedCount;
+        candidates.truncatedAmount += inputs[heap.front().second].amount;
+        std::pop_heap(heap.begin(), heap.end(), worseFirst);
+        heap.back() = Entry(inputValue, i);
+        std::push_heap(heap.begin(), heap.end(), worseFirst);
+    }
+
+    // keep the original order
+    std::sort(heap.begin(), heap.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.second < rhs.second; });
+    candidates.inputs.reserve(heap.size());
+    for (const auto& entry : heap) {
+        candidates.inputs.push_back(inputs[entry.second]);
+    }
+    return candidates;
+}
+
 template <typename TypeWithAmount>
 std::vector<TypeWithAmount>
 InputSelector<TypeWithAmount>::selectMaxAmount(int64_t byteFee) noexcept {
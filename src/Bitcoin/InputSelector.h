@@ -9,6 +9,7 @@
 #include "FeeCalculator.h"
 #include <TrustWalletCore/TWCoinType.h>
 
+#include <functional>
 #include <numeric>
 #include <vector>
 
@@ -17,7 +18,9 @@ namespace TW::Bitcoin {
 template <typename TypeWithAmount> // TypeWithAmount has to have a uint64_t amount
 class InputSelector {
 public:
-    /// Selects unspent transactions to use given a target transaction value, using complete logic.
+    /// Selects unspent transactions to use given a target transaction value, using complete logic:
+    /// among the windows of consecutive inputs (sorted by amount), the one with the fewest inputs
+    /// and sum closest to 2x the target.  Runs in O(n log n) time and O(n) memory.
     ///
     /// \returns the list of indices of selected inputs, or an empty list if there are insufficient
     /// funds.
@@ -32,10 +35,41 @@ public:
     std::vector<TypeWithAmount> selectSimple(int64_t targetValue, int64_t byteFee,
                                              int64_t numOutputs = 2);
 
+    /// Selects unspent transactions for a transaction without change output, using a depth-first
+    /// branch-and-bound search.  The effective value of an input is its amount less the fee of
+    /// spending it.  A selection matches if its effective value covers the target value plus the
+    /// fee of the outputs, with an excess lower than the cost of creating and spending a change
+    /// output; the one with the lowest excess is returned.  The search is limited to maxIterations steps.
+    ///
+    /// \returns the selected inputs, or an empty list if no match was found.
+    std::vector<TypeWithAmount> selectBranchAndBound(int64_t targetValue, int64_t byteFee,
+                                                     int64_t numOutputs = 1,
+                                                     size_t maxIterations = BranchAndBoundMaxIterations);
+
+    /// Default iteration limit of the branch-and-bound search
+    static constexpr size_t BranchAndBoundMaxIterations = 100'000;
+
     /// Selects UTXOs for max amount; select all except those which would reduce output (dust).
     /// Return indices. One output and no change is assumed.
     std::vector<TypeWithAmount> selectMaxAmount(int64_t byteFee) noexcept;
 
+    /// Result of selectCandidates
+    struct Candidates {
+        /// The kept inputs, in their original order
+        std::vector<TypeWithAmount> inputs;
+        /// Number of inputs left out as dust
+        size_t dustCount = 0;
+        /// Number of inputs left out beyond the limit, and their total amount
+        size_t truncatedCount = 0;
+        uint64_t truncatedAmount = 0;
+    };
+
+    /// Streams inputs through a dust filter (value not above zero) and keeps the maxCount ones of the
+    /// largest value, on equal value the earlier ones, using a bounded heap.  Runs in O(n log k) time and
+    /// O(k) memory, with k = maxCount, so that selection can run on a compact candidate set.
+    static Candidates selectCandidates(const std::vector<TypeWithAmount>& inputs, size_t maxCount,
+                                       const std::function<int64_t(const TypeWithAmount&)>& value);
+
     /// Construct, using provided feeCalculator (see getFeeCalculator()).
     explicit InputSelector(const std::vector<TypeWithAmount>& inputs,
                            const FeeCalculator& feeCalculator) noexcept
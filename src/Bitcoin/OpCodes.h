@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 enum OpCode {
     // push value
    OP_0 = 0x00,
@@ -19,6 +19,9 @@ namespace TW::Bitcoin {
 
 class Script {
   public:
+    /// Maximum data length of an OP_RETURN script, longer data is truncated.
+    static constexpr size_t MaxOpReturnLength = 64;
+
     /// Script raw bytes.
     Data bytes;
 
@@ -19,6 +19,8 @@
 #include "../Zcash/Transaction.h"
 #include "../Zcash/TransactionBuilder.h"
 
+#include <type_traits>
+
 using namespace TW;
 using namespace TW::Bitcoin;
 
@@ -36,6 +38,7 @@ Result<Transaction, Common::Proto::SigningError> SignatureBuilder<Transaction>::
     transactionToSign.inputs.clear();
     std::copy(std::begin(transaction.inputs), std::end(transaction.inputs),
               std::back_inserter(transactionToSign.inputs));
+    sigHashCache.reset();
 
     const auto hashSingle = hashTypeIsSingle(input.hashType);
     for (auto i = 0; i < plan.utxos.size(); i++) {
@@ -245,8 +248,14 @@ Data SignatureBuilder<Transaction>::createSignature(
         return Data(72);
     }
 
-    const Data sighash = transaction.getSignatureHash(script, index, input.hashType, amount,
-                                                static_cast<SignatureVersion>(version));
+    // Witness v0 and Zcash (ZIP-243) pre-images share hashes of all prevouts, sequences and outputs
+    constexpr bool alwaysCached = std::is_same_v<Transaction, Zcash::Transaction>;
+    if ((alwaysCached || version == WITNESS_V0) && !sigHashCache.has_value()) {
+        sigHashCache = transaction.getSigHashCache();
+    }
+    const auto sighash = transaction.getSignatureHash(script, index, input.hashType, amount,
+                                                      static_cast<SignatureVersion>(version),
+                                                      sigHashCache.has_value() ? &sigHashCache.value() : nullptr);
 
     if (signingMode == SigningMode_HashOnly) {
         // Don't sign, only store hash-to-be-signed + pubkeyhash.  Return placeholder.
@@ -319,18 +328,27 @@ Data SignatureBuilder<Transaction>::pushAll(const std::vector<Data>& results) {
 }
 
 template <typename Transaction>
-std::optional<KeyPair> SignatureBuilder<Transaction>::keyPairForPubKeyHash(const Data& hash) const {
+void SignatureBuilder<Transaction>::indexPrivateKeys() const {
+    keysByPubKeyHash.emplace();
     for (auto& key : input.privateKeys) {
         auto pubKeyExtended = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
         auto pubKey = pubKeyExtended.compressed();
-        if (Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size()) == hash) {
-            return std::make_tuple(key, pubKey);
-        }
-        if (Hash::sha256ripemd(pubKeyExtended.bytes.data(), pubKeyExtended.bytes.size()) == hash) {
-            return std::make_tuple(key, pubKeyExtended);
-        }
+        // the first key wins, as in a linear search
+        keysByPubKeyHash->emplace(Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size()), std::make_tuple(key, pubKey));
+        keysByPubKeyHash->emplace(Hash::sha256ripemd(pubKeyExtended.bytes.data(), pubKeyExtended.bytes.size()), std::make_tuple(key, pubKeyExtended));
+    }
+}
+
+template <typename Transaction>
+std::optional<KeyPair> SignatureBuilder<Transaction>::keyPairForPubKeyHash(const Data& hash) const {
+    if (!keysByPubKeyHash.has_value()) {
+        indexPrivateKeys();
+    }
+    auto it = keysByPubKeyHash->find(hash);
+    if (it == keysByPubKeyHash->end()) {
+        return {};
     }
-    return {};
+    return it->second;
 }
 
 template <typename Transaction>
@@ -17,6 +17,7 @@
 #include "../PublicKey.h"
 #include "../CoinEntry.h"
 
+#include <map>
 #include <vector>
 #include <optional>
 #include <utility>
@@ -55,6 +56,12 @@ private:
     /// For SigningMode_External, signatures are provided here
     std::optional<SignaturePubkeyList> externalSignatures;
 
+    /// Witness v0 (and Zcash) pre-image hashes, computed once on first use and shared by all inputs
+    std::optional<SigHashCache> sigHashCache;
+
+    /// Private keys by hash160 of their compressed and uncompressed public keys, built on the first lookup
+    mutable std::optional<std::map<Data, KeyPair>> keysByPubKeyHash;
+
 public:
     /// Initializes a transaction signer with signing input.
     /// estimationMode: is set, no real signing is performed, only as much as needed to get the almost-exact signed size 
@@ -87,6 +94,9 @@ private:
                          const Data& publicKeyHash, const std::optional<KeyPair>& key,
                          size_t index, Amount amount, uint32_t version);
 
+    /// Fills keysByPubKeyHash from the input's private keys.
+    void indexPrivateKeys() const;
+
     /// Returns the private key for the given public key hash.
     std::optional<KeyPair> keyPairForPubKeyHash(const Data& hash) const;
 
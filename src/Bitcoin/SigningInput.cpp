@@ -31,4 +31,7 @@ SigningInput::SigningInput(const Proto::SigningInput& input) {
     }
     outputOpReturn = data(input.output_op_return());
     lockTime = input.lock_time();
+    inputSelection = input.input_selection();
+    maxCandidateUtxos = input.max_candidate_utxos();
+    candidateOrdering = input.candidate_ordering();
 }
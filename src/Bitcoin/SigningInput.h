@@ -61,6 +61,15 @@ public:
 
     uint32_t lockTime = 0;
 
+    // UTXO selection strategy
+    Proto::InputSelection inputSelection = Proto::InputSelectionDefault;
+
+    // Optional limit on the number of UTXO candidates considered when planning, 0 for none
+    uint32_t maxCandidateUtxos = 0;
+
+    // Order of the kept UTXO candidates
+    Proto::CandidateOrdering candidateOrdering = Proto::CandidateOrderingAmount;
+
 public:
     SigningInput() = default;
 
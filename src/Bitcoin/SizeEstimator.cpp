@@ -0,0 +1,269 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SizeEstimator.h"
+
+#include "OpCodes.h"
+#include "SigHashType.h"
+
+#include "../Hash.h"
+#include "../HexCoding.h"
+#include "../PublicKey.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+/// Placeholder signature size used by the signer in estimation mode
+constexpr size_t SignatureSize = 72;
+/// Taproot key-path signature with the default sighash type
+constexpr size_t SchnorrSignatureSize = 64;
+
+/// Encoded sizes of a list of stack items, both as scriptSig pushes and as witness items.
+/// Mirrors the result lists of SignatureBuilder, without holding the items.
+struct Items {
+    size_t count = 0;
+    size_t pushSize = 0;
+    size_t witnessSize = 0;
+    /// The first item, when it is a script from `SigningInput::scripts`
+    const Script* first = nullptr;
+
+    void push(size_t size, const Script* script = nullptr) {
+        if (count == 0) {
+            first = script;
+        }
+        ++count;
+        // items of size 1 are never small integers here, see SignatureBuilder::pushAll
+        if (size == 0) {
+            pushSize += 1;
+        } else if (size < OP_PUSHDATA1) {
+            pushSize += 1 + size;
+        } else if (size <= 0xff) {
+            pushSize += 2 + size;
+        } else if (size <= 0xffff) {
+            pushSize += 3 + size;
+        } else {
+            pushSize += 5 + size;
+        }
+        witnessSize += SizeEstimator::varIntSize(size) + size;
+    }
+
+    void clear() { *this = Items(); }
+};
+
+bool isPayToPublicKey(const Script& script) {
+    const auto& bytes = script.bytes;
+    return (bytes.size() == PublicKey::secp256k1ExtendedSize + 2 && bytes[0] == PublicKey::secp256k1ExtendedSize && bytes.back() == OP_CHECKSIG) ||
+           (bytes.size() == PublicKey::secp256k1Size + 2 && bytes[0] == PublicKey::secp256k1Size && bytes.back() == OP_CHECKSIG);
+}
+
+bool isPayToPublicKeyHash(const Script& script) {
+    const auto& bytes = script.bytes;
+    return bytes.size() == 25 && bytes[0] == OP_DUP && bytes[1] == OP_HASH160 && bytes[2] == 20 &&
+           bytes[23] == OP_EQUALVERIFY && bytes[24] == OP_CHECKSIG;
+}
+
+bool isPayToTaproot(const Script& script) {
+    const auto& bytes = script.bytes;
+    return bytes.size() == 34 && bytes[0] == OP_1 && bytes[1] == 0x20;
+}
+
+const Script* redeemScript(const SigningInput& input, const byte* hash) {
+    auto it = input.scripts.find(hex(hash, hash + Hash::ripemdSize));
+    if (it == input.scripts.end() || it->second.empty()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+/// Mirrors SignatureBuilder::signStep in size-estimation mode.
+bool signStep(const Script& script, const SizeEstimator& estimator, const SigningInput& input, Items& results) {
+    const auto& bytes = script.bytes;
+    if (script.isPayToScriptHash()) {
+        const auto* redeem = redeemScript(input, bytes.data() + 2);
+        if (redeem == nullptr) {
+            return false;
+        }
+        results.push(redeem->bytes.size(), redeem);
+        return true;
+    }
+    if (script.isPayToWitnessScriptHash()) {
+        const auto scriptHash = Hash::ripemd(bytes.data() + 2, bytes.size() - 2);
+        const auto* redeem = redeemScript(input, scriptHash.data());
+        if (redeem == nullptr) {
+            return false;
+        }
+        results.push(redeem->bytes.size(), redeem);
+        return true;
+    }
+    if (script.isPayToWitnessPublicKeyHash()) {
+        results.push(Hash::ripemdSize);
+        return true;
+    }
+    if (script.isWitnessProgram()) {
+        return false;
+    }
+    if (isPayToPublicKey(script)) {
+        results.push(SignatureSize);
+        return true;
+    }
+    if (isPayToPublicKeyHash(script)) {
+        results.push(SignatureSize);
+        results.push(estimator.publicKeySize(bytes.data() + 3));
+        return true;
+    }
+    std::vector<Data> keys;
+    int required;
+    if (bytes.size() > 0 && bytes.back() == OP_CHECKMULTISIG && script.matchMultisig(keys, required)) {
+        // CHECKMULTISIG workaround item, then one signature per required key
+        results.push(0);
+        for (auto i = 0; i < required; ++i) {
+            results.push(SignatureSize);
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+size_t SizeEstimator::publicKeySize(const byte* publicKeyHash) const {
+    if (input.privateKeys.empty()) {
+        // estimation without keys uses a compressed placeholder
+        return PublicKey::secp256k1Size;
+    }
+    if (!uncompressedKeyHashes.has_value()) {
+        std::vector<KeyHash> hashes;
+        hashes.reserve(input.privateKeys.size());
+        for (const auto& key : input.privateKeys) {
+            const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+            const auto hash = Hash::sha256ripemd(publicKey.bytes.data(), publicKey.bytes.size());
+            KeyHash keyHash;
+            std::copy(hash.begin(), hash.end(), keyHash.begin());
+            hashes.push_back(keyHash);
+        }
+        std::sort(hashes.begin(), hashes.end());
+        uncompressedKeyHashes = std::move(hashes);
+    }
+    KeyHash keyHash;
+    std::copy(publicKeyHash, publicKeyHash + keyHash.size(), keyHash.begin());
+    const auto& hashes = uncompressedKeyHashes.value();
+    return std::binary_search(hashes.begin(), hashes.end(), keyHash) ? PublicKey::secp256k1ExtendedSize : PublicKey::secp256k1Size;
+}
+
+std::optional<SizeEstimator::InputSize> SizeEstimator::inputSize(const Script& script) const {
+    if (isPayToTaproot(script)) {
+        InputSize size;
+        size.witness = 1 + varIntSize(SchnorrSignatureSize) + SchnorrSignatureSize;
+        size.hasWitness = true;
+        return size;
+    }
+
+    // Mirrors SignatureBuilder::sign for a single input
+    Items results;
+    if (!signStep(script, *this, input, results)) {
+        return {};
+    }
+    const Script* current = &script;
+    const Script* redeem = nullptr;
+    if (current->isPayToScriptHash()) {
+        current = results.first;
+        results.clear();
+        if (!signStep(*current, *this, input, results)) {
+            return {};
+        }
+        results.push(current->bytes.size());
+        redeem = current;
+    }
+
+    Items witness;
+    if (current->isPayToWitnessPublicKeyHash()) {
+        witness.push(SignatureSize);
+        witness.push(publicKeySize(current->bytes.data() + 2));
+        results.clear();
+    } else if (current->isPayToWitnessScriptHash()) {
+        const auto* witnessScript = results.first;
+        if (!signStep(*witnessScript, *this, input, witness)) {
+            return {};
+        }
+        witness.push(witnessScript->bytes.size());
+        results.clear();
+    } else if (current->isWitnessProgram()) {
+        return {};
+    }
+
+    if (redeem != nullptr) {
+        results.push(redeem->bytes.size());
+    }
+
+    InputSize size;
+    size.scriptSig = results.pushSize;
+    if (witness.count > 0) {
+        size.witness = varIntSize(witness.count) + witness.witnessSize;
+        size.hasWitness = true;
+    }
+    return size;
+}
+
+std::optional<uint64_t> SizeEstimator::virtualSize(const UTXOs& utxos, bool hasChange) const {
+    if (utxos.empty()) {
+        return {};
+    }
+
+    // outputs, as built by TransactionBuilder::build
+    size_t outputCount = 0;
+    uint64_t outputsSize = 0;
+    const auto addOutput = [&](size_t scriptSize) {
+        ++outputCount;
+        outputsSize += 8 + varIntSize(scriptSize) + scriptSize;
+    };
+    const auto toScriptSize = Script::lockScriptForAddress(input.toAddress, input.coinType).bytes.size();
+    if (toScriptSize == 0) {
+        return {};
+    }
+    addOutput(toScriptSize);
+    if (hasChange) {
+        const auto changeScriptSize = Script::lockScriptForAddress(input.changeAddress, input.coinType).bytes.size();
+        if (changeScriptSize == 0) {
+            return {};
+        }
+        addOutput(changeScriptSize);
+    }
+    if (!input.outputOpReturn.empty()) {
+        addOutput(2 + std::min(input.outputOpReturn.size(), Script::MaxOpReturnLength));
+    }
+
+    // version, input and output counts, lock time
+    uint64_t sizeNonSegwit = 4 + varIntSize(utxos.size()) + varIntSize(outputCount) + outputsSize + 4;
+    // marker and flag
+    uint64_t witnessSize = 2;
+    bool hasWitness = false;
+    const auto hashSingle = hashTypeIsSingle(input.hashType);
+    for (size_t i = 0; i < utxos.size(); ++i) {
+        InputSize size;
+        // inputs without a corresponding output are left unsigned with TWBitcoinSigHashTypeSingle
+        if (!hashSingle || i < outputCount) {
+            const auto signedSize = inputSize(utxos[i].script);
+            if (!signedSize.has_value()) {
+                return {};
+            }
+            size = signedSize.value();
+        }
+        // out-point, scriptSig, sequence
+        sizeNonSegwit += 36 + varIntSize(size.scriptSig) + size.scriptSig + 4;
+        witnessSize += size.witness;
+        hasWitness = hasWitness || size.hasWitness;
+    }
+
+    if (!hasWitness) {
+        return sizeNonSegwit;
+    }
+    return sizeNonSegwit + witnessSize / 4 + (witnessSize % 4 != 0);
+}
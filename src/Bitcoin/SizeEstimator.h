@@ -0,0 +1,73 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Script.h"
+#include "SigningInput.h"
+#include "UTXO.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Closed-form size model of transactions, matching the size of what the signer
+/// produces in size-estimation mode (72-byte signature placeholders), without building or signing.
+class SizeEstimator {
+public:
+    /// Encoded size of a signed input's scriptSig and witness.
+    struct InputSize {
+        /// Size of the scriptSig, without its length prefix.
+        size_t scriptSig = 0;
+
+        /// Size of the serialized witness, including the item count; 1 if the input has no witness.
+        size_t witness = 1;
+
+        bool hasWitness = false;
+
+        /// Virtual size of the input, including out-point and sequence, with the witness counted for a quarter.
+        uint64_t virtualSize() const {
+            const uint64_t witnessSize = hasWitness ? witness : 0;
+            return 36 + varIntSize(scriptSig) + scriptSig + 4 + (witnessSize + 3) / 4;
+        }
+    };
+
+    /// Initializes an estimator for transactions built from `input`, which must outlive the estimator.
+    explicit SizeEstimator(const SigningInput& input) : input(input) {}
+
+    /// Sizes of an input spending `script`, as signed by the signer: P2PKH, P2PK, bare multisig,
+    /// P2WPKH, P2WSH and P2SH-wrapped variants, with redeem scripts looked up in `input.scripts`,
+    /// and P2TR key-path spends.
+    /// Returns nothing if the signer could not sign the script.
+    std::optional<InputSize> inputSize(const Script& script) const;
+
+    /// Virtual size of the transaction built from the input spending `utxos`, with a change output
+    /// if `hasChange`.  Returns nothing if the transaction could not be built or signed.
+    std::optional<uint64_t> virtualSize(const UTXOs& utxos, bool hasChange) const;
+
+    /// Size of the public key the signer uses for a public key hash: uncompressed if the hash
+    /// is that of the uncompressed public key of one of the private keys, compressed otherwise.
+    size_t publicKeySize(const byte* publicKeyHash) const;
+
+    /// Size of a variable-length integer.
+    static constexpr size_t varIntSize(uint64_t value) {
+        return value < 0xfd ? 1 : value <= 0xffff ? 3 : value <= 0xffffffff ? 5 : 9;
+    }
+
+private:
+    using KeyHash = std::array<byte, 20>;
+
+    const SigningInput& input;
+
+    /// Sorted hashes of the uncompressed public keys of the private keys, derived on first use
+    mutable std::optional<std::vector<KeyHash>> uncompressedKeyHashes;
+};
+
+} // namespace TW::Bitcoin
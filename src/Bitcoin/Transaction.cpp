@@ -19,7 +19,8 @@ using namespace TW;
 using namespace TW::Bitcoin;
 
 Data Transaction::getPreImage(const Script& scriptCode, size_t index,
-                              enum TWBitcoinSigHashType hashType, uint64_t amount) const {
+                              enum TWBitcoinSigHashType hashType, uint64_t amount,
+                              const SigHashCache* cache) const {
     assert(index < inputs.size());
 
     Data data;
@@ -29,7 +30,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
+        const auto hashPrevouts = cache != nullptr ? cache->hashPrevouts : getPrevoutHash();
         std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -38,7 +39,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 && !hashTypeIsSingle(hashType) &&
         !hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
+        const auto hashSequence = cache != nullptr ? cache->hashSequence : getSequenceHash();
         std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -55,7 +56,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
     // Outputs (none/one/all, depending on flags)
     if (!hashTypeIsSingle(hashType) && !hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
+        const auto hashOutputs = cache != nullptr ? cache->hashOutputs : getOutputsHash();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else if (hashTypeIsSingle(hashType) && index < outputs.size()) {
         Data outputData;
@@ -77,6 +78,7 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 
 Data Transaction::getPrevoutHash() const {
     Data data;
+    data.reserve(inputs.size() * (32 + 4));
     for (auto& input : inputs) {
         auto& outpoint = reinterpret_cast<const OutPoint&>(input.previousOutput);
         outpoint.encode(data);
@@ -87,6 +89,7 @@ Data Transaction::getPrevoutHash() const {
 
 Data Transaction::getSequenceHash() const {
     Data data;
+    data.reserve(inputs.size() * 4);
     for (auto& input : inputs) {
         encode32LE(input.sequence, data);
     }
@@ -103,6 +106,10 @@ Data Transaction::getOutputsHash() const {
     return hash;
 }
 
+SigHashCache Transaction::getSigHashCache() const {
+    return SigHashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash()};
+}
+
 void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
     bool useWitnessFormat = true;
     switch (segwitFormat) {
@@ -156,19 +163,19 @@ bool Transaction::hasWitness() const {
 
 Data Transaction::getSignatureHash(const Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
-                                   enum SignatureVersion version) const {
+                                   enum SignatureVersion version, const SigHashCache* cache) const {
     if (version == BASE) {
         return getSignatureHashBase(scriptCode, index, hashType);
     }
     // version == WITNESS_V0
-    return getSignatureHashWitnessV0(scriptCode, index, hashType, amount);
+    return getSignatureHashWitnessV0(scriptCode, index, hashType, amount, cache);
 }
 
 /// Generates the signature hash for Witness version 0 scripts.
 Data Transaction::getSignatureHashWitnessV0(const Script& scriptCode, size_t index,
                                             enum TWBitcoinSigHashType hashType,
-                                            uint64_t amount) const {
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
+                                            uint64_t amount, const SigHashCache* cache) const {
+    auto preimage = getPreImage(scriptCode, index, hashType, amount, cache);
     auto hash = Hash::hash(hasher, preimage);
     return hash;
 }
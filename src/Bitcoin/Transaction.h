@@ -30,6 +30,14 @@ class TransactionInputs: public std::vector<TransactionInput> {};
 template <typename TransactionOutput>
 class TransactionOutputs: public std::vector<TransactionOutput> {};
 
+/// Precomputed parts of the witness v0 (BIP143) signature pre-image, which are the same for every input.
+/// Computing them once per transaction keeps signing linear in the number of inputs.
+struct SigHashCache {
+    Data hashPrevouts;
+    Data hashSequence;
+    Data hashOutputs;
+};
+
 struct Transaction {
 public:
     /// Transaction data format version (note, this is signed)
@@ -68,11 +76,17 @@ public:
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
     /// Generates the signature pre-image.
-    Data getPreImage(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+    /// The optional cache is used instead of recomputing hashPrevouts, hashSequence and hashOutputs.
+    Data getPreImage(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType, uint64_t amount,
+                     const SigHashCache* cache = nullptr) const;
     Data getPrevoutHash() const;
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the pre-image hashes shared by all inputs; valid as long as the inputs' outpoints and
+    /// sequences, and the outputs, stay unchanged.
+    SigHashCache getSigHashCache() const;
+
     enum SegwitFormatMode {
         NonSegwit,
         IfHasWitness,
@@ -92,7 +106,8 @@ public:
 
     /// Generates the signature hash for this transaction.
     Data getSignatureHash(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
-                          uint64_t amount, enum SignatureVersion version) const;
+                          uint64_t amount, enum SignatureVersion version,
+                          const SigHashCache* cache = nullptr) const;
 
     void serializeInput(size_t subindex, const Script&, size_t index, enum TWBitcoinSigHashType hashType, Data& data) const;
 
@@ -102,7 +117,8 @@ public:
 private:
     /// Generates the signature hash for Witness version 0 scripts.
     Data getSignatureHashWitnessV0(const Script& scriptCode, size_t index,
-                                   enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+                                   enum TWBitcoinSigHashType hashType, uint64_t amount,
+                                   const SigHashCache* cache) const;
 
     /// Generates the signature hash for for scripts other than witness scripts.
     Data getSignatureHashBase(const Script& scriptCode, size_t index,
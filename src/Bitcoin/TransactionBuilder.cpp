@@ -6,14 +6,14 @@
 
 #include "TransactionBuilder.h"
 #include "Script.h"
-#include "TransactionSigner.h"
-#include "SignatureBuilder.h"
+#include "SizeEstimator.h"
 
 #include "../Coin.h"
 #include "../proto/Bitcoin.pb.h"
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 
 namespace TW::Bitcoin {
 
@@ -33,49 +33,56 @@ std::optional<TransactionOutput> TransactionBuilder::prepareOutputWithScript(std
 
 
 /// Estimate encoded size by simple formula
-int64_t estimateSimpleFee(const FeeCalculator& feeCalculator, const TransactionPlan& plan, int outputSize, int64_t byteFee) {
-    return feeCalculator.calculate(plan.utxos.size(), outputSize, byteFee);
+int64_t estimateSimpleFee(const FeeCalculator& feeCalculator, size_t inputCount, int outputSize, int64_t byteFee) {
+    return feeCalculator.calculate(inputCount, outputSize, byteFee);
 }
 
-/// Estimate encoded size by invoking sign(sizeOnly), get actual size
-int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionPlan& plan, int outputSize, const SigningInput& input) {
+/// Estimate encoded size by the size model of the signed transaction, without signing
+int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const SizeEstimator& sizeEstimator, const UTXOs& utxos, bool hasChange, int outputSize, const SigningInput& input) {
     TWPurpose coinPurpose = TW::purpose(static_cast<TWCoinType>(input.coinType));
     if (coinPurpose != TWPurposeBIP84) {
         // not segwit, return default simple estimate
-        return estimateSimpleFee(feeCalculator, plan, outputSize, input.byteFee);
+        return estimateSimpleFee(feeCalculator, utxos.size(), outputSize, input.byteFee);
     }
 
-    // duplicate input, with the current plan
-    auto inputWithPlan = std::move(input);
-    inputWithPlan.plan = plan;
+    const auto vSize = sizeEstimator.virtualSize(utxos, hasChange);
+    if (!vSize.has_value()) {
+        // signing would fail; return default simple estimate
+        return estimateSimpleFee(feeCalculator, utxos.size(), outputSize, input.byteFee);
+    }
+    uint64_t fee = input.byteFee * vSize.value();
+
+    return fee;
+}
 
-    auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(inputWithPlan, SigningMode_SizeEstimationOnly);
-    if (!result) {
-        // signing failed; return default simple estimate
-        return estimateSimpleFee(feeCalculator, plan, outputSize, input.byteFee);
+/// Checks whether the selected UTXOs cover the amount and the estimated fee of the transaction without change output
+bool coversChangelessFee(const FeeCalculator& feeCalculator, const SizeEstimator& sizeEstimator, const UTXOs& utxos, int outputSize, const SigningInput& input) {
+    const auto availableAmount = static_cast<Amount>(InputSelector<UTXO>::sum(utxos));
+    if (availableAmount < input.amount) {
+        return false;
     }
+    return estimateSegwitFee(feeCalculator, sizeEstimator, utxos, false, outputSize, input) <= availableAmount - input.amount;
+}
 
-    // Obtain the encoded size
-    auto transaction = result.payload();
-    Data dataNonSegwit;
-    transaction.encode(dataNonSegwit, Transaction::SegwitFormatMode::NonSegwit);
-    int64_t sizeNonSegwit = dataNonSegwit.size();
-    uint64_t vSize = 0;
-    // Check if there is segwit
-    if (!transaction.hasWitness()) {
-        // no segwit, virtual size is defined as non-segwit size
-        vSize = sizeNonSegwit;
+/// Keeps the best UTXO candidates for selection, and records what was left out in the plan
+UTXOs selectCandidates(const FeeCalculator& feeCalculator, const SizeEstimator& sizeEstimator, const SigningInput& input, TransactionPlan& plan) {
+    const auto simpleInputFee = feeCalculator.calculateSingleInput(input.byteFee);
+    std::function<int64_t(const UTXO&)> value;
+    if (input.candidateOrdering == Proto::CandidateOrderingEffectiveValue) {
+        value = [&](const UTXO& utxo) {
+            const auto inputSize = sizeEstimator.inputSize(utxo.script);
+            const auto inputFee = inputSize.has_value() ? input.byteFee * static_cast<int64_t>(inputSize->virtualSize()) : simpleInputFee;
+            return utxo.amount - inputFee;
+        };
     } else {
-        Data dataWitness;
-        transaction.encodeWitness(dataWitness);
-        int64_t witnessSize = 2 + dataWitness.size();
-        // compute virtual size:  (smaller) non-segwit + 1/4 of the diff (witness-only)
-        // (in other way: 3/4 of (smaller) non-segwit + 1/4 of segwit size)
-        vSize = sizeNonSegwit + witnessSize/4 + (witnessSize % 4 != 0);
+        // dust as in InputSelector::filterOutDust
+        value = [&](const UTXO& utxo) { return utxo.amount > simpleInputFee ? utxo.amount : 0; };
     }
-    uint64_t fee = input.byteFee * vSize;
-
-    return fee;
+    auto candidates = InputSelector<UTXO>::selectCandidates(input.utxos, input.maxCandidateUtxos, value);
+    plan.dustUtxoCount = static_cast<uint32_t>(candidates.dustCount);
+    plan.truncatedUtxoCount = static_cast<uint32_t>(candidates.truncatedCount);
+    plan.truncatedAmount = static_cast<Amount>(candidates.truncatedAmount);
+    return std::move(candidates.inputs);
 }
 
 int extraOutputCount(const SigningInput& input) {
@@ -96,8 +103,18 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
         plan.error = Common::Proto::Error_missing_input_utxos;
     } else {
         const auto& feeCalculator = getFeeCalculator(static_cast<TWCoinType>(input.coinType));
-        auto inputSelector = InputSelector<UTXO>(input.utxos, feeCalculator);
-        auto inputSum = InputSelector<UTXO>::sum(input.utxos);
+        const auto sizeEstimator = SizeEstimator(input);
+
+        // with a candidate limit, select among the best candidates only, and do not cut off the selection
+        const bool limitCandidates = input.maxCandidateUtxos > 0;
+        const size_t maxUtxos = limitCandidates ? input.maxCandidateUtxos : MaxUtxosHardLimit;
+        UTXOs candidates;
+        if (limitCandidates) {
+            candidates = selectCandidates(feeCalculator, sizeEstimator, input, plan);
+        }
+        const auto& utxos = limitCandidates ? candidates : input.utxos;
+        auto inputSelector = InputSelector<UTXO>(utxos, feeCalculator);
+        auto inputSum = InputSelector<UTXO>::sum(utxos);
 
         // select UTXOs
         plan.amount = input.amount;
@@ -111,25 +128,38 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
         auto extraOutputs = extraOutputCount(input);
         auto output_size = 2;
         UTXOs selectedInputs;
+        bool changeless = false;
         if (!maxAmount) {
-            output_size = 2 + extraOutputs; // output + change
-            if (input.utxos.size() <= SimpleModeLimit && input.utxos.size() <= MaxUtxosHardLimit) {
-                selectedInputs = inputSelector.select(plan.amount, input.byteFee, output_size);
-            } else {
-                selectedInputs = inputSelector.selectSimple(plan.amount, input.byteFee, output_size);
+            if (input.inputSelection == Proto::InputSelectionBranchAndBound) {
+                output_size = 1 + extraOutputs; // output, no change
+                selectedInputs = inputSelector.selectBranchAndBound(plan.amount, input.byteFee, output_size);
+                changeless = !selectedInputs.empty() && selectedInputs.size() <= maxUtxos &&
+                             coversChangelessFee(feeCalculator, sizeEstimator, selectedInputs, output_size, input);
+            }
+            if (!changeless) {
+                output_size = 2 + extraOutputs; // output + change
+                if (limitCandidates || (utxos.size() <= SimpleModeLimit && utxos.size() <= MaxUtxosHardLimit)) {
+                    selectedInputs = inputSelector.select(plan.amount, input.byteFee, output_size);
+                } else {
+                    selectedInputs = inputSelector.selectSimple(plan.amount, input.byteFee, output_size);
+                }
             }
         } else {
             output_size = 1 + extraOutputs; // output, no change
             selectedInputs = inputSelector.selectMaxAmount(input.byteFee);
         }
-        if (selectedInputs.size() <= MaxUtxosHardLimit) {
+        if (selectedInputs.size() <= maxUtxos) {
             plan.utxos = selectedInputs;
         } else {
             // truncate to limit number of selected UTXOs
             plan.utxos.clear();
-            for (auto i = 0; i < MaxUtxosHardLimit; ++i) {
+            for (size_t i = 0; i < maxUtxos; ++i) {
                 plan.utxos.push_back(selectedInputs[i]);
             }
+            for (size_t i = maxUtxos; i < selectedInputs.size(); ++i) {
+                ++plan.truncatedUtxoCount;
+                plan.truncatedAmount += selectedInputs[i].amount;
+            }
         }
 
         if (plan.utxos.size() == 0) {
@@ -144,15 +174,20 @@ TransactionPlan TransactionBuilder::plan(const SigningInput& input) {
                 assert(input.amount <= plan.availableAmount);
                 plan.amount = input.amount;
                 plan.fee = 0;
-                plan.change = plan.availableAmount - plan.amount;
+                plan.change = changeless ? 0 : plan.availableAmount - plan.amount;
             } else {
                 plan.amount = plan.availableAmount;
                 plan.fee = 0;
                 plan.change = 0;
             }
-            plan.fee = estimateSegwitFee(feeCalculator, plan, output_size, input);
+            plan.fee = estimateSegwitFee(feeCalculator, sizeEstimator, plan.utxos, plan.change > 0, output_size, input);
             // If fee is larger then availableAmount (can happen in special maxAmount case), we reduce it (and hope it will go through)
             plan.fee = std::min(plan.availableAmount, plan.fee);
+            if (changeless) {
+                // no change output, the excess (below the cost of change) goes to the fee
+                assert(plan.fee <= plan.availableAmount - plan.amount);
+                plan.fee = plan.availableAmount - plan.amount;
+            }
             assert(plan.fee >= 0 && plan.fee <= plan.availableAmount);
 
             // adjust/compute amount
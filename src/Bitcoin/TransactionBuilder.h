@@ -58,6 +58,7 @@ public:
     static std::optional<TransactionOutput> prepareOutputWithScript(std::string address, Amount amount, enum TWCoinType coin);
 
     /// The maximum number of UTXOs to consider.  UTXOs above this limit are cut off because it cak take very long.
+    /// Not used when SigningInput::maxCandidateUtxos is set, selection then runs on that many candidates.
     static const size_t MaxUtxosHardLimit;
 };
 
@@ -35,6 +35,15 @@ struct TransactionPlan {
 
     Data outputOpReturn;
 
+    /// Number of UTXOs left out of selection as dust by the candidate filter.
+    uint32_t dustUtxoCount = 0;
+
+    /// Number of UTXOs left out beyond the candidate limit, or cut off by the hard limit.
+    uint32_t truncatedUtxoCount = 0;
+
+    /// Total amount of the truncated UTXOs.
+    Amount truncatedAmount = 0;
+
     Common::Proto::SigningError error = Common::Proto::SigningError::OK;
 
     TransactionPlan() = default;
@@ -47,6 +56,9 @@ struct TransactionPlan {
         , utxos(std::vector<UTXO>(plan.utxos().begin(), plan.utxos().end()))
         , branchId(plan.branch_id().begin(), plan.branch_id().end())
         , outputOpReturn(plan.output_op_return().begin(), plan.output_op_return().end())
+        , dustUtxoCount(plan.dust_utxo_count())
+        , truncatedUtxoCount(plan.truncated_utxo_count())
+        , truncatedAmount(plan.truncated_amount())
         , error(plan.error())
     {}
 
@@ -61,6 +73,9 @@ struct TransactionPlan {
         }
         plan.set_branch_id(branchId.data(), branchId.size());
         plan.set_output_op_return(outputOpReturn.data(), outputOpReturn.size());
+        plan.set_dust_utxo_count(dustUtxoCount);
+        plan.set_truncated_utxo_count(truncatedUtxoCount);
+        plan.set_truncated_amount(truncatedAmount);
         plan.set_error(error);
         return plan;
     }
@@ -75,7 +75,8 @@ AddressV2::AddressV2(const PublicKey& publicKey) {
         throw std::invalid_argument("Invalid public key type");
     }
     type = 0; // public key
-    root = keyHash(subData(publicKey.bytes, 0, 64));
+    // key and chain code
+    root = keyHash(publicKey.bytes.view().subView(0, 64));
     // address attributes: empty map for V2, for V1 encrypted derivation path
     Cbor::Encode emptyMap = Cbor::Encode::map({});
     attrs = emptyMap.encoded();
@@ -115,7 +115,9 @@ AddressV3::AddressV3(const PublicKey& publicKey) {
     }
     kind = Kind_Base;
 
-    *this = createBase(Network_Production, PublicKey(subData(publicKey.bytes, 0, 32), TWPublicKeyTypeED25519), PublicKey(subData(publicKey.bytes, 64, 32), TWPublicKeyTypeED25519));
+    const auto spendingKey = publicKey.keyView();
+    const auto stakingKey = publicKey.secondKeyView();
+    *this = createBase(Network_Production, PublicKey(spendingKey.data(), spendingKey.size(), TWPublicKeyTypeED25519), PublicKey(stakingKey.data(), stakingKey.size(), TWPublicKeyTypeED25519));
 }
 
 AddressV3::AddressV3(const Data& data) {
@@ -109,7 +109,7 @@ Common::Proto::SigningError Signer::assembleSignatures(vector<pair<Data, Data>>&
         const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519Extended);
         const auto signature = privateKey.sign(txId, TWCurveED25519Extended);
         // public key (first 32 bytes) and signature (64 bytes)
-        signatures.emplace_back(subData(publicKey.bytes, 0, 32), signature);
+        signatures.emplace_back(publicKey.key(), signature);
     }
 
     return Common::Proto::OK;
@@ -152,27 +152,32 @@ CoinEntry* coinDispatcher(TWCoinType coinType) {
     return entry;
 }
 
-const Derivation CoinInfo::derivationByName(TWDerivation name) const {
-    if (name == TWDerivationDefault && derivation.size() > 0) {
-        return derivation[0];
+static const Derivation noDerivation;
+
+const Derivation& CoinInfo::defaultDerivation() const {
+    return derivationCount > 0 ? derivations[0] : noDerivation;
+}
+
+const Derivation& CoinInfo::derivationByName(TWDerivation name) const {
+    if (name == TWDerivationDefault && derivationCount > 0) {
+        return derivations[0];
     }
-    for (auto deriv: derivation) {
-        if (deriv.name == name) {
-            return deriv;
+    for (size_t i = 0; i < derivationCount; ++i) {
+        if (derivations[i].name == name) {
+            return derivations[i];
         }
     }
-    return Derivation();
+    return noDerivation;
 }
 
 bool TW::validateAddress(TWCoinType coin, const std::string& string) {
-    auto p2pkh = TW::p2pkhPrefix(coin);
-    auto p2sh = TW::p2shPrefix(coin);
-    const auto* hrp = stringForHRP(TW::hrp(coin));
+    const auto& info = getCoinInfo(coin);
+    const auto* hrp = stringForHRP(info.hrp);
 
     // dispatch
     auto* dispatcher = coinDispatcher(coin);
     assert(dispatcher != nullptr);
-    return dispatcher->validateAddress(coin, string, p2pkh, p2sh, hrp);
+    return dispatcher->validateAddress(coin, string, info.p2pkhPrefix, info.p2shPrefix, hrp);
 }
 
 std::string TW::normalizeAddress(TWCoinType coin, const std::string& address) {
@@ -210,6 +215,16 @@ std::string TW::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDer
     return dispatcher->deriveAddress(coin, derivation, publicKey, p2pkh, hrp);
 }
 
+std::vector<std::string> TW::deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation) {
+    const auto p2pkh = TW::p2pkhPrefix(coin);
+    const auto* hrp = stringForHRP(TW::hrp(coin));
+
+    // dispatch once for the whole batch
+    auto* dispatcher = coinDispatcher(coin);
+    assert(dispatcher != nullptr);
+    return dispatcher->deriveAddresses(coin, derivation, publicKeys, p2pkh, hrp);
+}
+
 Data TW::addressToData(TWCoinType coin, const std::string& address) {
     const auto* dispatcher = coinDispatcher(coin);
     assert(dispatcher != nullptr);
@@ -260,8 +275,6 @@ Data TW::anyCoinBuildTransactionInput(TWCoinType coinType, const std::string& fr
 
 // Coin info accessors
 
-extern const CoinInfo getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
-
 TWBlockchain TW::blockchain(TWCoinType coin) {
     return getCoinInfo(coin).blockchain;
 }
@@ -291,11 +304,11 @@ TWHDVersion TW::xprvVersionDerivation(TWCoinType coin, TWDerivation derivation)
 }
 
 DerivationPath TW::derivationPath(TWCoinType coin) {
-    return DerivationPath(getCoinInfo(coin).defaultDerivation().path);
+    return getCoinInfo(coin).defaultDerivation().derivationPath();
 }
 
 DerivationPath TW::derivationPath(TWCoinType coin, TWDerivation derivation) {
-    return DerivationPath(getCoinInfo(coin).derivationByName(derivation).path);
+    return getCoinInfo(coin).derivationByName(derivation).derivationPath();
 }
 
 const char* TW::derivationName(TWCoinType coin, TWDerivation derivation) {
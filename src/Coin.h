@@ -80,6 +80,9 @@ std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey);
 /// Derives the address for a particular coin from the public key, with given derivation.
 std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TWDerivation derivation);
 
+/// Derives the addresses for a particular coin from a list of public keys, with given derivation.
+std::vector<std::string> deriveAddresses(TWCoinType coin, const std::vector<PublicKey>& publicKeys, TWDerivation derivation);
+
 /// Returns the binary representation of a string address
 Data addressToData(TWCoinType coin, const std::string& address);
 
@@ -131,16 +134,21 @@ struct Derivation {
     const char* nameString = "";
     TWHDVersion xpubVersion = TWHDVersionNone;
     TWHDVersion xprvVersion = TWHDVersionNone;
+    // path, parsed at code generation
+    DerivationPathIndices indices;
+
+    DerivationPath derivationPath() const { return DerivationPath(indices); }
 };
 
-// Contains only simple types.
+// Contains only simple types, to be stored in a constant table.
 struct CoinInfo {
     const char* id;
     const char* name;
     TWBlockchain blockchain;
     TWPurpose purpose;
     TWCurve curve;
-    std::vector<Derivation> derivation;
+    const Derivation* derivations;
+    size_t derivationCount;
     TWPublicKeyType publicKeyType;
     byte staticPrefix;
     byte p2pkhPrefix;
@@ -157,10 +165,12 @@ struct CoinInfo {
     uint32_t slip44;
 
     // returns default derivation
-    const Derivation defaultDerivation() const {
-        return (derivation.size() > 0) ? derivation[0] : Derivation();
-    }
-    const Derivation derivationByName(TWDerivation name) const;
+    const Derivation& defaultDerivation() const;
+    const Derivation& derivationByName(TWDerivation name) const;
 };
 
+/// Returns the registry entry of a coin, or defaults if the coin is missing.
+/// The entry is a static constant, valid for the lifetime of the program.
+const CoinInfo& getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
+
 } // namespace TW
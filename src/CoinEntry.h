@@ -36,6 +36,15 @@ public:
     virtual std::string deriveAddress(TWCoinType coin, TWDerivation derivation, const PublicKey& publicKey, TW::byte p2pkh, const char* hrp) const {
         return deriveAddress(coin, publicKey, p2pkh, hrp);
     }
+    // Address derivation of many public keys, by default one by one; coins may hash the keys together
+    virtual std::vector<std::string> deriveAddresses(TWCoinType coin, TWDerivation derivation, const std::vector<PublicKey>& publicKeys, TW::byte p2pkh, const char* hrp) const {
+        std::vector<std::string> addresses;
+        addresses.reserve(publicKeys.size());
+        for (const auto& publicKey : publicKeys) {
+            addresses.push_back(deriveAddress(coin, derivation, publicKey, p2pkh, hrp));
+        }
+        return addresses;
+    }
     // Return the binary representation of a string address, used by AnyAddress
     // It is optional, if not defined, 'AnyAddress' interface will not support this coin.
     virtual Data addressToData(TWCoinType coin, const std::string& address) const { return {}; }
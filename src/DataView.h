@@ -0,0 +1,70 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace TW {
+
+/// A read-only view of contiguous bytes owned elsewhere, valid as long as the viewed storage.
+///
+/// The library is built as C++17, this stands in for `std::span<const byte>`.
+/// Converts implicitly to `Data` for code that needs a copy.
+class DataView {
+public:
+    using value_type = byte;
+    using size_type = std::size_t;
+    using const_reference = const byte&;
+    using iterator = const byte*;
+    using const_iterator = const byte*;
+
+    constexpr DataView() = default;
+    constexpr DataView(const byte* data, size_t size) : items(data), length(size) {}
+    DataView(const Data& data) : items(data.data()), length(data.size()) {}
+
+    operator Data() const { return Data(begin(), end()); }
+
+    constexpr size_t size() const { return length; }
+    constexpr bool empty() const { return length == 0; }
+    constexpr const byte* data() const { return items; }
+
+    constexpr const byte& operator[](size_t i) const { return items[i]; }
+
+    constexpr const_iterator begin() const { return items; }
+    constexpr const_iterator end() const { return items + length; }
+    constexpr const_iterator cbegin() const { return items; }
+    constexpr const_iterator cend() const { return items + length; }
+
+    /// Returns the part from `startIndex` of at most `size` bytes, like `subData`: empty if
+    /// `startIndex` is past the end, shorter if the view is.
+    constexpr DataView subView(size_t startIndex, size_t size) const {
+        if (startIndex >= length) {
+            return {};
+        }
+        return {items + startIndex, std::min(size, length - startIndex)};
+    }
+
+private:
+    const byte* items = nullptr;
+    size_t length = 0;
+};
+
+inline bool operator==(const DataView& lhs, const DataView& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+inline bool operator!=(const DataView& lhs, const DataView& rhs) {
+    return !(lhs == rhs);
+}
+
+inline void append(Data& data, const DataView& suffix) {
+    data.insert(data.end(), suffix.begin(), suffix.end());
+}
+
+} // namespace TW
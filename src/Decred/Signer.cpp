@@ -52,6 +52,7 @@ Result<Transaction, Common::Proto::SigningError> Signer::sign() {
     }
 
     signedInputs = transaction.inputs;
+    sigHashCache.reset();
 
     const auto hashSingle = Bitcoin::hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
     for (auto i = 0; i < txPlan.utxos.size(); i += 1) {
@@ -104,9 +105,9 @@ Result<Bitcoin::Script, Common::Proto::SigningError> Signer::sign(Bitcoin::Scrip
 }
 
 Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin::Script script, size_t index) {
-    Transaction transactionToSign(transaction);
-    transactionToSign.inputs = signedInputs;
-    transactionToSign.outputs = transaction.outputs;
+    // The signature hash only commits to outpoints, sequences and outputs, which signing leaves unchanged,
+    // so there is no need to copy the transaction with the inputs signed so far.
+    const auto& transactionToSign = transaction;
 
     Data data;
     std::vector<Data> keys;
@@ -175,7 +176,11 @@ Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin:
 
 Data Signer::createSignature(const Transaction& transaction, const Bitcoin::Script& script,
                              const Data& key, size_t index) {
-    auto sighash = transaction.computeSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()));
+    if (!sigHashCache.has_value()) {
+        sigHashCache = transaction.getSigHashCache();
+    }
+    auto sighash = transaction.computeSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()),
+                                                    &sigHashCache.value());
     auto pk = PrivateKey(key);
     auto signature = pk.signAsDER(Data(begin(sighash), end(sighash)), TWCurveSECP256k1);
     if (script.empty()) {
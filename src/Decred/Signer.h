@@ -19,6 +19,7 @@
 #include "../proto/Decred.pb.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -47,6 +48,9 @@ class Signer {
     /// List of signed inputs.
     Bitcoin::TransactionInputs<TransactionInput> signedInputs;
 
+    /// Prefix hash of the transaction, computed once on first use and shared by all inputs
+    std::optional<SigHashCache> sigHashCache;
+
   public:
     /// Initializes a transaction signer.
     Signer() = default;
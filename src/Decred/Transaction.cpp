@@ -29,7 +29,8 @@ std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
 } // namespace
 
 Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, size_t index,
-                                       enum TWBitcoinSigHashType hashType) const {
+                                       enum TWBitcoinSigHashType hashType,
+                                       const SigHashCache* cache) const {
     assert(index < inputs.size());
 
     if (Bitcoin::hashTypeIsSingle(hashType) && index >= outputs.size()) {
@@ -37,6 +38,18 @@ Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, siz
                                     "larger than the number of outputs");
     }
 
+    if (cache != nullptr && (hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
+        !Bitcoin::hashTypeIsNone(hashType) && !Bitcoin::hashTypeIsSingle(hashType)) {
+        // all inputs and outputs are committed to, as in the cached prefix hash
+        auto preimage = Data();
+        preimage.reserve(Hash::sha256Size * 2 + 4);
+        encode32LE(hashType, preimage);
+        std::copy(cache->prefixHash.begin(), cache->prefixHash.end(), std::back_inserter(preimage));
+        const auto witnessHash = computeWitnessHash(inputs, prevOutScript, index);
+        std::copy(witnessHash.begin(), witnessHash.end(), std::back_inserter(preimage));
+        return Hash::blake256(preimage);
+    }
+
     auto inputsToSign = inputs;
     auto signIndex = index;
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0) {
@@ -119,6 +132,10 @@ Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsT
     return Hash::blake256(preimage);
 }
 
+SigHashCache Transaction::getSigHashCache() const {
+    return SigHashCache{computePrefixHash(inputs, outputs, 0, 0, TWBitcoinSigHashTypeAll)};
+}
+
 Data Transaction::computeWitnessHash(const std::vector<TransactionInput>& inputsToSign,
                                      const Bitcoin::Script& signScript,
                                      std::size_t signIndex) const {
@@ -21,6 +21,12 @@ namespace TW::Decred {
 
 enum class SerializeType : uint16_t { full, noWitness, onlyWitness };
 
+/// Precomputed hash of the transaction prefix, which is the same in the signature pre-image of every
+/// input signed with SIGHASH_ALL.  Computing it once per transaction avoids re-serializing the prefix for every input.
+struct SigHashCache {
+    Data prefixHash;
+};
+
 struct Transaction {
     /// Serialization format
     SerializeType serializeType = SerializeType::full;
@@ -50,8 +56,14 @@ struct Transaction {
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
     /// Generates the signature pre-image.
+    /// The optional cache is used instead of recomputing the prefix hash, for SIGHASH_ALL.
     Data computeSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
-                              enum TWBitcoinSigHashType hashType) const;
+                              enum TWBitcoinSigHashType hashType,
+                              const SigHashCache* cache = nullptr) const;
+
+    /// Computes the prefix hash shared by all inputs; valid as long as the inputs' outpoints and
+    /// sequences, and the outputs, stay unchanged.
+    SigHashCache getSigHashCache() const;
 
     /// Generates the transaction hash.
     Data hash() const;
@@ -6,7 +6,7 @@
 
 #include "DerivationPath.h"
 
-#include <cstdio>
+#include <charconv>
 #include <stdexcept>
 
 using namespace TW;
@@ -24,12 +24,11 @@ DerivationPath::DerivationPath(const std::string& string) {
 
     while (it != end) {
         uint32_t value;
-        if (std::sscanf(it, "%ud", &value) != 1) {
+        const auto result = std::from_chars(it, end, value);
+        if (result.ec != std::errc()) {
             throw std::invalid_argument("Invalid component");
         }
-        while (it != end && isdigit(*it)) {
-            ++it;
-        }
+        it = result.ptr;
 
         auto hardened = (it != end && *it == '\'');
         if (hardened) {
@@ -47,14 +46,20 @@ DerivationPath::DerivationPath(const std::string& string) {
     }
 }
 
-std::string DerivationPath::string() const noexcept {
-    std::string result = "m/";
-    for (auto& index : indices) {
-        result += index.string();
-        result += "/";
-    }
-    if (result.back() == '/') {
-        result.erase(result.end() - 1);
+size_t DerivationPath::format(char* buffer) const noexcept {
+    auto* it = buffer;
+    *it++ = 'm';
+    for (const auto& index : indices) {
+        *it++ = '/';
+        it = std::to_chars(it, buffer + maxStringSize, index.value).ptr;
+        if (index.hardened) {
+            *it++ = '\'';
+        }
     }
-    return result;
+    return it - buffer;
+}
+
+std::string DerivationPath::string() const noexcept {
+    char buffer[maxStringSize];
+    return std::string(buffer, format(buffer));
 }
@@ -9,8 +9,11 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWPurpose.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -21,10 +24,10 @@ struct DerivationPathIndex {
     bool hardened = true;
 
     DerivationPathIndex() = default;
-    DerivationPathIndex(uint32_t value, bool hardened = true) : value(value), hardened(hardened) {}
+    constexpr DerivationPathIndex(uint32_t value, bool hardened = true) : value(value), hardened(hardened) {}
 
     /// The derivation index.
-    uint32_t derivationIndex() const {
+    constexpr uint32_t derivationIndex() const {
         if (hardened) {
             return value | 0x80000000;
         } else {
@@ -41,9 +44,70 @@ struct DerivationPathIndex {
     }
 };
 
+/// Indices of a derivation path, stored inline (without heap allocation) up to `maxDepth`.
+class DerivationPathIndices {
+public:
+    static constexpr size_t maxDepth = 10;
+
+    using value_type = DerivationPathIndex;
+    using iterator = DerivationPathIndex*;
+    using const_iterator = const DerivationPathIndex*;
+
+    constexpr DerivationPathIndices() = default;
+
+    /// @throws std::invalid_argument if there are more than `maxDepth` indices.
+    constexpr DerivationPathIndices(std::initializer_list<DerivationPathIndex> l) {
+        for (const auto& index : l) {
+            push_back(index);
+        }
+    }
+
+    /// @throws std::invalid_argument if there are more than `maxDepth` indices.
+    DerivationPathIndices(const std::vector<DerivationPathIndex>& v) {
+        for (const auto& index : v) {
+            push_back(index);
+        }
+    }
+
+    constexpr size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+
+    constexpr DerivationPathIndex& operator[](size_t i) { return items[i]; }
+    constexpr const DerivationPathIndex& operator[](size_t i) const { return items[i]; }
+    constexpr DerivationPathIndex& back() { return items[count - 1]; }
+    constexpr const DerivationPathIndex& back() const { return items[count - 1]; }
+
+    constexpr iterator begin() { return items; }
+    constexpr iterator end() { return items + count; }
+    constexpr const_iterator begin() const { return items; }
+    constexpr const_iterator end() const { return items + count; }
+
+    /// @throws std::invalid_argument if the path is already `maxDepth` deep.
+    constexpr void push_back(const DerivationPathIndex& index) {
+        if (count == maxDepth) {
+            throw std::invalid_argument("Derivation path is too deep");
+        }
+        items[count++] = index;
+    }
+
+    constexpr void emplace_back(uint32_t value, bool hardened = true) {
+        push_back(DerivationPathIndex(value, hardened));
+    }
+
+    constexpr void pop_back() { --count; }
+    constexpr void clear() { count = 0; }
+
+private:
+    DerivationPathIndex items[maxDepth] = {};
+    size_t count = 0;
+};
+
 /// A BIP32 HD wallet derivation path.
 struct DerivationPath {
-    std::vector<DerivationPathIndex> indices;
+    /// Maximum length of the string representation: `m` and `maxDepth` components like `/4294967295'`
+    static constexpr size_t maxStringSize = 1 + DerivationPathIndices::maxDepth * 12;
+
+    DerivationPathIndices indices;
 
     TWPurpose purpose() const {
         if (indices.size() == 0) { return TWPurposeBIP44; }
@@ -97,18 +161,15 @@ struct DerivationPath {
 
     DerivationPath() = default;
     explicit DerivationPath(std::initializer_list<DerivationPathIndex> l) : indices(l) {}
-    explicit DerivationPath(std::vector<DerivationPathIndex> indices) : indices(std::move(indices)) {}
+    explicit DerivationPath(const std::vector<DerivationPathIndex>& indices) : indices(indices) {}
+    explicit DerivationPath(const DerivationPathIndices& indices) : indices(indices) {}
 
     /// Creates a `DerivationPath` by BIP44 components.
     DerivationPath(TWPurpose purpose, uint32_t coin, uint32_t account, uint32_t change,
-                   uint32_t address) 
-    : indices(std::vector<DerivationPathIndex>(5)) {
-        setPurpose(purpose);
-        setCoin(coin);
-        setAccount(account);
-        setChange(change);
-        setAddress(address);
-    }
+                   uint32_t address)
+    : indices({DerivationPathIndex(purpose, /* hardened: */ true), DerivationPathIndex(coin, /* hardened: */ true),
+               DerivationPathIndex(account, /* hardened: */ true), DerivationPathIndex(change, /* hardened: */ false),
+               DerivationPathIndex(address, /* hardened: */ false)}) {}
 
     /// Creates a derivation path with a string description like `m/10/0/2'/3`
     ///
@@ -118,6 +179,10 @@ struct DerivationPath {
 
     /// String representation.
     std::string string() const noexcept;
+
+    /// Writes the string representation, without terminating zero, to `buffer` of at least
+    /// `maxStringSize` bytes, and returns its length.
+    size_t format(char* buffer) const noexcept;
 };
 
 inline bool operator==(const DerivationPathIndex& lhs, const DerivationPathIndex& rhs) {
@@ -8,6 +8,8 @@
 
 #include "../Hash.h"
 #include "../HexCoding.h"
+
+#include <algorithm>
 #include <cctype>
 
 using namespace TW;
@@ -15,15 +17,20 @@ using namespace TW::Ethereum;
 
 std::string Ethereum::checksumed(const Address& address, enum ChecksumType type) {
     const auto addressString = hex(address.bytes);
-    const auto hash = hex(Hash::keccak256(addressString));
+    const auto hash = Hash::keccak256(addressString);
+    return checksumed(addressString, hash.data());
+}
 
+std::string Ethereum::checksumed(const std::string& addressHex, const byte* hash) {
     std::string string = "0x";
-    for (auto i = 0; i < std::min(addressString.size(), hash.size()); i += 1) {
-        const auto a = addressString[i];
-        const auto h = hash[i];
+    string.reserve(2 + addressHex.size());
+    for (size_t i = 0; i < std::min(addressHex.size(), 2 * Hash::sha256Size); i += 1) {
+        const auto a = addressHex[i];
+        // nibble i of the hash, high nibble first
+        const auto h = (i % 2 == 0 ? hash[i / 2] >> 4 : hash[i / 2]) & 0x0f;
         if (a >= '0' && a <= '9') {
             string.push_back(a);
-        } else if ((h >= '8' && h <= '9') || (h >= 'a' && h <= 'f')) {
+        } else if (h >= 8) {
             string.push_back(static_cast<char>(toupper(a)));
         } else {
             string.push_back(static_cast<char>(tolower(a)));
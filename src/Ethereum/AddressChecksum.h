@@ -19,4 +19,7 @@ enum ChecksumType {
 
 std::string checksumed(const Address& address, enum ChecksumType type);
 
+/// Applies the EIP55 checksum to the lowercase hex of an address, given the Keccak256 hash of that hex.
+std::string checksumed(const std::string& addressHex, const byte* hash);
+
 } // namespace TW::Ethereum
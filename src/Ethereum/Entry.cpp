@@ -7,10 +7,16 @@
 #include "Entry.h"
 
 #include "Address.h"
+#include "AddressChecksum.h"
 #include "Signer.h"
 
+#include "../Hash.h"
+#include "../HexCoding.h"
+
 #include "proto/TransactionCompiler.pb.h"
 
+#include <algorithm>
+
 using namespace TW::Ethereum;
 using namespace TW;
 using namespace std;
@@ -28,6 +34,42 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return Address(publicKey).string();
 }
 
+vector<string> Entry::deriveAddresses(TWCoinType coin, TWDerivation derivation, const vector<PublicKey>& publicKeys, TW::byte p2pkh, const char* hrp) const {
+    const auto extended = all_of(publicKeys.begin(), publicKeys.end(), [](const PublicKey& publicKey) {
+        return publicKey.type == TWPublicKeyTypeSECP256k1Extended;
+    });
+    if (!extended) {
+        return CoinEntry::deriveAddresses(coin, derivation, publicKeys, p2pkh, hrp);
+    }
+
+    // hash the keys together, without their 0x04 prefix, then the hex of the addresses for their checksums
+    vector<const byte*> keys;
+    keys.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        keys.push_back(publicKey.bytes.data() + 1);
+    }
+    const auto keyHashes = Hash::keccak256(keys, PublicKey::secp256k1ExtendedSize - 1);
+
+    vector<string> addressHexes;
+    addressHexes.reserve(publicKeys.size());
+    for (const auto& hash : keyHashes) {
+        addressHexes.push_back(hex(hash.end() - Address::size, hash.end()));
+    }
+    vector<const byte*> checksumInputs;
+    checksumInputs.reserve(publicKeys.size());
+    for (const auto& addressHex : addressHexes) {
+        checksumInputs.push_back(reinterpret_cast<const byte*>(addressHex.data()));
+    }
+    const auto checksumHashes = Hash::keccak256(checksumInputs, 2 * Address::size);
+
+    vector<string> addresses;
+    addresses.reserve(publicKeys.size());
+    for (size_t i = 0; i < addressHexes.size(); ++i) {
+        addresses.push_back(checksumed(addressHexes[i], checksumHashes[i].data()));
+    }
+    return addresses;
+}
+
 Data Entry::addressToData(TWCoinType coin, const std::string& address) const {
     const auto addr = Address(address);
     return {addr.bytes.begin(), addr.bytes.end()};
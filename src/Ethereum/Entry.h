@@ -17,6 +17,7 @@ public:
     virtual bool validateAddress(TWCoinType coin, const std::string& address, TW::byte p2pkh, TW::byte p2sh, const char* hrp) const;
     virtual std::string normalizeAddress(TWCoinType coin, const std::string& address) const;
     virtual std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byte p2pkh, const char* hrp) const;
+    virtual std::vector<std::string> deriveAddresses(TWCoinType coin, TWDerivation derivation, const std::vector<PublicKey>& publicKeys, TW::byte p2pkh, const char* hrp) const;
     virtual Data addressToData(TWCoinType coin, const std::string& address) const;
     virtual void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
     virtual bool supportsJSONSigning() const { return true; }
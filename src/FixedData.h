@@ -0,0 +1,127 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "DataView.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+namespace TW {
+
+/// Up to `Capacity` bytes stored inline, without heap allocation.
+///
+/// Offers the parts of the `Data` interface that do not grow beyond the capacity,
+/// and converts implicitly to `Data` for code that needs a vector.
+template <std::size_t Capacity>
+class FixedData {
+public:
+    using value_type = byte;
+    using size_type = std::size_t;
+    using reference = byte&;
+    using const_reference = const byte&;
+    using iterator = byte*;
+    using const_iterator = const byte*;
+
+    FixedData() = default;
+
+    /// @throws std::invalid_argument if `size` exceeds the capacity.
+    FixedData(const byte* data, size_t size) { assign(data, size); }
+
+    /// @throws std::invalid_argument if `data` exceeds the capacity.
+    explicit FixedData(const Data& data) { assign(data.data(), data.size()); }
+
+    /// @throws std::invalid_argument if `data` exceeds the capacity.
+    FixedData& operator=(const Data& data) {
+        assign(data.data(), data.size());
+        return *this;
+    }
+
+    /// @throws std::invalid_argument if `size` exceeds the capacity.
+    void assign(const byte* data, size_t size) {
+        if (size > Capacity) {
+            throw std::invalid_argument("Data too long");
+        }
+        std::copy(data, data + size, items);
+        length = size;
+    }
+
+    /// @throws std::invalid_argument if `size` exceeds the capacity.
+    void resize(size_t size) {
+        if (size > Capacity) {
+            throw std::invalid_argument("Data too long");
+        }
+        if (size > length) {
+            std::fill(items + length, items + size, 0);
+        }
+        length = size;
+    }
+
+    operator Data() const { return Data(begin(), end()); }
+
+    /// A view of the bytes, valid until they are changed.
+    DataView view() const { return {items, length}; }
+
+    static constexpr size_t capacity() { return Capacity; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+
+    byte* data() { return items; }
+    const byte* data() const { return items; }
+
+    byte& operator[](size_t i) { return items[i]; }
+    const byte& operator[](size_t i) const { return items[i]; }
+    byte& front() { return items[0]; }
+    const byte& front() const { return items[0]; }
+    byte& back() { return items[length - 1]; }
+    const byte& back() const { return items[length - 1]; }
+
+    iterator begin() { return items; }
+    iterator end() { return items + length; }
+    const_iterator begin() const { return items; }
+    const_iterator end() const { return items + length; }
+    const_iterator cbegin() const { return items; }
+    const_iterator cend() const { return items + length; }
+
+private:
+    byte items[Capacity] = {};
+    size_t length = 0;
+};
+
+template <std::size_t N, std::size_t M>
+inline bool operator==(const FixedData<N>& lhs, const FixedData<M>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+template <std::size_t N>
+inline bool operator==(const FixedData<N>& lhs, const Data& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+template <std::size_t N>
+inline bool operator==(const Data& lhs, const FixedData<N>& rhs) {
+    return rhs == lhs;
+}
+template <std::size_t N, std::size_t M>
+inline bool operator!=(const FixedData<N>& lhs, const FixedData<M>& rhs) {
+    return !(lhs == rhs);
+}
+template <std::size_t N>
+inline bool operator!=(const FixedData<N>& lhs, const Data& rhs) {
+    return !(lhs == rhs);
+}
+template <std::size_t N>
+inline bool operator!=(const Data& lhs, const FixedData<N>& rhs) {
+    return !(rhs == lhs);
+}
+
+template <std::size_t N>
+inline void append(Data& data, const FixedData<N>& suffix) {
+    data.insert(data.end(), suffix.begin(), suffix.end());
+}
+
+} // namespace TW
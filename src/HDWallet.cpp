@@ -21,11 +21,93 @@
 #include <TrezorCrypto/curves.h>
 #include <TrezorCrypto/memzero.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <exception>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 using namespace TW;
 
+namespace TW {
+
+/// Bounded cache of derived HD nodes, keyed by curve and derivation path.  The least recently used
+/// entries are evicted when full; evicted nodes are zeroized.  Thread-safe.
+class HDNodeCache {
+  public:
+    static constexpr size_t capacity = 64;
+
+    HDNodeCache() = default;
+    HDNodeCache(const HDNodeCache&) = delete;
+    HDNodeCache& operator=(const HDNodeCache&) = delete;
+
+    ~HDNodeCache() {
+        for (auto& entry : entries) {
+            memzero(&entry.second, sizeof(HDNode));
+        }
+    }
+
+    /// Returns the cache of the wallet, may be null (moved-from wallet)
+    static HDNodeCache* of(const HDWallet& wallet) { return wallet.nodeCache.get(); }
+
+    /// Looks up the cached node for the longest prefix of the path, of at most maxLength indices.
+    /// Returns the length of the prefix found, and the node.
+    std::optional<size_t> findLongestPrefix(TWCurve curve, const uint32_t* path, size_t size, size_t maxLength, HDNode& node) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto length = std::min(maxLength, size) + 1; length-- > 0;) {
+            const auto it = index.find(makeKey(curve, path, length));
+            if (it != index.end()) {
+                entries.splice(entries.begin(), entries, it->second);
+                node = it->second->second;
+                return length;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void insert(TWCurve curve, const uint32_t* path, size_t size, const HDNode& node) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto key = makeKey(curve, path, size);
+        if (const auto it = index.find(key); it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            it->second->second = node;
+            return;
+        }
+        entries.emplace_front(key, node);
+        index.emplace(key, entries.begin());
+        if (entries.size() > capacity) {
+            memzero(&entries.back().second, sizeof(HDNode));
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+  private:
+    /// Curve, path length and path indices, stored inline so that lookups do not allocate
+    using Key = std::tuple<TWCurve, size_t, std::array<uint32_t, DerivationPathIndices::maxDepth>>;
+    using Entries = std::list<std::pair<Key, HDNode>>;
+
+    static Key makeKey(TWCurve curve, const uint32_t* path, size_t size) {
+        auto key = Key(curve, size, {});
+        std::copy(path, path + size, std::get<2>(key).begin());
+        return key;
+    }
+
+    std::mutex mutex;
+    /// Most recently used first
+    Entries entries;
+    std::map<Key, Entries::iterator> index;
+};
+
+} // namespace TW
+
 namespace {
 
 uint32_t fingerprint(HDNode *node, Hash::Hasher hasher);
@@ -33,6 +115,14 @@ std::string serialize(const HDNode *node, uint32_t fingerprint, uint32_t version
 bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher, HDNode *node);
 HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& derivationPath);
 HDNode getMasterNode(const HDWallet& wallet, TWCurve curve);
+std::optional<PublicKey> publicKeyFromNode(HDNode* node, TWCoinType coin, TWCurve curve);
+
+/// Calls worker(begin, end) on contiguous chunks of [0, count), on up to `threads` threads; rethrows the first exception.
+template <typename Worker>
+void forEachChunk(uint32_t count, size_t threads, const Worker& worker);
+
+/// Moves a chunk of derived addresses to its place in the output.
+void moveAddresses(std::vector<std::string>&& chunk, std::vector<std::string>& addresses, uint32_t begin);
 
 const char* curveName(TWCurve curve);
 } // namespace
@@ -52,9 +142,9 @@ HDWallet::HDWallet(int strength, const std::string& passphrase)
 }
 
 HDWallet::HDWallet(const std::string& mnemonic, const std::string& passphrase, const bool check)
-    : mnemonic(mnemonic), passphrase(passphrase) {
+    : mnemonic(check ? Mnemonic::normalize(mnemonic) : mnemonic), passphrase(passphrase) {
     if (mnemonic.length() == 0 ||
-        (check && !Mnemonic::isValid(mnemonic))) {
+        (check && !Mnemonic::detectLanguage(mnemonic))) {
         throw std::invalid_argument("Invalid mnemonic");
     }
     updateSeedAndEntropy(check);
@@ -72,6 +162,51 @@ HDWallet::HDWallet(const Data& entropy, const std::string& passphrase)
     updateSeedAndEntropy();
 }
 
+HDWallet::HDWallet(const std::string& mnemonic, const std::string& passphrase, const std::array<byte, seedSize>& seed, bool check)
+    : seed(seed), mnemonic(mnemonic), passphrase(passphrase) {
+    nodeCache = std::make_shared<HDNodeCache>();
+    updateEntropy(check);
+}
+
+std::vector<HDWallet> HDWallet::fromMnemonics(const std::vector<std::string>& mnemonics, const std::string& passphrase, bool check) {
+    // checked mnemonics are seeded in their NFKD form, like the single mnemonic constructor
+    std::vector<std::string> phrases;
+    phrases.reserve(mnemonics.size());
+    for (const auto& mnemonic : mnemonics) {
+        if (mnemonic.length() == 0 || (check && !Mnemonic::detectLanguage(mnemonic))) {
+            throw std::invalid_argument("Invalid mnemonic");
+        }
+        phrases.push_back(check ? Mnemonic::normalize(mnemonic) : mnemonic);
+    }
+
+    std::vector<HDWallet> wallets;
+    wallets.reserve(mnemonics.size());
+    constexpr size_t lanes = 4;
+    uint8_t seeds[lanes][seedSize];
+    std::array<byte, seedSize> seed;
+    for (size_t first = 0; first < phrases.size(); first += lanes) {
+        const auto count = std::min(lanes, phrases.size() - first);
+        // unused lanes of the last group repeat its first mnemonic
+        const char* mnemonicLanes[lanes];
+        const char* passphraseLanes[lanes];
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            mnemonicLanes[lane] = phrases[first + (lane < count ? lane : 0)].c_str();
+            passphraseLanes[lane] = passphrase.c_str();
+        }
+        mnemonic_to_seed_x4(mnemonicLanes, passphraseLanes, seeds);
+        for (size_t lane = 0; lane < count; ++lane) {
+            std::copy(seeds[lane], seeds[lane] + seedSize, seed.begin());
+            wallets.push_back(HDWallet(phrases[first + lane], passphrase, seed, check));
+        }
+    }
+    memzero(seeds, sizeof(seeds));
+    memzero(seed.data(), seed.size());
+    for (auto& phrase : phrases) {
+        std::fill(phrase.begin(), phrase.end(), 0);
+    }
+    return wallets;
+}
+
 HDWallet::~HDWallet() {
     std::fill(seed.begin(), seed.end(), 0);
     std::fill(mnemonic.begin(), mnemonic.end(), 0);
@@ -79,15 +214,28 @@ HDWallet::~HDWallet() {
 }
 
 void HDWallet::updateSeedAndEntropy(bool check) {
-    assert(!check || Mnemonic::isValid(mnemonic)); // precondition
+    assert(!check || Mnemonic::detectLanguage(mnemonic)); // precondition
+
+    nodeCache = std::make_shared<HDNodeCache>();
 
     // generate seed from mnemonic
     mnemonic_to_seed(mnemonic.c_str(), passphrase.c_str(), seed.data(), nullptr);
 
+    updateEntropy(check);
+}
+
+void HDWallet::updateEntropy(bool check) {
     // generate entropy bits from mnemonic
     Data entropyRaw((Mnemonic::MaxWords * Mnemonic::BitsPerWord) / 8);
     // entropy is truncated to fully bytes, 4 bytes for each 3 words (=33 bits)
-    auto entropyBytes = mnemonic_to_bits(mnemonic.c_str(), entropyRaw.data()) / 33 * 4;
+    auto bits = mnemonic_to_bits(mnemonic.c_str(), entropyRaw.data());
+    if (bits == 0) {
+        // not English, try the other wordlists
+        if (const auto language = Mnemonic::detectLanguage(mnemonic)) {
+            bits = Mnemonic::toBits(mnemonic, *language, entropyRaw.data());
+        }
+    }
+    auto entropyBytes = bits / 33 * 4;
     // copy to truncate
     entropy = data(entropyRaw.data(), entropyBytes);
     assert(!check || entropy.size() > 10);
@@ -95,14 +243,12 @@ void HDWallet::updateSeedAndEntropy(bool check) {
 
 PrivateKey HDWallet::getMasterKey(TWCurve curve) const {
     auto node = getMasterNode(*this, curve);
-    auto data = Data(node.private_key, node.private_key + PrivateKey::size);
-    return PrivateKey(data);
+    return PrivateKey(node.private_key, PrivateKey::size);
 }
 
 PrivateKey HDWallet::getMasterKeyExtension(TWCurve curve) const {
     auto node = getMasterNode(*this, curve);
-    auto data = Data(node.private_key_extension, node.private_key_extension + PrivateKey::size);
-    return PrivateKey(data);
+    return PrivateKey(node.private_key_extension, PrivateKey::size);
 }
 
 PrivateKey HDWallet::getKey(TWCoinType coin, TWDerivation derivation) const {
@@ -130,24 +276,17 @@ PrivateKey HDWallet::getKey(TWCoinType coin, const DerivationPath& derivationPat
                 }
                 const DerivationPath stakingPath = cardanoStakingDerivationPath(derivationPath);
 
-                auto pkData = Data(node.private_key, node.private_key + PrivateKey::size);
-                auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::size);
-                auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::size);
-
                 // repeat with staking path
                 const auto node2 = getNode(*this, curve, stakingPath);
-                auto pkData2 = Data(node2.private_key, node2.private_key + PrivateKey::size);
-                auto extData2 = Data(node2.private_key_extension, node2.private_key_extension + PrivateKey::size);
-                auto chainCode2 = Data(node2.chain_code, node2.chain_code + PrivateKey::size);
-
-                return PrivateKey(pkData, extData, chainCode, pkData2, extData2, chainCode2);
+                return PrivateKey(
+                    DataView(node.private_key, PrivateKey::size), DataView(node.private_key_extension, PrivateKey::size), DataView(node.chain_code, PrivateKey::size),
+                    DataView(node2.private_key, PrivateKey::size), DataView(node2.private_key_extension, PrivateKey::size), DataView(node2.chain_code, PrivateKey::size));
             }
 
         case PrivateKeyTypeDefault32:
         default:
             // default path
-            auto data = Data(node.private_key, node.private_key + PrivateKey::size);
-            return PrivateKey(data);
+            return PrivateKey(node.private_key, PrivateKey::size);
     }
 }
 
@@ -166,6 +305,56 @@ std::string HDWallet::deriveAddress(TWCoinType coin, TWDerivation derivation) co
     return TW::deriveAddress(coin, getKey(coin, derivationPath), derivation);
 }
 
+std::vector<std::string> HDWallet::deriveAddresses(TWCoinType coin, TWDerivation derivation, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count, size_t threads) const {
+    auto path = TW::derivationPath(coin, derivation);
+    if (path.indices.size() != 5 || uint64_t(firstIndex) + count > 0x80000000) {
+        return {};
+    }
+    // keep the hardened flags of the coin's path
+    path.indices[2].value = account;
+    path.indices[3].value = change;
+
+    const auto curve = TWCoinTypeCurve(coin);
+    const auto keyType = TW::publicKeyType(coin);
+    std::vector<std::string> addresses(count);
+    if (getPrivateKeyType(curve) == PrivateKeyTypeDoubleExtended) {
+        // Cardano keys combine two derivation paths, derive them one by one
+        forEachChunk(count, threads, [&](uint32_t begin, uint32_t end) {
+            auto addressPath = path;
+            std::vector<PublicKey> publicKeys;
+            publicKeys.reserve(end - begin);
+            for (auto i = begin; i < end; ++i) {
+                addressPath.indices[4].value = firstIndex + i;
+                publicKeys.push_back(getKey(coin, addressPath).getPublicKey(keyType));
+            }
+            moveAddresses(TW::deriveAddresses(coin, publicKeys, derivation), addresses, begin);
+        });
+        return addresses;
+    }
+
+    const auto addressHardened = path.indices[4].hardened;
+    path.indices.pop_back();
+    auto parent = getNode(*this, curve, path);
+    forEachChunk(count, threads, [&](uint32_t begin, uint32_t end) {
+        auto node = HDNode();
+        std::vector<PublicKey> publicKeys;
+        publicKeys.reserve(end - begin);
+        for (auto i = begin; i < end; ++i) {
+            node = parent;
+            hdnode_private_ckd(&node, DerivationPathIndex(firstIndex + i, addressHardened).derivationIndex());
+            auto publicKey = publicKeyFromNode(&node, coin, curve);
+            if (!publicKey.has_value()) {
+                publicKey = PrivateKey(node.private_key, PrivateKey::size).getPublicKey(keyType);
+            }
+            publicKeys.push_back(std::move(publicKey.value()));
+        }
+        memzero(&node, sizeof(HDNode));
+        moveAddresses(TW::deriveAddresses(coin, publicKeys, derivation), addresses, begin);
+    });
+    memzero(&parent, sizeof(HDNode));
+    return addresses;
+}
+
 std::string HDWallet::getExtendedPrivateKeyAccount(TWPurpose purpose, TWCoinType coin, TWDerivation derivation, TWHDVersion version, uint32_t account) const {
     if (version == TWHDVersionNone) {
         return "";
@@ -208,27 +397,45 @@ std::optional<PublicKey> HDWallet::getPublicKeyFromExtended(const std::string& e
     }
     hdnode_public_ckd(&node, path.change());
     hdnode_public_ckd(&node, path.address());
-    hdnode_fill_public_key(&node);
+    return publicKeyFromNode(&node, coin, curve);
+}
 
-    // These public key type are not applicable.  Handled above, as node.curve->params is null
-    assert(curve != TWCurveED25519 && curve != TWCurveED25519Blake2bNano && curve != TWCurveED25519Extended && curve != TWCurveCurve25519);
-    TWPublicKeyType keyType = TW::publicKeyType(coin);
-    if (curve == TWCurveSECP256k1) {
-        auto pubkey = PublicKey(Data(node.public_key, node.public_key + 33), TWPublicKeyTypeSECP256k1);
-        if (keyType == TWPublicKeyTypeSECP256k1Extended) {
-            return pubkey.extended();
-        } else {
-            return pubkey;
-        }
-    } else if (curve == TWCurveNIST256p1) {
-        auto pubkey = PublicKey(Data(node.public_key, node.public_key + 33), TWPublicKeyTypeNIST256p1);
-        if (keyType == TWPublicKeyTypeNIST256p1Extended) {
-            return pubkey.extended();
-        } else {
-            return pubkey;
+std::vector<std::string> HDWallet::deriveAddressesFromExtended(const std::string& extended, TWCoinType coin, TWDerivation derivation, uint32_t change, uint32_t firstIndex, uint32_t count, size_t threads) {
+    const auto curve = TW::curve(coin);
+    const auto hasher = TW::base58Hasher(coin);
+
+    auto parent = HDNode{};
+    if (!deserialize(extended, curve, hasher, &parent)) {
+        return {};
+    }
+    if (parent.curve->params == nullptr || uint64_t(firstIndex) + count > 0x80000000) {
+        return {};
+    }
+    // derive the change node once, then one public CKD per address
+    if (hdnode_public_ckd(&parent, change) != 1) {
+        return {};
+    }
+    std::vector<std::string> addresses(count);
+    std::atomic<bool> failed = false;
+    forEachChunk(count, threads, [&](uint32_t begin, uint32_t end) {
+        auto node = HDNode();
+        std::vector<PublicKey> publicKeys;
+        publicKeys.reserve(end - begin);
+        for (auto i = begin; i < end && !failed; ++i) {
+            node = parent;
+            auto publicKey = hdnode_public_ckd(&node, firstIndex + i) == 1 ? publicKeyFromNode(&node, coin, curve) : std::nullopt;
+            if (!publicKey.has_value()) {
+                failed = true;
+                return;
+            }
+            publicKeys.push_back(std::move(publicKey.value()));
         }
+        moveAddresses(TW::deriveAddresses(coin, publicKeys, derivation), addresses, begin);
+    });
+    if (failed) {
+        return {};
     }
-    return {};
+    return addresses;
 }
 
 std::optional<PrivateKey> HDWallet::getPrivateKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path) {
@@ -242,7 +449,7 @@ std::optional<PrivateKey> HDWallet::getPrivateKeyFromExtended(const std::string&
     hdnode_private_ckd(&node, path.change());
     hdnode_private_ckd(&node, path.address());
 
-    return PrivateKey(Data(node.private_key, node.private_key + 32));
+    return PrivateKey(node.private_key, PrivateKey::size);
 }
 
 HDWallet::PrivateKeyType HDWallet::getPrivateKeyType(TWCurve curve) {
@@ -316,17 +523,38 @@ bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher
 
 HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& derivationPath) {
     const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
-    auto node = getMasterNode(wallet, curve);
-    for (auto& index : derivationPath.indices) {
+    std::array<uint32_t, DerivationPathIndices::maxDepth> path;
+    const auto size = derivationPath.indices.size();
+    std::transform(derivationPath.indices.begin(), derivationPath.indices.end(), path.begin(),
+                   [](const auto& index) { return index.derivationIndex(); });
+
+    // Start from the deepest cached ancestor; only intermediate nodes are cached, not the requested one
+    auto* cache = HDNodeCache::of(wallet);
+    auto node = HDNode();
+    size_t depth = 0;
+    if (const auto cached = cache != nullptr ? cache->findLongestPrefix(curve, path.data(), size, size == 0 ? 0 : size - 1, node) : std::nullopt;
+        cached.has_value()) {
+        depth = cached.value();
+    } else {
+        node = getMasterNode(wallet, curve);
+        if (cache != nullptr) {
+            cache->insert(curve, path.data(), 0, node);
+        }
+    }
+
+    for (; depth < size; ++depth) {
         switch (privateKeyType) {
             case HDWallet::PrivateKeyTypeDoubleExtended: // used by Cardano, special handling
-                hdnode_private_ckd_cardano(&node, index.derivationIndex());
+                hdnode_private_ckd_cardano(&node, path[depth]);
                 break;
            case HDWallet::PrivateKeyTypeDefault32:
             default:
-                hdnode_private_ckd(&node, index.derivationIndex());
+                hdnode_private_ckd(&node, path[depth]);
                 break;
         }
+        if (cache != nullptr && depth + 1 < size) {
+            cache->insert(curve, path.data(), depth + 1, node);
+        }
     }
     return node;
 }
@@ -348,6 +576,73 @@ HDNode getMasterNode(const HDWallet& wallet, TWCurve curve) {
     return node;
 }
 
+std::optional<PublicKey> publicKeyFromNode(HDNode* node, TWCoinType coin, TWCurve curve) {
+    // Other public key types are not derived here, callers fall back to PrivateKey::getPublicKey or fail
+    TWPublicKeyType keyType = TW::publicKeyType(coin);
+    if (curve == TWCurveED25519 && keyType == TWPublicKeyTypeED25519) {
+        hdnode_fill_public_key(node);
+        // public_key is prefixed with a 0x01 byte
+        return PublicKey(node->public_key + 1, PublicKey::ed25519Size, TWPublicKeyTypeED25519);
+    }
+    if (curve != TWCurveSECP256k1 && curve != TWCurveNIST256p1) {
+        return {};
+    }
+    hdnode_fill_public_key(node);
+    if (curve == TWCurveSECP256k1) {
+        auto pubkey = PublicKey(node->public_key, PublicKey::secp256k1Size, TWPublicKeyTypeSECP256k1);
+        if (keyType == TWPublicKeyTypeSECP256k1Extended) {
+            return pubkey.extended();
+        } else {
+            return pubkey;
+        }
+    } else if (curve == TWCurveNIST256p1) {
+        auto pubkey = PublicKey(node->public_key, PublicKey::secp256k1Size, TWPublicKeyTypeNIST256p1);
+        if (keyType == TWPublicKeyTypeNIST256p1Extended) {
+            return pubkey.extended();
+        } else {
+            return pubkey;
+        }
+    }
+    return {};
+}
+
+template <typename Worker>
+void forEachChunk(uint32_t count, size_t threads, const Worker& worker) {
+    threads = std::max<size_t>(1, std::min<size_t>(threads, count));
+    if (threads == 1) {
+        worker(0, count);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    std::vector<std::exception_ptr> errors(threads);
+    pool.reserve(threads);
+    uint32_t begin = 0;
+    for (size_t t = 0; t < threads; ++t) {
+        const uint32_t end = begin + static_cast<uint32_t>(count / threads + (t < count % threads ? 1 : 0));
+        pool.emplace_back([&worker, &errors, t, begin, end] {
+            try {
+                worker(begin, end);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+        begin = end;
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void moveAddresses(std::vector<std::string>&& chunk, std::vector<std::string>& addresses, uint32_t begin) {
+    std::move(chunk.begin(), chunk.end(), addresses.begin() + begin);
+}
+
 const char* curveName(TWCurve curve) {
     switch (curve) {
     case TWCurveSECP256k1:
@@ -19,11 +19,15 @@
 #include <TrustWalletCore/TWDerivation.h>
 
 #include <array>
+#include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace TW {
 
+class HDNodeCache;
+
 class HDWallet {
   public:
     static constexpr size_t seedSize = 64;
@@ -43,6 +47,11 @@ class HDWallet {
     /// Entropy is the binary 1-to-1 representation of the mnemonic (11 bits from each word)
     TW::Data entropy;
 
+    /// Cache of derived intermediate nodes (thread-safe); shared by copies, as they have the same seed
+    std::shared_ptr<HDNodeCache> nodeCache;
+
+    friend class HDNodeCache;
+
   public:
     const std::array<byte, seedSize>& getSeed() const { return seed; }
     const std::string& getMnemonic() const { return mnemonic; }
@@ -54,7 +63,8 @@ class HDWallet {
     /// Throws on invalid strength.
     HDWallet(int strength, const std::string& passphrase);
 
-    /// Initializes an HDWallet from a BIP39 mnemonic and a passphrase, check English dict by default.
+    /// Initializes an HDWallet from a BIP39 mnemonic and a passphrase, check against the compiled-in wordlists by default.
+    /// A checked mnemonic is kept and seeded in its NFKD form, as BIP39 specifies; the passphrase is used as given.
     /// Throws on invalid mnemonic.
     HDWallet(const std::string& mnemonic, const std::string& passphrase, const bool check = true);
 
@@ -62,6 +72,10 @@ class HDWallet {
     /// Throws on invalid data.
     HDWallet(const Data& entropy, const std::string& passphrase);
 
+    /// Initializes HDWallets from BIP39 mnemonics sharing a passphrase, with the seeds computed 4 at a time.
+    /// Throws on an invalid mnemonic.
+    static std::vector<HDWallet> fromMnemonics(const std::vector<std::string>& mnemonics, const std::string& passphrase, bool check = true);
+
     HDWallet(const HDWallet& other) = default;
     HDWallet(HDWallet&& other) = default;
     HDWallet& operator=(const HDWallet& other) = default;
@@ -87,6 +101,11 @@ class HDWallet {
     /// Derives the address for a coin with given derivation.
     std::string deriveAddress(TWCoinType coin, TWDerivation derivation) const;
 
+    /// Derives the addresses at indices firstIndex..firstIndex+count-1 of an account/change branch, for a coin with given derivation.
+    /// The branch node is derived once, the index range is split across up to `threads` workers; the output order does not depend on it.
+    /// Returns an empty list if the derivation path has no account/change/address levels.
+    std::vector<std::string> deriveAddresses(TWCoinType coin, TWDerivation derivation, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count, size_t threads = 1) const;
+
     /// Returns the extended private key for default 0 account with the given derivation.
     std::string getExtendedPrivateKeyDerivation(TWPurpose purpose, TWCoinType coin, TWDerivation derivation, TWHDVersion version) const {
         return getExtendedPrivateKeyAccount(purpose, coin, derivation, version, 0);
@@ -119,6 +138,10 @@ class HDWallet {
     /// Computes the public key from an extended public key representation.
     static std::optional<PublicKey> getPublicKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path);
 
+    /// Derives the addresses at indices firstIndex..firstIndex+count-1 of a change branch from an extended public key representation,
+    /// using up to `threads` workers.  Returns an empty list on invalid input.
+    static std::vector<std::string> deriveAddressesFromExtended(const std::string& extended, TWCoinType coin, TWDerivation derivation, uint32_t change, uint32_t firstIndex, uint32_t count, size_t threads = 1);
+
     /// Computes the private key from an extended private key representation.
     static std::optional<PrivateKey> getPrivateKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path);
 
@@ -133,7 +156,11 @@ class HDWallet {
     static PrivateKeyType getPrivateKeyType(TWCurve curve);
 
   private:
+    /// Initializes an HDWallet from a mnemonic and its precomputed seed.
+    HDWallet(const std::string& mnemonic, const std::string& passphrase, const std::array<byte, seedSize>& seed, bool check);
+
     void updateSeedAndEntropy(bool check = true);
+    void updateEntropy(bool check);
 
     // For Cardano, derive 2nd, staking derivation path from the primary one
     static DerivationPath cardanoStakingDerivationPath(const DerivationPath& path);
@@ -15,10 +15,122 @@
 #include <TrezorCrypto/sha3.h>
 #include <TrezorCrypto/hmac.h>
 
+#include <algorithm>
 #include <string>
 
 using namespace TW;
 
+namespace {
+
+/// State of the hash function underlying a Hash::Context; composite hashers keep the state of the inner hash.
+union ContextState {
+    SHA1_CTX sha1;
+    SHA256_CTX sha256;
+    SHA512_CTX sha512;
+    SHA3_CTX sha3;
+    RIPEMD160_CTX ripemd;
+    BLAKE256_CTX blake256;
+    GROESTL512_CTX groestl512;
+};
+
+static_assert(sizeof(ContextState) == Hash::Context::stateSize,
+              "Hash::Context::stateSize must match the largest hash context");
+
+ContextState& contextState(std::array<byte, Hash::Context::stateSize>& storage) {
+    static_assert(alignof(ContextState) <= 8, "Hash::Context state is under-aligned");
+    return *reinterpret_cast<ContextState*>(storage.data());
+}
+
+} // namespace
+
+Hash::Context::Context(Hasher hasher) : type(hasher) {
+    reset();
+}
+
+void Hash::Context::reset() {
+    auto& ctx = contextState(state);
+    switch (type) {
+    case HasherSha1: sha1_Init(&ctx.sha1); break;
+    case HasherSha512: sha512_Init(&ctx.sha512); break;
+    case HasherSha512_256: sha512_256_Init(&ctx.sha512); break;
+    case HasherKeccak256: keccak_256_Init(&ctx.sha3); break;
+    case HasherKeccak512: keccak_512_Init(&ctx.sha3); break;
+    case HasherSha3_256: case HasherSha3_256ripemd: sha3_256_Init(&ctx.sha3); break;
+    case HasherSha3_512: sha3_512_Init(&ctx.sha3); break;
+    case HasherRipemd: ripemd160_Init(&ctx.ripemd); break;
+    case HasherBlake256: case HasherBlake256d: case HasherBlake256ripemd: blake256_Init(&ctx.blake256); break;
+    case HasherGroestl512: case HasherGroestl512d: groestl512_Init(&ctx.groestl512); break;
+    default: case HasherSha256: case HasherSha256d: case HasherSha256ripemd: sha256_Init(&ctx.sha256); break;
+    }
+}
+
+Hash::Context& Hash::Context::update(const byte* data, size_t size) {
+    auto& ctx = contextState(state);
+    switch (type) {
+    case HasherSha1: sha1_Update(&ctx.sha1, data, size); break;
+    case HasherSha512: case HasherSha512_256: sha512_Update(&ctx.sha512, data, size); break;
+    case HasherKeccak256: case HasherKeccak512:
+    case HasherSha3_256: case HasherSha3_512: case HasherSha3_256ripemd: sha3_Update(&ctx.sha3, data, size); break;
+    case HasherRipemd: ripemd160_Update(&ctx.ripemd, data, static_cast<uint32_t>(size)); break;
+    case HasherBlake256: case HasherBlake256d: case HasherBlake256ripemd: blake256_Update(&ctx.blake256, data, size); break;
+    case HasherGroestl512: case HasherGroestl512d: groestl512_Update(&ctx.groestl512, data, size); break;
+    default: case HasherSha256: case HasherSha256d: case HasherSha256ripemd: sha256_Update(&ctx.sha256, data, size); break;
+    }
+    return *this;
+}
+
+void Hash::Context::final(byte* out) {
+    auto& ctx = contextState(state);
+    Digest<maxDigestSize> inner;
+    switch (type) {
+    case HasherSha1: sha1_Final(&ctx.sha1, out); break;
+    case HasherSha512: sha512_Final(&ctx.sha512, out); break;
+    case HasherSha512_256:
+        sha512_Final(&ctx.sha512, inner.data());
+        std::copy(inner.begin(), inner.begin() + sha256Size, out);
+        break;
+    case HasherKeccak256: case HasherKeccak512: keccak_Final(&ctx.sha3, out); break;
+    case HasherSha3_256: case HasherSha3_512: sha3_Final(&ctx.sha3, out); break;
+    case HasherSha3_256ripemd:
+        sha3_Final(&ctx.sha3, inner.data());
+        ::ripemd160(inner.data(), sha256Size, out);
+        break;
+    case HasherRipemd: ripemd160_Final(&ctx.ripemd, out); break;
+    case HasherBlake256: blake256_Final(&ctx.blake256, out); break;
+    case HasherBlake256d:
+        blake256_Final(&ctx.blake256, inner.data());
+        ::blake256(inner.data(), sha256Size, out);
+        break;
+    case HasherBlake256ripemd:
+        blake256_Final(&ctx.blake256, inner.data());
+        ::ripemd160(inner.data(), sha256Size, out);
+        break;
+    case HasherGroestl512: groestl512_Final(&ctx.groestl512, out); break;
+    case HasherGroestl512d:
+        groestl512_Final(&ctx.groestl512, inner.data());
+        groestl512_Init(&ctx.groestl512);
+        groestl512_Update(&ctx.groestl512, inner.data(), sha512Size);
+        groestl512_Final(&ctx.groestl512, out);
+        break;
+    case HasherSha256d:
+        sha256_Final(&ctx.sha256, inner.data());
+        sha256_Raw(inner.data(), sha256Size, out);
+        break;
+    case HasherSha256ripemd:
+        sha256_Final(&ctx.sha256, inner.data());
+        ::ripemd160(inner.data(), sha256Size, out);
+        break;
+    default: case HasherSha256: sha256_Final(&ctx.sha256, out); break;
+    }
+    reset();
+}
+
+Data Hash::Context::final() {
+    Data result(size());
+    final(result.data());
+    return result;
+}
+
 TW::Hash::HasherSimpleType Hash::functionPointerFromEnum(TW::Hash::Hasher hasher) {
     switch (hasher) {
         case Hash::HasherSha1: return Hash::sha1;
@@ -71,6 +183,23 @@ Data Hash::keccak256(const byte* data, size_t size) {
     return result;
 }
 
+std::vector<Hash::Digest<Hash::sha256Size>> Hash::keccak256(const std::vector<const byte*>& messages, size_t size) {
+    constexpr size_t lanes = 4;
+    std::vector<Digest<sha256Size>> result(messages.size());
+    size_t i = 0;
+    for (; i + lanes <= messages.size(); i += lanes) {
+        byte digests[lanes][SHA3_256_DIGEST_LENGTH];
+        keccak_256_x4(&messages[i], size, digests);
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            std::copy(std::begin(digests[lane]), std::end(digests[lane]), result[i + lane].begin());
+        }
+    }
+    for (; i < messages.size(); ++i) {
+        keccak_256(messages[i], size, result[i].data());
+    }
+    return result;
+}
+
 Data Hash::keccak512(const byte* data, size_t size) {
     Data result(sha512Size);
     keccak_512(data, size, result.data());
@@ -122,6 +251,89 @@ Data Hash::groestl512(const byte* data, size_t size) {
     return result;
 }
 
+Data Hash::sha256d(const byte* data, size_t size) {
+    return hash(HasherSha256d, data, size);
+}
+
+Data Hash::sha256ripemd(const byte* data, size_t size) {
+    return hash(HasherSha256ripemd, data, size);
+}
+
+namespace {
+
+/// Number of messages hashed together by sha256_Raw_x8
+constexpr size_t sha256Lanes = 8;
+
+/// Writes the ripemd hashes of the SHA256 hashes of `sha256Lanes` messages of `size` bytes each to `out`.
+void sha256ripemdLanes(const byte* const* messages, size_t size, Hash::Digest<Hash::ripemdSize>* out) {
+    byte digests[sha256Lanes][SHA256_DIGEST_LENGTH];
+    sha256_Raw_x8(messages, size, digests);
+    for (size_t i = 0; i < sha256Lanes; ++i) {
+        ripemd160(digests[i], SHA256_DIGEST_LENGTH, out[i].data());
+    }
+}
+
+void sha256ripemd(const byte* data, size_t size, Hash::Digest<Hash::ripemdSize>& out) {
+    byte digest[SHA256_DIGEST_LENGTH];
+    sha256_Raw(data, size, digest);
+    ripemd160(digest, SHA256_DIGEST_LENGTH, out.data());
+}
+
+} // namespace
+
+std::vector<Hash::Digest<Hash::ripemdSize>> Hash::sha256ripemd(const std::vector<const byte*>& messages, size_t size) {
+    std::vector<Digest<ripemdSize>> result(messages.size());
+    size_t i = 0;
+    for (; i + sha256Lanes <= messages.size(); i += sha256Lanes) {
+        sha256ripemdLanes(&messages[i], size, &result[i]);
+    }
+    for (; i < messages.size(); ++i) {
+        ::sha256ripemd(messages[i], size, result[i]);
+    }
+    return result;
+}
+
+std::vector<Hash::Digest<Hash::ripemdSize>> Hash::sha256ripemd(const std::vector<Data>& messages) {
+    std::vector<Digest<ripemdSize>> result(messages.size());
+    size_t i = 0;
+    while (i < messages.size()) {
+        const auto size = messages[i].size();
+        size_t end = i + 1;
+        while (end < messages.size() && end - i < sha256Lanes && messages[end].size() == size) {
+            ++end;
+        }
+        if (end - i == sha256Lanes) {
+            const byte* lanes[sha256Lanes];
+            for (size_t lane = 0; lane < sha256Lanes; ++lane) {
+                lanes[lane] = messages[i + lane].data();
+            }
+            sha256ripemdLanes(lanes, size, &result[i]);
+        } else {
+            for (; i < end; ++i) {
+                ::sha256ripemd(messages[i].data(), size, result[i]);
+            }
+        }
+        i = end;
+    }
+    return result;
+}
+
+Data Hash::sha3_256ripemd(const byte* data, size_t size) {
+    return hash(HasherSha3_256ripemd, data, size);
+}
+
+Data Hash::blake256d(const byte* data, size_t size) {
+    return hash(HasherBlake256d, data, size);
+}
+
+Data Hash::blake256ripemd(const byte* data, size_t size) {
+    return hash(HasherBlake256ripemd, data, size);
+}
+
+Data Hash::groestl512d(const byte* data, size_t size) {
+    return hash(HasherGroestl512d, data, size);
+}
+
 Data Hash::hmac256(const Data& key, const Data& message) {
     Data hmac(SHA256_DIGEST_LENGTH);
     hmac_sha256(key.data(), static_cast<uint32_t>(key.size()), message.data(), static_cast<uint32_t>(message.size()), hmac.data());
@@ -8,7 +8,9 @@
 
 #include "Data.h"
 
+#include <array>
 #include <functional>
+#include <vector>
 
 namespace TW::Hash {
 
@@ -52,6 +54,85 @@ static const size_t sha512Size = 64;
 /// Number of bytes in a RIPEMD160 hash.
 static const size_t ripemdSize = 20;
 
+/// Number of bytes in the largest digest of the supported hash functions.
+static const size_t maxDigestSize = sha512Size;
+
+/// Fixed-size hash digest, which does not need a heap allocation.
+template <size_t N>
+using Digest = std::array<byte, N>;
+
+/// Number of bytes in the digest of a hash function.
+constexpr size_t digestSize(Hasher hasher) {
+    switch (hasher) {
+    case HasherSha1:
+    case HasherRipemd:
+    case HasherSha256ripemd:
+    case HasherSha3_256ripemd:
+    case HasherBlake256ripemd:
+        return ripemdSize;
+    case HasherSha512:
+    case HasherKeccak512:
+    case HasherSha3_512:
+    case HasherGroestl512:
+    case HasherGroestl512d:
+        return sha512Size;
+    default:
+        return sha256Size;
+    }
+}
+
+/// Incremental hasher for any of the supported hash functions, keeping its state inline.
+/// Data is fed with update(); final() writes the digest to caller-provided memory and resets
+/// the context, so the same context can be reused for the next message.
+class Context {
+public:
+    explicit Context(Hasher hasher);
+
+    Hasher hasher() const { return type; }
+
+    /// Number of bytes written by final().
+    size_t size() const { return digestSize(type); }
+
+    /// Discards any data fed so far.
+    void reset();
+
+    Context& update(const byte* data, size_t size);
+
+    template <typename T>
+    Context& update(const T& data) {
+        return update(reinterpret_cast<const byte*>(data.data()), data.size());
+    }
+
+    /// Writes the digest to `out`, which must hold size() bytes, and resets the context.
+    void final(byte* out);
+
+    /// Returns the digest and resets the context.
+    Data final();
+
+    /// Bytes of inline state: the size of SHA3_CTX, the largest underlying context (checked in Hash.cpp).
+    static constexpr size_t stateSize = 400;
+
+private:
+    Hasher type;
+
+    /// State of the underlying hash function.
+    alignas(8) std::array<byte, stateSize> state;
+};
+
+/// Computes requested hash into a fixed-size array, without heap allocation.
+template <Hasher hasher>
+Digest<digestSize(hasher)> digest(const byte* data, size_t size) {
+    Digest<digestSize(hasher)> result;
+    Context(hasher).update(data, size).final(result.data());
+    return result;
+}
+
+/// Computes requested hash into a fixed-size array, without heap allocation.
+template <Hasher hasher, typename T>
+Digest<digestSize(hasher)> digest(const T& data) {
+    return digest<hasher>(reinterpret_cast<const byte*>(data.data()), data.size());
+}
+
 /// Computes the SHA1 hash.
 Data sha1(const byte* data, size_t size);
 
@@ -67,6 +148,9 @@ Data sha512_256(const byte* data, size_t size);
 /// Computes the Keccak SHA256 hash.
 Data keccak256(const byte* data, size_t size);
 
+/// Computes the Keccak SHA256 hashes of many messages of `size` bytes each, 4 at a time.
+std::vector<Digest<sha256Size>> keccak256(const std::vector<const byte*>& messages, size_t size);
+
 /// Computes the Keccak SHA512 hash.
 Data keccak512(const byte* data, size_t size);
 
@@ -92,15 +176,13 @@ Data groestl512(const byte* data, size_t size);
 
 /// Computes requested hash for data (hasher enum, bytes)
 inline Data hash(Hasher hasher, const byte* data, size_t dataSize) {
-    const auto func = functionPointerFromEnum(hasher);
-    return func(data, dataSize);
+    return Context(hasher).update(data, dataSize).final();
 }
 
 /// Computes requested hash for data (hasher enum)
 template <typename T>
 Data hash(Hasher hasher, const T& data) {
-    const auto func = functionPointerFromEnum(hasher);
-    return func(reinterpret_cast<const byte*>(data.data()), data.size());
+    return hash(hasher, reinterpret_cast<const byte*>(data.data()), data.size());
 }
 
 // Templated versions for any type with data() and size()
@@ -183,34 +265,30 @@ Data groestl512(const T& data) {
 }
 
 /// Computes the SHA256 hash of the SHA256 hash.
-inline Data sha256d(const byte* data, size_t size) {
-    return sha256(sha256(data, size));
-}
+Data sha256d(const byte* data, size_t size);
 
 /// Computes the ripemd hash of the SHA256 hash.
-inline Data sha256ripemd(const byte* data, size_t size) {
-    return ripemd(sha256(data, size));
-}
+Data sha256ripemd(const byte* data, size_t size);
+
+/// Computes the ripemd hashes of the SHA256 hashes of many messages of `size` bytes each,
+/// with the SHA256 hashes computed 8 at a time by the multi-buffer implementation.
+std::vector<Digest<ripemdSize>> sha256ripemd(const std::vector<const byte*>& messages, size_t size);
+
+/// Computes the ripemd hashes of the SHA256 hashes of many messages; runs of messages of equal size
+/// are hashed 8 at a time, e.g. public keys.
+std::vector<Digest<ripemdSize>> sha256ripemd(const std::vector<Data>& messages);
 
 /// Computes the ripemd hash of the SHA256 hash.
-inline Data sha3_256ripemd(const byte* data, size_t size) {
-    return ripemd(sha3_256(data, size));
-}
+Data sha3_256ripemd(const byte* data, size_t size);
 
 /// Computes the Blake256 hash of the Blake256 hash.
-inline Data blake256d(const byte* data, size_t size) {
-    return blake256(blake256(data, size));
-}
+Data blake256d(const byte* data, size_t size);
 
 /// Computes the ripemd hash of the Blake256 hash.
-inline Data blake256ripemd(const byte* data, size_t size) {
-    return ripemd(blake256(data, size));
-}
+Data blake256ripemd(const byte* data, size_t size);
 
 /// Computes the Groestl512 hash of the Groestl512 hash.
-inline Data groestl512d(const byte* data, size_t size) {
-    return groestl512(groestl512(data, size));
-}
+Data groestl512d(const byte* data, size_t size);
 
 /// Compute the SHA256-based HMAC of a message
 Data hmac256(const Data& key, const Data& message);
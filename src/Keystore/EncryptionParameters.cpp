@@ -14,7 +14,12 @@
 #include <TrezorCrypto/scrypt.h>
 
 #include <boost/variant/get.hpp>
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 using namespace TW;
 using namespace TW::Keystore;
@@ -28,6 +33,61 @@ static Data computeMAC(Iter begin, Iter end, const Data& key) {
     return Hash::keccak256(data);
 }
 
+/// Runs the scrypt workers on their own threads, the last one on the calling thread.
+static void runScryptWorkers(scrypt_worker_fn work, void* context, uint32_t workers, void* /* runner */) {
+    std::vector<std::thread> pool;
+    uint32_t t = 0;
+    try {
+        pool.reserve(workers - 1);
+        for (; t + 1 < workers; ++t) {
+            pool.emplace_back(work, context, t);
+        }
+    } catch (...) {
+        // the workers not started run on the calling thread
+    }
+    for (; t < workers; ++t) {
+        work(context, t);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+/// Memory the scrypt workers of one key derivation may use together; a single worker may exceed it.
+static const uint64_t scryptMemoryBudget = 512 * 1024 * 1024;
+
+/// Number of scrypt workers: one per lane, at most one per core, and as many as fit the memory budget
+/// with their own 128 * r * n bytes each.
+static uint32_t scryptWorkers(const ScryptParameters& params) {
+    const auto memoryPerWorker = 128 * uint64_t(params.r) * params.n;
+    const auto fitting = std::max<uint64_t>(1, scryptMemoryBudget / std::max<uint64_t>(1, memoryPerWorker));
+    const auto cores = std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<uint32_t>(std::min<uint64_t>({params.p, cores, fitting}));
+}
+
+/// Derives a key with scrypt, with the independent lanes split between threads.
+///
+/// @throws std::system_error if scrypt fails, also when retried with a single worker.
+static Data scryptKey(const Data& password, const ScryptParameters& params, std::size_t keyLength) {
+    auto derivedKey = Data(keyLength);
+    // returns 0 or the errno of the failure, saved before anything else can overwrite it
+    const auto derive = [&](uint32_t workers) {
+        const auto result = scrypt_parallel(password.data(), password.size(), params.salt.data(), params.salt.size(), params.n,
+                                            params.r, params.p, derivedKey.data(), derivedKey.size(), workers, runScryptWorkers, nullptr);
+        return result == 0 ? 0 : errno;
+    };
+    const auto workers = scryptWorkers(params);
+    auto error = derive(workers);
+    // the workers allocate their memory separately, with less memory available one may still work
+    if (error != 0 && workers > 1) {
+        error = derive(1);
+    }
+    if (error != 0) {
+        throw std::system_error(error, std::generic_category(), "scrypt");
+    }
+    return derivedKey;
+}
+
 // -----------------
 // Encoding/Decoding
 // -----------------
@@ -74,10 +134,7 @@ nlohmann::json EncryptionParameters::json() const {
 EncryptedPayload::EncryptedPayload(const Data& password, const Data& data, const EncryptionParameters& params) :
     params(std::move(params)), mac() {
     auto scryptParams = boost::get<ScryptParameters>(params.kdfParams);
-    auto derivedKey = Data(scryptParams.desiredKeyLength);
-    scrypt(reinterpret_cast<const byte*>(password.data()), password.size(), scryptParams.salt.data(),
-           scryptParams.salt.size(), scryptParams.n, scryptParams.r, scryptParams.p, derivedKey.data(),
-           scryptParams.desiredKeyLength);
+    auto derivedKey = scryptKey(password, scryptParams, scryptParams.desiredKeyLength);
 
     aes_encrypt_ctx ctx;
     auto result = aes_encrypt_key128(derivedKey.data(), &ctx);
@@ -102,10 +159,12 @@ Data EncryptedPayload::decrypt(const Data& password) const {
 
     if (params.kdfParams.which() == 0) {
         auto scryptParams = boost::get<ScryptParameters>(params.kdfParams);
-        derivedKey.resize(scryptParams.defaultDesiredKeyLength);
-        scrypt(password.data(), password.size(), scryptParams.salt.data(),
-            scryptParams.salt.size(), scryptParams.n, scryptParams.r, scryptParams.p, derivedKey.data(),
-            scryptParams.defaultDesiredKeyLength);
+        try {
+            derivedKey = scryptKey(password, scryptParams, scryptParams.defaultDesiredKeyLength);
+        } catch (const std::system_error&) {
+            // no key can be derived from these parameters, so no password opens the payload
+            throw DecryptionError::invalidPassword;
+        }
         mac = computeMAC(derivedKey.end() - 16, derivedKey.end(), encrypted);
     } else if (params.kdfParams.which() == 1) {
         auto pbkdf2Params = boost::get<PBKDF2Parameters>(params.kdfParams);
@@ -100,6 +100,8 @@ public:
     EncryptedPayload(const nlohmann::json& json);
 
     /// Decrypts the payload with the given password.
+    /// Throws DecryptionError::invalidPassword if the password does not match, or if scrypt cannot derive a key from
+    /// the stored parameters (for example a cost factor that is not a power of 2).
     Data decrypt(const Data& password) const;
 
     /// Saves `this` as a JSON object.
@@ -29,7 +29,7 @@ using namespace TW;
 using namespace TW::Keystore;
 
 StoredKey StoredKey::createWithMnemonic(const std::string& name, const Data& password, const std::string& mnemonic, TWStoredKeyEncryptionLevel encryptionLevel) {
-    if (!Mnemonic::isValid(mnemonic)) {
+    if (!Mnemonic::detectLanguage(mnemonic)) {
         throw std::invalid_argument("Invalid mnemonic");
     }
 
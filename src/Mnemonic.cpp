@@ -5,9 +5,12 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Mnemonic.h"
+#include "Data.h"
+#include "MnemonicWordlist.h"
 
-#include <TrezorCrypto/bip39_english.h>
 #include <TrezorCrypto/bip39.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/sha2.h>
 
 #include <algorithm>
 #include <string>
@@ -19,24 +22,276 @@ namespace TW {
 
 const int Mnemonic::SuggestMaxCount = 10;
 
+namespace {
+
+// Hangul syllable decomposition, see the Unicode standard, section 3.12
+constexpr char32_t hangulBase = 0xAC00;
+constexpr char32_t hangulCount = 11172;
+constexpr char32_t leadingBase = 0x1100;
+constexpr char32_t vowelBase = 0x1161;
+constexpr char32_t trailingBase = 0x11A7;
+constexpr char32_t trailingCount = 28;
+constexpr char32_t syllablesPerLeading = 21 * trailingCount;
+
+/// Appends the code points of UTF-8 text, returns false if it is malformed (including overlong forms and surrogates).
+bool decodeUtf8(const std::string& text, std::vector<char32_t>& codePoints) {
+    for (size_t i = 0; i < text.size();) {
+        const auto lead = static_cast<uint8_t>(text[i]);
+        size_t length = 1;
+        char32_t codePoint = lead;
+        char32_t minimum = 0;
+        if (lead >= 0x80) {
+            if ((lead & 0xe0) == 0xc0) {
+                length = 2;
+                codePoint = lead & 0x1f;
+                minimum = 0x80;
+            } else if ((lead & 0xf0) == 0xe0) {
+                length = 3;
+                codePoint = lead & 0x0f;
+                minimum = 0x800;
+            } else if ((lead & 0xf8) == 0xf0) {
+                length = 4;
+                codePoint = lead & 0x07;
+                minimum = 0x10000;
+            } else {
+                return false;
+            }
+        }
+        if (text.size() - i < length) {
+            return false;
+        }
+        for (size_t j = 1; j < length; ++j) {
+            const auto next = static_cast<uint8_t>(text[i + j]);
+            if ((next & 0xc0) != 0x80) {
+                return false;
+            }
+            codePoint = (codePoint << 6) | (next & 0x3f);
+        }
+        if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+            return false;
+        }
+        codePoints.push_back(codePoint);
+        i += length;
+    }
+    return true;
+}
+
+void encodeUtf8(char32_t codePoint, std::string& text) {
+    if (codePoint < 0x80) {
+        text += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        text += static_cast<char>(0xc0 | (codePoint >> 6));
+        text += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else if (codePoint < 0x10000) {
+        text += static_cast<char>(0xe0 | (codePoint >> 12));
+        text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        text += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else {
+        text += static_cast<char>(0xf0 | (codePoint >> 18));
+        text += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+        text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        text += static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+}
+
+/// Appends the full NFKD decomposition of a code point.
+void decompose(const UnicodeNormalization& tables, char32_t codePoint, std::vector<char32_t>& decomposed) {
+    if (codePoint >= hangulBase && codePoint < hangulBase + hangulCount) {
+        const auto syllable = codePoint - hangulBase;
+        decomposed.push_back(leadingBase + syllable / syllablesPerLeading);
+        decomposed.push_back(vowelBase + syllable % syllablesPerLeading / trailingCount);
+        if (syllable % trailingCount != 0) {
+            decomposed.push_back(trailingBase + syllable % trailingCount);
+        }
+        return;
+    }
+    const auto* end = tables.decomposable + tables.decomposableCount;
+    const auto* found = std::lower_bound(tables.decomposable, end, codePoint);
+    if (found == end || *found != codePoint) {
+        decomposed.push_back(codePoint);
+        return;
+    }
+    const auto i = found - tables.decomposable;
+    decomposed.insert(decomposed.end(), tables.decompositions + tables.offsets[i], tables.decompositions + tables.offsets[i + 1]);
+}
+
+uint8_t combiningClass(const UnicodeNormalization& tables, char32_t codePoint) {
+    const auto* end = tables.combining + tables.combiningCount;
+    const auto* found = std::lower_bound(tables.combining, end, codePoint);
+    return found == end || *found != codePoint ? 0 : tables.classes[found - tables.combining];
+}
+
+} // namespace
+
 bool Mnemonic::isValid(const std::string& mnemonic) {
-    return mnemonic_check(mnemonic.c_str()) != 0;
+    return detectLanguage(mnemonic).has_value();
 }
 
-inline const char* const* mnemonicWordlist() { return wordlist; }
+std::string Mnemonic::normalize(const std::string& text) {
+    // ASCII text is its own NFKD form
+    if (std::all_of(text.begin(), text.end(), [](char c) { return static_cast<uint8_t>(c) < 0x80; })) {
+        return text;
+    }
+    std::vector<char32_t> codePoints;
+    codePoints.reserve(text.size());
+    if (!decodeUtf8(text, codePoints)) {
+        memzero(codePoints.data(), codePoints.size() * sizeof(char32_t));
+        return text;
+    }
 
-bool Mnemonic::isValidWord(const std::string& word) {
-    const char* wordC = word.c_str();
-    const auto len = word.length();
-    for (const char* const* w = mnemonicWordlist(); *w != nullptr; ++w) {
-        if (strlen(*w) != len) {
+    const auto& tables = unicodeNormalization();
+    std::vector<char32_t> decomposed;
+    decomposed.reserve(codePoints.size() * 3);
+    for (const auto codePoint : codePoints) {
+        decompose(tables, codePoint, decomposed);
+    }
+    // canonical ordering: each run of combining marks is stably sorted by combining class
+    for (size_t start = 0; start < decomposed.size(); ++start) {
+        auto end = start;
+        while (end < decomposed.size() && combiningClass(tables, decomposed[end]) != 0) {
+            ++end;
+        }
+        if (end - start > 1) {
+            std::stable_sort(decomposed.begin() + start, decomposed.begin() + end, [&tables](char32_t lhs, char32_t rhs) {
+                return combiningClass(tables, lhs) < combiningClass(tables, rhs);
+            });
+        }
+        start = end;
+    }
+
+    std::string normalized;
+    normalized.reserve(text.size() * 2);
+    for (const auto codePoint : decomposed) {
+        encodeUtf8(codePoint, normalized);
+    }
+    memzero(codePoints.data(), codePoints.size() * sizeof(char32_t));
+    memzero(decomposed.data(), decomposed.size() * sizeof(char32_t));
+    return normalized;
+}
+
+int MnemonicWordlist::find(const char* word, size_t length) const {
+    if (length == 0) {
+        return -1;
+    }
+    // binary search among the words with the same first byte,
+    // comparing bytes and then lengths like the generator's sort
+    const auto first = static_cast<uint8_t>(word[0]);
+    size_t lo = starts[first];
+    size_t hi = starts[first + 1];
+    while (lo < hi) {
+        const auto mid = lo + (hi - lo) / 2;
+        const auto candidateLength = static_cast<size_t>(offsets[mid + 1] - offsets[mid]);
+        auto cmp = std::memcmp(words + offsets[mid], word, std::min(candidateLength, length));
+        if (cmp == 0) {
+            if (candidateLength == length) {
+                return indices[mid];
+            }
+            cmp = candidateLength < length ? -1 : 1;
+        }
+        if (cmp < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return -1;
+}
+
+int Mnemonic::toBits(const std::string& mnemonic, Language language, uint8_t* bits) {
+    const auto* wordlist = mnemonicWordlist(language);
+    return wordlist == nullptr ? 0 : toBits(normalize(mnemonic), *wordlist, bits);
+}
+
+int Mnemonic::toBits(const std::string& mnemonic, const MnemonicWordlist& wordlist, uint8_t* bits) {
+    std::fill(bits, bits + MaxBitsSize, 0);
+    auto count = 0;
+    auto bit = 0;
+    size_t start = 0;
+    for (;;) {
+        const auto end = std::min(mnemonic.find(' ', start), mnemonic.size());
+        const auto index = count < MaxWords ? wordlist.find(mnemonic.data() + start, end - start) : -1;
+        if (index < 0) {
+            memzero(bits, MaxBitsSize);
+            return 0;
+        }
+        for (auto i = BitsPerWord - 1; i >= 0; --i, ++bit) {
+            if ((index >> i) & 1) {
+                bits[bit / 8] |= 0x80 >> (bit % 8);
+            }
+        }
+        ++count;
+        if (end == mnemonic.size()) {
+            break;
+        }
+        start = end + 1;
+    }
+    // 12, 15, 18, 21 or 24 words
+    if (count < MinWords || count % 3 != 0) {
+        memzero(bits, MaxBitsSize);
+        return 0;
+    }
+    return count * BitsPerWord;
+}
+
+bool Mnemonic::isValid(const std::string& mnemonic, const MnemonicWordlist& wordlist) {
+    byte bits[MaxBitsSize];
+    const auto count = toBits(mnemonic, wordlist, bits) / BitsPerWord;
+    auto valid = count != 0;
+    if (valid) {
+        // the checksum is the first words / 3 bits of the entropy hash
+        const auto entropySize = count * 4 / 3;
+        const auto mask = static_cast<byte>(0xff << (8 - count / 3));
+        byte hash[SHA256_DIGEST_LENGTH];
+        sha256_Raw(bits, entropySize, hash);
+        valid = (hash[0] & mask) == (bits[entropySize] & mask);
+        memzero(hash, sizeof(hash));
+    }
+    memzero(bits, sizeof(bits));
+    return valid;
+}
+
+bool Mnemonic::isValid(const std::string& mnemonic, Language language) {
+    const auto* wordlist = mnemonicWordlist(language);
+    return wordlist != nullptr && isValid(normalize(mnemonic), *wordlist);
+}
+
+std::optional<Mnemonic::Language> Mnemonic::detectLanguage(const std::string& phrase) {
+    const auto mnemonic = normalize(phrase);
+    const auto firstLength = std::min(mnemonic.find(' '), mnemonic.size());
+    for (auto i = 0; i <= static_cast<int>(Language::Portuguese); ++i) {
+        const auto language = static_cast<Language>(i);
+        const auto* wordlist = mnemonicWordlist(language);
+        if (wordlist == nullptr || wordlist->find(mnemonic.data(), firstLength) < 0) {
             continue;
         }
-        if (strncmp(*w, wordC, len) == 0) {
+        if (isValid(mnemonic, *wordlist)) {
+            return language;
+        }
+    }
+    return std::nullopt;
+}
+
+bool Mnemonic::hasWordlist(Language language) {
+    return mnemonicWordlist(language) != nullptr;
+}
+
+int Mnemonic::wordIndex(const std::string& word, Language language) {
+    const auto* wordlist = mnemonicWordlist(language);
+    if (wordlist == nullptr) {
+        return -1;
+    }
+    const auto normalized = normalize(word);
+    return wordlist->find(normalized.data(), normalized.size());
+}
+
+bool Mnemonic::isValidWord(const std::string& word) {
+    const auto normalized = normalize(word);
+    for (auto i = 0; i <= static_cast<int>(Language::Portuguese); ++i) {
+        const auto* wordlist = mnemonicWordlist(static_cast<Language>(i));
+        if (wordlist != nullptr && wordlist->find(normalized.data(), normalized.size()) >= 0) {
             return true;
         }
     }
-    // not found
     return false;
 }
 
@@ -49,29 +304,20 @@ std::string Mnemonic::suggest(const std::string& prefix) {
     std::string prefixLo = prefix;
     std::transform(prefixLo.begin(), prefixLo.end(), prefixLo.begin(),
         [](unsigned char c){ return std::tolower(c); });
-    const char* prefixLoC = prefixLo.c_str();
-
-    std::vector<std::string> result;
-    for (const char* const* word = mnemonicWordlist(); *word != nullptr; ++word) {
-        // check first letter match (optimization)
-        if ((*word)[0] == prefixLo[0]) {
-            if (strncmp(*word, prefixLoC, prefixLo.length()) == 0) {
-                // we have a match
-                result.emplace_back(*word);
-                if (result.size() >= SuggestMaxCount) {
-                    break; // enough results
-                }
-            }
-        }
-    }
+
+    // matching words are adjacent in the sorted wordlist
+    int begin = 0;
+    int end = 0;
+    mnemonic_prefix_range(prefixLo.c_str(), static_cast<int>(prefixLo.length()), &begin, &end);
+    end = std::min(end, begin + SuggestMaxCount);
 
     // convert results to one string
     std::string resultString;
-    for (auto& word: result) {
+    for (auto index = begin; index < end; ++index) {
         if (resultString.length() > 0) {
             resultString += " ";
         }
-        resultString += word;
+        resultString += mnemonic_get_word(index);
     }
     return resultString;
 }
@@ -6,23 +6,67 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 
 namespace TW {
 
+struct MnemonicWordlist;
+
 /// BIP39 Mnemonic recovery phrase handling.
 class Mnemonic {
 public:
     static constexpr int MaxWords = 24;
     static constexpr int MinWords = 12;
     static constexpr int BitsPerWord = 11; // each word encodes this many bits (there are 2^11=2048 different words)
+    static constexpr int MaxBitsSize = MaxWords * BitsPerWord / 8; // bytes of entropy and checksum of the longest phrase
+
+    /// BIP39 wordlist languages; see hasWordlist for the ones compiled in.
+    enum class Language {
+        English,
+        Japanese,
+        Korean,
+        Spanish,
+        ChineseSimplified,
+        ChineseTraditional,
+        French,
+        Italian,
+        Czech,
+        Portuguese,
+    };
 
 public:
-    /// Determines whether a BIP39 English mnemonic phrase is valid.
+    /// Determines whether a BIP39 mnemonic phrase is valid in any of the compiled-in languages.
     // E.g. for a valid mnemonic: "credit expect life fade cover suit response wash pear what skull force"
     static bool isValid(const std::string& mnemonic);
 
-    /// Determines whether word is a valid BIP39 English menemonic word.
+    /// Determines whether a BIP39 mnemonic phrase of the given language is valid, words and checksum.
+    // - The phrase is NFKD normalised first, words must then be separated by single spaces
+    //   (the Japanese ideographic space normalises to a space)
+    // - Returns false if the wordlist of the language is not compiled in
+    static bool isValid(const std::string& mnemonic, Language language);
+
+    /// Returns the first language, in enum order, in which the NFKD normalised mnemonic phrase is valid.
+    // Wordlists that do not contain the first word are skipped after a single lookup.
+    static std::optional<Language> detectLanguage(const std::string& mnemonic);
+
+    /// Writes the entropy and checksum bits of a mnemonic phrase of the given language to `bits`
+    /// (MaxBitsSize bytes), like mnemonic_to_bits does for English. Does not check the checksum.
+    /// Returns the number of bits, 0 if a word is not in the wordlist or the word count is invalid.
+    static int toBits(const std::string& mnemonic, Language language, uint8_t* bits);
+
+    /// Determines whether the wordlist of a language is compiled in.
+    static bool hasWordlist(Language language);
+
+    /// Returns the BIP39 index of a word, once NFKD normalised, in the wordlist of a language, or -1.
+    static int wordIndex(const std::string& word, Language language);
+
+    /// Returns the NFKD normalisation of UTF-8 text, which BIP39 applies to phrases before
+    /// computing seeds. Malformed UTF-8 is returned unchanged.
+    static std::string normalize(const std::string& text);
+
+    /// Determines whether word, once NFKD normalised, is in any of the compiled-in wordlists.
     static bool isValidWord(const std::string& word);
 
     /// Return BIP39 English words that match the given prefix.
@@ -41,6 +85,10 @@ public:
     static std::string suggest(const std::string& prefix);
 
     static const int SuggestMaxCount;
+
+private:
+    static int toBits(const std::string& mnemonic, const MnemonicWordlist& wordlist, uint8_t* bits);
+    static bool isValid(const std::string& mnemonic, const MnemonicWordlist& wordlist);
 };
 
 } // namespace TW
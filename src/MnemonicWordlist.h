@@ -0,0 +1,58 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Mnemonic.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace TW {
+
+/// A BIP39 wordlist sorted by the bytes of its NFKD normalised words, for binary search.
+/// Generated by codegen/bin/wordlists from the official wordlists.
+struct MnemonicWordlist {
+    static constexpr size_t size = 2048;
+
+    /// Sorted words, concatenated without separators
+    const char* words;
+    /// Offset of each sorted word in `words`, followed by the total length
+    const uint16_t* offsets;
+    /// BIP39 index of each sorted word
+    const uint16_t* indices;
+    /// Sorted words by first byte: those starting with byte b are [starts[b], starts[b + 1])
+    const uint16_t* starts;
+
+    /// Returns the BIP39 index of a NFKD normalised word, or -1 if it is not in the list.
+    int find(const char* word, size_t length) const;
+};
+
+/// Returns the wordlist of a language, nullptr if it is not compiled in.
+const MnemonicWordlist* mnemonicWordlist(Mnemonic::Language language);
+
+/// Unicode data for the NFKD normalisation of mnemonic phrases, generated by codegen/bin/wordlists.
+/// Hangul syllables are not in the tables, they decompose algorithmically.
+struct UnicodeNormalization {
+    /// Number of code points that do not decompose to themselves
+    size_t decomposableCount;
+    /// Those code points, ascending
+    const char32_t* decomposable;
+    /// Full decomposition of decomposable[i] is decompositions[offsets[i]] to decompositions[offsets[i + 1]]
+    const uint16_t* offsets;
+    const char32_t* decompositions;
+
+    /// Number of code points with a non-zero canonical combining class
+    size_t combiningCount;
+    /// Those code points, ascending
+    const char32_t* combining;
+    /// Canonical combining class of combining[i]
+    const uint8_t* classes;
+};
+
+const UnicodeNormalization& unicodeNormalization();
+
+} // namespace TW
@@ -24,9 +24,9 @@
 using namespace TW;
 
 
-bool PrivateKey::isValid(const Data& data) {
+bool PrivateKey::isValid(const byte* data, size_t dataSize) {
     // Check length
-    if (data.size() != size && data.size() != doubleExtendedSize) {
+    if (dataSize != size && dataSize != doubleExtendedSize) {
         return false;
     }
 
@@ -40,10 +40,10 @@ bool PrivateKey::isValid(const Data& data) {
     return false;
 }
 
-bool PrivateKey::isValid(const Data& data, TWCurve curve)
+bool PrivateKey::isValid(const byte* data, size_t dataSize, TWCurve curve)
 {
     // check size
-    bool valid = isValid(data);
+    bool valid = isValid(data, dataSize);
     if (!valid) {
         return false;
     }
@@ -68,7 +68,7 @@ bool PrivateKey::isValid(const Data& data, TWCurve curve)
 
     if (ec_curve != nullptr) {
         bignum256 k;
-        bn_read_be(data.data(), &k);
+        bn_read_be(data, &k);
         if (!bn_is_less(&k, &ec_curve->order)) {
             memzero(&k, sizeof(k));
             return false;
@@ -78,54 +78,55 @@ bool PrivateKey::isValid(const Data& data, TWCurve curve)
     return true;
 }
 
-PrivateKey::PrivateKey(const Data& data) {
-    if (!isValid(data)) {
+PrivateKey::PrivateKey(const byte* data, size_t dataSize) {
+    if (!isValid(data, dataSize)) {
         throw std::invalid_argument("Invalid private key data");
     }
-    bytes = data;
+    bytes.assign(data, dataSize);
 }
 
 PrivateKey::PrivateKey(
-    const Data& key1, const Data& extension1, const Data& chainCode1,
-    const Data& key2, const Data& extension2, const Data& chainCode2) {
+    DataView key1, DataView extension1, DataView chainCode1,
+    DataView key2, DataView extension2, DataView chainCode2) {
     if (key1.size() != size || extension1.size() != size || chainCode1.size() != size ||
         key2.size() != size || extension2.size() != size || chainCode2.size() != size) {
         throw std::invalid_argument("Invalid private key or extended key data");
     }
-    bytes = key1;
-    append(bytes, extension1);
-    append(bytes, chainCode1);
-    append(bytes, key2);
-    append(bytes, extension2);
-    append(bytes, chainCode2);
+    bytes.resize(doubleExtendedSize);
+    auto* it = bytes.begin();
+    for (const auto* part : {&key1, &extension1, &chainCode1, &key2, &extension2, &chainCode2}) {
+        it = std::copy(part->begin(), part->end(), it);
+    }
 }
 
 PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
-    Data result;
+    byte result[PublicKey::ed25519DoubleExtendedSize];
+    size_t resultSize = 0;
+    const auto* key = keyView().data();
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
-        result.resize(PublicKey::secp256k1Size);
-        ecdsa_get_public_key33(&secp256k1, key().data(), result.data());
+        resultSize = PublicKey::secp256k1Size;
+        ecdsa_get_public_key33(&secp256k1, key, result);
         break;
     case TWPublicKeyTypeSECP256k1Extended:
-        result.resize(PublicKey::secp256k1ExtendedSize);
-        ecdsa_get_public_key65(&secp256k1, key().data(), result.data());
+        resultSize = PublicKey::secp256k1ExtendedSize;
+        ecdsa_get_public_key65(&secp256k1, key, result);
         break;
     case TWPublicKeyTypeNIST256p1:
-        result.resize(PublicKey::secp256k1Size);
-        ecdsa_get_public_key33(&nist256p1, key().data(), result.data());
+        resultSize = PublicKey::secp256k1Size;
+        ecdsa_get_public_key33(&nist256p1, key, result);
         break;
     case TWPublicKeyTypeNIST256p1Extended:
-        result.resize(PublicKey::secp256k1ExtendedSize);
-        ecdsa_get_public_key65(&nist256p1, key().data(), result.data());
+        resultSize = PublicKey::secp256k1ExtendedSize;
+        ecdsa_get_public_key65(&nist256p1, key, result);
         break;
     case TWPublicKeyTypeED25519:
-        result.resize(PublicKey::ed25519Size);
-        ed25519_publickey(key().data(), result.data());
+        resultSize = PublicKey::ed25519Size;
+        ed25519_publickey(key, result);
         break;
     case TWPublicKeyTypeED25519Blake2b:
-        result.resize(PublicKey::ed25519Size);
-        ed25519_publickey_blake2b(key().data(), result.data());
+        resultSize = PublicKey::ed25519Size;
+        ed25519_publickey_blake2b(key, result);
         break;
     case TWPublicKeyTypeED25519Extended:
         {
@@ -133,27 +134,24 @@ PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
             if (bytes.size() != doubleExtendedSize) {
                 throw std::invalid_argument("Invalid extended key");
             }
-            Data tempPub(64);
-            ed25519_publickey_ext(key().data(), extension().data(), tempPub.data());
-            result = Data();
-            append(result, subData(tempPub, 0, 32));
-            // copy chainCode
-            append(result, chainCode());
-
-            // second key
-            ed25519_publickey_ext(secondKey().data(), secondExtension().data(), tempPub.data());
-            append(result, subData(tempPub, 0, 32));
-            append(result, secondChainCode());
+            // key+extension+chainCode, twice: public key+chainCode, twice
+            ed25519_publickey_ext(key, extensionView().data(), result);
+            const auto chainCode = chainCodeView();
+            std::copy(chainCode.begin(), chainCode.end(), result + 32);
+            ed25519_publickey_ext(secondKeyView().data(), secondExtensionView().data(), result + 64);
+            const auto secondChainCode = secondChainCodeView();
+            std::copy(secondChainCode.begin(), secondChainCode.end(), result + 96);
+            resultSize = PublicKey::ed25519DoubleExtendedSize;
         }
         break;
 
     case TWPublicKeyTypeCURVE25519:
-        result.resize(PublicKey::ed25519Size);
+        resultSize = PublicKey::ed25519Size;
         PublicKey ed25519PublicKey = getPublicKey(TWPublicKeyTypeED25519);
-        ed25519_pk_to_curve25519(result.data(), ed25519PublicKey.bytes.data());
+        ed25519_pk_to_curve25519(result, ed25519PublicKey.bytes.data());
         break;
     }
-    return PublicKey(result, type);
+    return PublicKey(result, resultSize, type);
 }
 
 Data PrivateKey::getSharedKey(const PublicKey& pubKey, TWCurve curve) const {
@@ -162,7 +160,7 @@ Data PrivateKey::getSharedKey(const PublicKey& pubKey, TWCurve curve) const {
     }
 
     Data result(PublicKey::secp256k1ExtendedSize);
-    bool success = ecdh_multiply(&secp256k1, key().data(),
+    bool success = ecdh_multiply(&secp256k1, bytes.data(),
                                  pubKey.bytes.data(), result.data()) == 0;
 
     if (success) {
@@ -183,57 +181,52 @@ int ecdsa_sign_digest_checked(const ecdsa_curve *curve, const uint8_t *priv_key,
 }
 
 Data PrivateKey::sign(const Data& digest, TWCurve curve) const {
-    Data result;
-    bool success = false;
+    Data result(maxSignatureSize);
+    const auto size = sign(digest.data(), digest.size(), curve, result.data());
+    result.resize(size);
+    return result;
+}
+
+size_t PrivateKey::sign(const byte* digest, size_t digestSize, TWCurve curve, byte* signature) const {
+    const auto* key = keyView().data();
     switch (curve) {
     case TWCurveSECP256k1: {
-        result.resize(65);
-        success = ecdsa_sign_digest_checked(&secp256k1, key().data(), digest.data(), digest.size(), result.data(),
-                                    result.data() + 64, nullptr) == 0;
-    } break;
+        const auto success = ecdsa_sign_digest_checked(&secp256k1, key, digest, digestSize, signature,
+                                    signature + 64, nullptr) == 0;
+        return success ? 65 : 0;
+    }
     case TWCurveED25519: {
-        result.resize(64);
         const auto publicKey = getPublicKey(TWPublicKeyTypeED25519);
-        ed25519_sign(digest.data(), digest.size(), key().data(), publicKey.bytes.data(), result.data());
-        success = true;
-    } break;
+        ed25519_sign(digest, digestSize, key, publicKey.bytes.data(), signature);
+        return 64;
+    }
     case TWCurveED25519Blake2bNano: {
-        result.resize(64);
         const auto publicKey = getPublicKey(TWPublicKeyTypeED25519Blake2b);
-        ed25519_sign_blake2b(digest.data(), digest.size(), key().data(),
-                             publicKey.bytes.data(), result.data());
-        success = true;
-    } break;
+        ed25519_sign_blake2b(digest, digestSize, key, publicKey.bytes.data(), signature);
+        return 64;
+    }
     case TWCurveED25519Extended: {
-        result.resize(64);
         const auto publicKey = getPublicKey(TWPublicKeyTypeED25519Extended);
-        ed25519_sign_ext(digest.data(), digest.size(), key().data(), extension().data(), publicKey.bytes.data(), result.data());
-        success = true;
-    } break;
+        ed25519_sign_ext(digest, digestSize, key, extensionView().data(), publicKey.keyView().data(), signature);
+        return 64;
+    }
     case TWCurveCurve25519: {
-        result.resize(64);
         const auto publicKey = getPublicKey(TWPublicKeyTypeED25519);
-        ed25519_sign(digest.data(), digest.size(), key().data(), publicKey.bytes.data(),
-                     result.data());
+        ed25519_sign(digest, digestSize, key, publicKey.bytes.data(), signature);
         const auto sign_bit = publicKey.bytes[31] & 0x80;
-        result[63] = result[63] & 127;
-        result[63] |= sign_bit;
-        success = true;
-    } break;
+        signature[63] = signature[63] & 127;
+        signature[63] |= sign_bit;
+        return 64;
+    }
     case TWCurveNIST256p1: {
-        result.resize(65);
-        success = ecdsa_sign_digest_checked(&nist256p1, key().data(), digest.data(), digest.size(), result.data(),
-                                    result.data() + 64, nullptr) == 0;
-    } break;
-    case TWCurveNone:
-    default: 
-        break;
+        const auto success = ecdsa_sign_digest_checked(&nist256p1, key, digest, digestSize, signature,
+                                    signature + 64, nullptr) == 0;
+        return success ? 65 : 0;
     }
-
-    if (!success) {
-        return {};
+    case TWCurveNone:
+    default:
+        return 0;
     }
-    return result;
 }
 
 Data PrivateKey::sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(uint8_t by, uint8_t sig[64])) const {
@@ -242,7 +235,7 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(
     switch (curve) {
     case TWCurveSECP256k1: {
         result.resize(65);
-        success = ecdsa_sign_digest_checked(&secp256k1, key().data(), digest.data(), digest.size(), result.data() + 1,
+        success = ecdsa_sign_digest_checked(&secp256k1, bytes.data(), digest.data(), digest.size(), result.data() + 1,
                                     result.data(), canonicalChecker) == 0;
     } break;
     case TWCurveED25519: // not supported
@@ -252,7 +245,7 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(
         break;
     case TWCurveNIST256p1: {
         result.resize(65);
-        success = ecdsa_sign_digest_checked(&nist256p1, key().data(), digest.data(), digest.size(), result.data() + 1,
+        success = ecdsa_sign_digest_checked(&nist256p1, bytes.data(), digest.data(), digest.size(), result.data() + 1,
                                     result.data(), canonicalChecker) == 0;
     } break;
     case TWCurveNone:
@@ -272,7 +265,7 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(
 Data PrivateKey::signAsDER(const Data& digest, TWCurve curve) const {
     Data sig(64);
     bool success =
-        ecdsa_sign_digest(&secp256k1, key().data(), digest.data(), sig.data(), nullptr, nullptr) == 0;
+        ecdsa_sign_digest(&secp256k1, bytes.data(), digest.data(), sig.data(), nullptr, nullptr) == 0;
     if (!success) {
         return {};
     }
@@ -290,7 +283,7 @@ Data PrivateKey::signSchnorr(const Data& message, TWCurve curve) const {
     Data sig(64);
     switch (curve) {
     case TWCurveSECP256k1: {
-        success = zil_schnorr_sign(&secp256k1, key().data(), message.data(), static_cast<uint32_t>(message.size()), sig.data()) == 0;
+        success = zil_schnorr_sign(&secp256k1, bytes.data(), message.data(), static_cast<uint32_t>(message.size()), sig.data()) == 0;
     } break;
 
     case TWCurveNIST256p1:
@@ -311,5 +304,5 @@ Data PrivateKey::signSchnorr(const Data& message, TWCurve curve) const {
 }
 
 void PrivateKey::cleanup() {
-    std::fill(bytes.begin(), bytes.end(), 0);
+    memzero(bytes.data(), bytes.capacity());
 }
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "Data.h"
+#include "DataView.h"
+#include "FixedData.h"
 #include "PublicKey.h"
 
 #include <TrustWalletCore/TWCurve.h>
@@ -19,36 +21,52 @@ class PrivateKey {
     static const size_t size = 32;
     /// The number of bytes in a double extended key (used by Cardano)
     static const size_t doubleExtendedSize = 2 * 3 * 32;
+    /// The maximum number of bytes in a signature
+    static const size_t maxSignatureSize = 65;
 
-    /// The private key bytes:
+    /// The private key bytes, stored inline:
     /// - common case: 'size' bytes
     /// - double extended case: 'doubleExtendedSize' bytes, key+extension+chainCode+second+secondExtension+secondChainCode
-    Data bytes;
-
-    /// Optional members for extended keys and second extended keys
-    Data key() const { return subData(bytes, 0, 32); }
-    Data extension() const { return subData(bytes, 32, 32); }
-    Data chainCode() const { return subData(bytes, 2*32, 32); }
-    Data secondKey() const { return subData(bytes, 3*32, 32); }
-    Data secondExtension() const { return subData(bytes, 4*32, 32); }
-    Data secondChainCode() const { return subData(bytes, 5*32, 32); }
+    FixedData<doubleExtendedSize> bytes;
+
+    /// Optional members for extended keys and second extended keys, as views valid as long as
+    /// the key; empty if the key is not that long.
+    DataView keyView() const { return bytes.view().subView(0, 32); }
+    DataView extensionView() const { return bytes.view().subView(32, 32); }
+    DataView chainCodeView() const { return bytes.view().subView(2*32, 32); }
+    DataView secondKeyView() const { return bytes.view().subView(3*32, 32); }
+    DataView secondExtensionView() const { return bytes.view().subView(4*32, 32); }
+    DataView secondChainCodeView() const { return bytes.view().subView(5*32, 32); }
+
+    /// Copies of the optional members
+    Data key() const { return keyView(); }
+    Data extension() const { return extensionView(); }
+    Data chainCode() const { return chainCodeView(); }
+    Data secondKey() const { return secondKeyView(); }
+    Data secondExtension() const { return secondExtensionView(); }
+    Data secondChainCode() const { return secondChainCodeView(); }
 
     /// Determines if a collection of bytes makes a valid private key.
-    static bool isValid(const Data& data);
+    static bool isValid(const byte* data, size_t size);
+    static bool isValid(const Data& data) { return isValid(data.data(), data.size()); }
 
     /// Determines if a collection of bytes and curve make a valid private key.
-    static bool isValid(const Data& data, TWCurve curve);
+    static bool isValid(const byte* data, size_t size, TWCurve curve);
+    static bool isValid(const Data& data, TWCurve curve) { return isValid(data.data(), data.size(), curve); }
 
     /// Initializes a private key with an array of bytes.  Size must be exact (normally 32, or 192 for extended)
-    explicit PrivateKey(const Data& data);
+    ///
+    /// @throws std::invalid_argument if the data is not a valid private key.
+    explicit PrivateKey(const byte* data, size_t size);
+    explicit PrivateKey(const Data& data) : PrivateKey(data.data(), data.size()) {}
 
     /// Initializes a private key from a string of bytes.
     explicit PrivateKey(const std::string& data) : PrivateKey(TW::data(data)) {}
 
     /// Initializes a double extended private key with two extended keys
     explicit PrivateKey(
-        const Data& bytes1, const Data& extension1, const Data& chainCode1,
-        const Data& bytes2, const Data& extension2, const Data& chainCode2);
+        DataView bytes1, DataView extension1, DataView chainCode1,
+        DataView bytes2, DataView extension2, DataView chainCode2);
 
     PrivateKey(const PrivateKey& other) = default;
     PrivateKey& operator=(const PrivateKey& other) = default;
@@ -68,6 +86,10 @@ class PrivateKey {
     /// Signs a digest using the given ECDSA curve.
     Data sign(const Data& digest, TWCurve curve) const;
 
+    /// Signs a digest using the given ECDSA curve into `signature`, of at least `maxSignatureSize` bytes.
+    /// Returns the size of the signature, 0 on failure.
+    size_t sign(const byte* digest, size_t digestSize, TWCurve curve, byte* signature) const;
+
     /// Signs a digest using the given ECDSA curve and prepends the recovery id (a la graphene)
     /// Only a sig that passes canonicalChecker is returned
     Data sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(uint8_t by, uint8_t sig[64])) const;
@@ -20,8 +20,7 @@ namespace TW {
 
 /// Determines if a collection of bytes makes a valid public key of the
 /// given type.
-bool PublicKey::isValid(const Data& data, enum TWPublicKeyType type) {
-    const auto size = data.size();
+bool PublicKey::isValid(const byte* data, size_t size, enum TWPublicKeyType type) {
     if (size == 0) {
         return false;
     }
@@ -47,37 +46,16 @@ bool PublicKey::isValid(const Data& data, enum TWPublicKeyType type) {
 /// Initializes a public key with a collection of bytes.
 ///
 /// @throws std::invalid_argument if the data is not a valid public key.
-PublicKey::PublicKey(const Data& data, enum TWPublicKeyType type)
+PublicKey::PublicKey(const byte* data, size_t size, enum TWPublicKeyType type)
     : type(type) {
-    if (!isValid(data, type)) {
+    if (!isValid(data, size, type)) {
         throw std::invalid_argument("Invalid public key data");
     }
-    switch (type) {
-    case TWPublicKeyTypeSECP256k1:
-    case TWPublicKeyTypeNIST256p1:
-    case TWPublicKeyTypeSECP256k1Extended:
-    case TWPublicKeyTypeNIST256p1Extended:
-        bytes.reserve(data.size());
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        break;
-
-    case TWPublicKeyTypeED25519:
-    case TWPublicKeyTypeCURVE25519:
-        bytes.reserve(ed25519Size);
-        if (data.size() == ed25519Size + 1) {
-            std::copy(std::begin(data) + 1, std::end(data), std::back_inserter(bytes));
-        } else {
-            std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        }
-        break;
-    case TWPublicKeyTypeED25519Blake2b:
-        bytes.reserve(ed25519Size);
-        assert(data.size() == ed25519Size); // ensured by isValid() above
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        break;
-    case TWPublicKeyTypeED25519Extended:
-        bytes.reserve(ed25519DoubleExtendedSize);
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
+    if ((type == TWPublicKeyTypeED25519 || type == TWPublicKeyTypeCURVE25519) && size == ed25519Size + 1) {
+        // skip the 0x01 prefix
+        bytes.assign(data + 1, ed25519Size);
+    } else {
+        bytes.assign(data, size);
     }
 }
 
@@ -86,34 +64,34 @@ PublicKey PublicKey::compressed() const {
         return *this;
     }
 
-    Data newBytes(secp256k1Size);
+    byte newBytes[secp256k1Size];
     assert(bytes.size() >= 65);
     newBytes[0] = 0x02 | (bytes[64] & 0x01);
 
     assert(type == TWPublicKeyTypeSECP256k1Extended || type == TWPublicKeyTypeNIST256p1Extended);
     switch (type) {
     case TWPublicKeyTypeSECP256k1Extended:
-        std::copy(bytes.begin() + 1, bytes.begin() + secp256k1Size, newBytes.begin() + 1);
-        return PublicKey(newBytes, TWPublicKeyTypeSECP256k1);
+        std::copy(bytes.begin() + 1, bytes.begin() + secp256k1Size, newBytes + 1);
+        return PublicKey(newBytes, secp256k1Size, TWPublicKeyTypeSECP256k1);
 
     case TWPublicKeyTypeNIST256p1Extended:
     default:
-        std::copy(bytes.begin() + 1, bytes.begin() + secp256k1Size, newBytes.begin() + 1);
-        return PublicKey(newBytes, TWPublicKeyTypeNIST256p1);
+        std::copy(bytes.begin() + 1, bytes.begin() + secp256k1Size, newBytes + 1);
+        return PublicKey(newBytes, secp256k1Size, TWPublicKeyTypeNIST256p1);
     }
 }
 
 PublicKey PublicKey::extended() const {
-    Data newBytes(secp256k1ExtendedSize);
+    byte newBytes[secp256k1ExtendedSize];
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
-        ecdsa_uncompress_pubkey(&secp256k1, bytes.data(), newBytes.data());
-        return PublicKey(newBytes, TWPublicKeyTypeSECP256k1Extended);
+        ecdsa_uncompress_pubkey(&secp256k1, bytes.data(), newBytes);
+        return PublicKey(newBytes, secp256k1ExtendedSize, TWPublicKeyTypeSECP256k1Extended);
     case TWPublicKeyTypeSECP256k1Extended:
         return *this;
     case TWPublicKeyTypeNIST256p1:
-        ecdsa_uncompress_pubkey(&nist256p1, bytes.data(), newBytes.data());
-        return PublicKey(newBytes, TWPublicKeyTypeNIST256p1Extended);
+        ecdsa_uncompress_pubkey(&nist256p1, bytes.data(), newBytes);
+        return PublicKey(newBytes, secp256k1ExtendedSize, TWPublicKeyTypeNIST256p1Extended);
     case TWPublicKeyTypeNIST256p1Extended:
         return *this;
     case TWPublicKeyTypeED25519:
@@ -160,6 +138,56 @@ bool PublicKey::verify(const Data& signature, const Data& message) const {
     }
 }
 
+std::vector<bool> PublicKey::verifyBatch(const std::vector<PublicKey>& publicKeys, const std::vector<Data>& signatures, const std::vector<Data>& messages) {
+    const auto count = publicKeys.size();
+    if (signatures.size() != count || messages.size() != count) {
+        throw std::invalid_argument("Mismatched batch sizes");
+    }
+    std::vector<bool> results(count, false);
+
+    // Collect the ECDSA signatures of one curve, verify anything else directly
+    const auto verifyCurve = [&](const ecdsa_curve* curve, TWPublicKeyType compressed, TWPublicKeyType extended) {
+        std::vector<std::size_t> indices;
+        std::vector<const uint8_t*> keys, sigs, digests;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto type = publicKeys[i].type;
+            if (type != compressed && type != extended) {
+                continue;
+            }
+            if (signatures[i].size() < 64 || messages[i].size() < 32) {
+                continue;
+            }
+            indices.push_back(i);
+            keys.push_back(publicKeys[i].bytes.data());
+            sigs.push_back(signatures[i].data());
+            digests.push_back(messages[i].data());
+        }
+        if (indices.empty()) {
+            return;
+        }
+        std::vector<int> verified(indices.size());
+        ecdsa_verify_digest_batch(curve, indices.size(), keys.data(), sigs.data(), digests.data(), verified.data());
+        for (std::size_t j = 0; j < indices.size(); ++j) {
+            results[indices[j]] = verified[j] == 0;
+        }
+    };
+    verifyCurve(&secp256k1, TWPublicKeyTypeSECP256k1, TWPublicKeyTypeSECP256k1Extended);
+    verifyCurve(&nist256p1, TWPublicKeyTypeNIST256p1, TWPublicKeyTypeNIST256p1Extended);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        switch (publicKeys[i].type) {
+        case TWPublicKeyTypeSECP256k1:
+        case TWPublicKeyTypeSECP256k1Extended:
+        case TWPublicKeyTypeNIST256p1:
+        case TWPublicKeyTypeNIST256p1Extended:
+            break;
+        default:
+            results[i] = publicKeys[i].verify(signatures[i], messages[i]);
+        }
+    }
+    return results;
+}
+
 bool PublicKey::verifyAsDER(const Data& signature, const Data& message) const {
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
@@ -195,12 +223,14 @@ bool PublicKey::verifySchnorr(const Data& signature, const Data& message) const
 
 Data PublicKey::hash(const Data& prefix, Hash::Hasher hasher, bool skipTypeByte) const {
     const auto offset = std::size_t(skipTypeByte ? 1 : 0);
-    const auto hash = Hash::hash(hasher, bytes.data() + offset, bytes.size() - offset);
+    auto context = Hash::Context(hasher);
+    context.update(bytes.data() + offset, bytes.size() - offset);
 
     auto result = Data();
-    result.reserve(prefix.size() + hash.size());
+    result.reserve(prefix.size() + context.size());
     append(result, prefix);
-    append(result, hash);
+    result.resize(prefix.size() + context.size());
+    context.final(result.data() + prefix.size());
     return result;
 }
 
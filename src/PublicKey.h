@@ -7,12 +7,15 @@
 #pragma once
 
 #include "Data.h"
+#include "DataView.h"
+#include "FixedData.h"
 #include "Hash.h"
 
 #include <TrustWalletCore/TWPublicKeyType.h>
 
 #include <cassert>
 #include <stdexcept>
+#include <vector>
 
 namespace TW {
 
@@ -29,8 +32,21 @@ class PublicKey {
     /// The number of bytes in a secp256k1 and nist256p1 extended public key.
     static const size_t secp256k1ExtendedSize = 65;
 
-    /// The public key bytes.
-    Data bytes;
+    /// The public key bytes, stored inline.
+    FixedData<ed25519DoubleExtendedSize> bytes;
+
+    /// Parts of double extended ed25519 keys (used by Cardano), as views valid as long as the
+    /// key; the key bytes and empty views for other types.
+    DataView keyView() const { return type == TWPublicKeyTypeED25519Extended ? bytes.view().subView(0, 32) : bytes.view(); }
+    DataView chainCodeView() const { return partView(32); }
+    DataView secondKeyView() const { return partView(2*32); }
+    DataView secondChainCodeView() const { return partView(3*32); }
+
+    /// Copies of the parts
+    Data key() const { return keyView(); }
+    Data chainCode() const { return chainCodeView(); }
+    Data secondKey() const { return secondKeyView(); }
+    Data secondChainCode() const { return secondChainCodeView(); }
 
     /// The type of the public key.
     ///
@@ -40,12 +56,14 @@ class PublicKey {
 
     /// Determines if a collection of bytes makes a valid public key of the
     /// given type.
-    static bool isValid(const Data& data, enum TWPublicKeyType type);
+    static bool isValid(const byte* data, size_t size, enum TWPublicKeyType type);
+    static bool isValid(const Data& data, enum TWPublicKeyType type) { return isValid(data.data(), data.size(), type); }
 
     /// Initializes a public key with a collection of bytes.
     ///
     /// @throws std::invalid_argument if the data is not a valid public key.
-    explicit PublicKey(const Data& data, enum TWPublicKeyType type);
+    explicit PublicKey(const byte* data, size_t size, enum TWPublicKeyType type);
+    explicit PublicKey(const Data& data, enum TWPublicKeyType type) : PublicKey(data.data(), data.size(), type) {}
 
     /// Determines if this is a compressed public key.
     bool isCompressed() const {
@@ -61,6 +79,16 @@ class PublicKey {
     /// Verifies a signature for the provided message.
     bool verify(const Data& signature, const Data& message) const;
 
+    /// Verifies a batch of signatures: `signatures[i]` of `messages[i]` by `publicKeys[i]`.
+    ///
+    /// secp256k1 and nist256p1 signatures are verified together, sharing modular inversions
+    /// and computing both scalar multiplications of each signature in one pass; other key
+    /// types are verified one by one.
+    ///
+    /// @returns the result of `publicKeys[i].verify(signatures[i], messages[i])` for each i.
+    /// @throws std::invalid_argument if the sizes of the vectors differ.
+    static std::vector<bool> verifyBatch(const std::vector<PublicKey>& publicKeys, const std::vector<Data>& signatures, const std::vector<Data>& messages);
+
     /// Verifies a signature in DER format.
     bool verifyAsDER(const Data& signature, const Data& message) const;
 
@@ -78,6 +106,11 @@ class PublicKey {
 
     /// Check if this key makes a valid ED25519 key (it is on the curve)
     bool isValidED25519() const;
+
+  private:
+    DataView partView(size_t offset) const {
+        return type == TWPublicKeyTypeED25519Extended ? bytes.view().subView(offset, 32) : DataView();
+    }
 };
 
 inline bool operator==(const PublicKey& lhs, const PublicKey& rhs) {
@@ -30,7 +30,7 @@ const std::array<byte, 4> Zcash::SaplingBranchID = {0xbb, 0x09, 0xb8, 0x76};
 const std::array<byte, 4> Zcash::BlossomBranchID = {0x60, 0x0e, 0xb4, 0x2b};
 
 Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
-                              uint64_t amount) const {
+                              uint64_t amount, const Bitcoin::SigHashCache* cache) const {
     assert(index < inputs.size());
 
     auto data = Data{};
@@ -43,7 +43,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Input prevouts (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0) {
-        auto hashPrevouts = getPrevoutHash();
+        auto hashPrevouts = cache != nullptr ? cache->hashPrevouts : getPrevoutHash();
         std::copy(std::begin(hashPrevouts), std::end(hashPrevouts), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -52,7 +52,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
     // Input nSequence (none/all, depending on flags)
     if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
         !Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashSequence = getSequenceHash();
+        auto hashSequence = cache != nullptr ? cache->hashSequence : getSequenceHash();
         std::copy(std::begin(hashSequence), std::end(hashSequence), std::back_inserter(data));
     } else {
         std::fill_n(back_inserter(data), 32, 0);
@@ -60,7 +60,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 
     // Outputs (none/one/all, depending on flags)
     if (!Bitcoin::hashTypeIsSingle(hashType) && !Bitcoin::hashTypeIsNone(hashType)) {
-        auto hashOutputs = getOutputsHash();
+        auto hashOutputs = cache != nullptr ? cache->hashOutputs : getOutputsHash();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else if (Bitcoin::hashTypeIsSingle(hashType) && index < outputs.size()) {
         auto outputData = Data{};
@@ -136,6 +136,10 @@ Data Transaction::getOutputsHash() const {
     return hash;
 }
 
+Bitcoin::SigHashCache Transaction::getSigHashCache() const {
+    return Bitcoin::SigHashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash()};
+}
+
 Data Transaction::getJoinSplitsHash() const {
     Data vec(32, 0);
     return vec;
@@ -181,13 +185,14 @@ void Transaction::encode(Data& data) const {
 
 Data Transaction::getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
-                                   Bitcoin::SignatureVersion version) const {
+                                   Bitcoin::SignatureVersion version,
+                                   const Bitcoin::SigHashCache* cache) const {
     Data personalization;
     personalization.reserve(16);
     std::copy(sigHashPersonalization.begin(), sigHashPersonalization.begin() + 12,
               std::back_inserter(personalization));
     std::copy(branchId.begin(), branchId.end(), std::back_inserter(personalization));
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
+    auto preimage = getPreImage(scriptCode, index, hashType, amount, cache);
     auto hash = Hash::blake2b(preimage, 32, personalization);
     return hash;
 }
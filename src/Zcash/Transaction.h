@@ -51,12 +51,18 @@ struct Transaction {
     bool empty() const { return inputs.empty() && outputs.empty(); }
 
     /// Generates the signature pre-image.
+    /// The optional cache is used instead of recomputing hashPrevouts, hashSequence and hashOutputs.
     Data getPreImage(const Bitcoin::Script& scriptCode, size_t index,
-                     enum TWBitcoinSigHashType hashType, uint64_t amount) const;
+                     enum TWBitcoinSigHashType hashType, uint64_t amount,
+                     const Bitcoin::SigHashCache* cache = nullptr) const;
     Data getPrevoutHash() const;
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the ZIP-243 pre-image hashes shared by all inputs; valid as long as the inputs' outpoints and
+    /// sequences, and the outputs, stay unchanged.
+    Bitcoin::SigHashCache getSigHashCache() const;
+
     Data getJoinSplitsHash() const;
     Data getShieldedSpendsHash() const;
     Data getShieldedOutputsHash() const;
@@ -66,7 +72,8 @@ struct Transaction {
 
     Data getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                           enum TWBitcoinSigHashType hashType, uint64_t amount,
-                          enum Bitcoin::SignatureVersion version) const;
+                          enum Bitcoin::SignatureVersion version,
+                          const Bitcoin::SigHashCache* cache = nullptr) const;
 
     /// Converts to Protobuf model
     Bitcoin::Proto::Transaction proto() const;
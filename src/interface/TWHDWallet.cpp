@@ -10,8 +10,29 @@
 #include "../HDWallet.h"
 #include "../Mnemonic.h"
 
+#include <algorithm>
+#include <thread>
+
 using namespace TW;
 
+namespace {
+
+struct TWDataVector *_Nonnull createTWDataVector(const std::vector<std::string>& addresses) {
+    auto* vector = TWDataVectorCreate();
+    for (const auto& address : addresses) {
+        auto* data = TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(address.data()), address.size());
+        TWDataVectorAdd(vector, data);
+        TWDataDelete(data);
+    }
+    return vector;
+}
+
+/// Worker count for address derivation, 0 meaning one per core
+size_t addressThreads(uint32_t threads) {
+    return threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+} // namespace
 
 struct TWHDWallet *_Nullable TWHDWalletCreate(int strength, TWString *_Nonnull passphrase) {
     try {
@@ -89,6 +110,15 @@ struct TWPrivateKey *_Nonnull TWHDWalletGetDerivedKey(struct TWHDWallet *_Nonnul
     return new TWPrivateKey{ wallet->impl.getKey(coin, derivationPath) };
 }
 
+struct TWDataVector *_Nonnull TWHDWalletGetAddressesDerivation(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, enum TWDerivation derivation, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count, uint32_t threads) {
+    try {
+        return createTWDataVector(wallet->impl.deriveAddresses(coin, derivation, account, change, firstIndex, count, addressThreads(threads)));
+    } catch (...) {
+        // e.g. worker thread creation failed; exceptions must not cross the C interface
+        return TWDataVectorCreate();
+    }
+}
+
 TWString *_Nonnull TWHDWalletGetExtendedPrivateKey(struct TWHDWallet *wallet, TWPurpose purpose, TWCoinType coin, TWHDVersion version) {
     return new std::string(wallet->impl.getExtendedPrivateKey(purpose, coin, version));
 }
@@ -121,3 +151,12 @@ TWPublicKey *TWHDWalletGetPublicKeyFromExtended(TWString *_Nonnull extended, enu
     }
     return new TWPublicKey{ PublicKey(*publicKey) };
 }
+
+struct TWDataVector *_Nonnull TWHDWalletGetAddressesFromExtended(TWString *_Nonnull extended, enum TWCoinType coin, enum TWDerivation derivation, uint32_t change, uint32_t firstIndex, uint32_t count, uint32_t threads) {
+    try {
+        const auto addresses = HDWallet::deriveAddressesFromExtended(*reinterpret_cast<const std::string*>(extended), coin, derivation, change, firstIndex, count, addressThreads(threads));
+        return createTWDataVector(addresses);
+    } catch (...) {
+        return TWDataVectorCreate();
+    }
+}
@@ -12,6 +12,8 @@
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/secp256k1.h>
 
+#include <algorithm>
+
 using TW::PublicKey;
 
 struct TWPublicKey *_Nullable TWPublicKeyCreateWithData(TWData *_Nonnull data, enum TWPublicKeyType type) {
@@ -54,6 +56,45 @@ bool TWPublicKeyVerify(struct TWPublicKey *_Nonnull pk, TWData *_Nonnull signatu
     return pk->impl.verify(s, m);
 }
 
+TWData *_Nullable TWPublicKeyVerifyBatch(const struct TWDataVector *_Nonnull publicKeys, enum TWPublicKeyType type, const struct TWDataVector *_Nonnull signatures, const struct TWDataVector *_Nonnull messages) {
+    const auto count = TWDataVectorSize(publicKeys);
+    if (TWDataVectorSize(signatures) != count || TWDataVectorSize(messages) != count) {
+        return nullptr;
+    }
+    const auto get = [](const struct TWDataVector* _Nonnull dataVector, size_t i) {
+        auto elem = TWDataVectorGet(dataVector, i);
+        auto ret = *reinterpret_cast<const TW::Data*>(elem);
+        TWDataDelete(elem);
+        return ret;
+    };
+
+    // signatures with an invalid public key fail without being verified
+    std::vector<PublicKey> keys;
+    std::vector<TW::Data> sigs;
+    std::vector<TW::Data> msgs;
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < count; ++i) {
+        const auto keyData = get(publicKeys, i);
+        if (!PublicKey::isValid(keyData, type)) {
+            continue;
+        }
+        keys.emplace_back(keyData, type);
+        sigs.push_back(get(signatures, i));
+        msgs.push_back(get(messages, i));
+        positions.push_back(i);
+    }
+    auto results = TW::Data(count, 0);
+    try {
+        const auto verified = PublicKey::verifyBatch(keys, sigs, msgs);
+        for (size_t j = 0; j < positions.size(); ++j) {
+            results[positions[j]] = verified[j] ? 1 : 0;
+        }
+    } catch (...) {
+        return nullptr;
+    }
+    return TWDataCreateWithBytes(results.data(), results.size());
+}
+
 bool TWPublicKeyVerifyAsDER(struct TWPublicKey *_Nonnull pk, TWData *_Nonnull signature, TWData *message) {
     const auto& s = *reinterpret_cast<const TW::Data *>(signature);
     const auto& m = *reinterpret_cast<const TW::Data *>(message);
@@ -13,6 +13,10 @@
 #include "proto/Bitcoin.pb.h"
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <random>
 #include <sstream>
 
 using namespace TW;
@@ -506,3 +510,130 @@ TEST(BitcoinInputSelector, ManyUtxos_MaxAmount_5000) {
     EXPECT_EQ(subsetSum, 1'250'244'500);
     EXPECT_TRUE(verifySelectedUTXOs(selected, subset));
 }
+
+/// Reference implementation of InputSelector::select, trying all windows of sorted UTXOs explicitly.
+std::vector<int64_t> selectAllWindows(const std::vector<int64_t>& amounts, int64_t targetValue, int64_t byteFee, int64_t numOutputs = 2) {
+    const auto& feeCalculator = getFeeCalculator(TWCoinTypeBitcoin);
+    const int64_t dustThreshold = feeCalculator.calculateSingleInput(byteFee);
+    auto sorted = amounts;
+    std::sort(sorted.begin(), sorted.end());
+    const auto filterDust = [dustThreshold](std::vector<int64_t> window) {
+        window.erase(std::remove_if(window.begin(), window.end(), [dustThreshold](int64_t a) { return a <= dustThreshold; }), window.end());
+        return window;
+    };
+    const auto n = sorted.size();
+    // 1. closest to 2x, without dust change
+    for (size_t k = 1; k <= n; ++k) {
+        const int64_t target = targetValue + feeCalculator.calculate(k, numOutputs, byteFee) + dustThreshold;
+        std::optional<std::vector<int64_t>> best;
+        int64_t bestDist = 0;
+        for (size_t start = 0; start + k <= n; ++start) {
+            const std::vector<int64_t> window(sorted.begin() + start, sorted.begin() + start + k);
+            const auto sum = std::accumulate(window.begin(), window.end(), int64_t(0));
+            const auto dist = std::abs(sum - 2 * targetValue);
+            if (sum >= target && (!best.has_value() || dist < bestDist)) {
+                best = window;
+                bestDist = dist;
+            }
+        }
+        if (best.has_value()) {
+            return filterDust(best.value());
+        }
+    }
+    // 2. first sufficient
+    for (size_t k = 1; k <= n; ++k) {
+        const int64_t target = targetValue + feeCalculator.calculate(k, numOutputs, byteFee);
+        for (size_t start = 0; start + k <= n; ++start) {
+            const std::vector<int64_t> window(sorted.begin() + start, sorted.begin() + start + k);
+            if (std::accumulate(window.begin(), window.end(), int64_t(0)) >= target) {
+                return filterDust(window);
+            }
+        }
+    }
+    return {};
+}
+
+TEST(BitcoinInputSelector, SelectMatchesAllWindows) {
+    std::mt19937 random(42);
+    for (int round = 0; round < 300; ++round) {
+        const auto n = 1 + random() % 40;
+        std::vector<int64_t> amounts;
+        for (size_t i = 0; i < n; ++i) {
+            // few distinct values, to also exercise windows with equal sums
+            amounts.push_back(1000 * (1 + random() % (round % 2 == 0 ? 8 : 200)));
+        }
+        const auto total = std::accumulate(amounts.begin(), amounts.end(), int64_t(0));
+        const int64_t target = 1 + random() % total;
+        const int64_t byteFee = random() % 3;
+
+        auto selector = InputSelector<UTXO>(buildTestUTXOs(amounts));
+        const auto selected = selector.select(target, byteFee);
+        EXPECT_TRUE(verifySelectedUTXOs(selected, selectAllWindows(amounts, target, byteFee)))
+            << "round " << round << " target " << target << " byteFee " << byteFee;
+    }
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundExactMatch) {
+    auto utxos = buildTestUTXOs({4000, 2000, 6000, 1000, 11000, 12000});
+
+    // effective values (amount - 102): 3898, 1898, 5898, 898, 10898, 11898
+    // target: 9755 + 41 (fee of one output) = 5898 + 3898
+    auto selector = InputSelector<UTXO>(utxos);
+    auto selected = selector.selectBranchAndBound(9755, 1);
+
+    EXPECT_TRUE(verifySelectedUTXOs(selected, {6000, 4000}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundWithinCostOfChange) {
+    auto utxos = buildTestUTXOs({4000, 2000, 6000, 1000, 11000, 12000});
+
+    // target 9700 + 41, excess 55 is below the cost of change (31 + 102)
+    auto selector = InputSelector<UTXO>(utxos);
+    auto selected = selector.selectBranchAndBound(9700, 1);
+
+    EXPECT_TRUE(verifySelectedUTXOs(selected, {6000, 4000}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundNoMatch) {
+    auto utxos = buildTestUTXOs({10000, 20000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(12000, 1), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(40000, 1), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(0, 1), {}));
+}
+
+TEST(BitcoinInputSelector, SelectBranchAndBoundIterationLimit) {
+    auto utxos = buildTestUTXOs({4000, 2000, 6000, 1000, 11000, 12000});
+
+    auto selector = InputSelector<UTXO>(utxos);
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(9755, 1, 1, 2), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(9755, 1, 1, 100), {6000, 4000}));
+}
+
+TEST(BitcoinInputSelector, SelectCandidates) {
+    auto utxos = buildTestUTXOs({5000, 100, 3000, 9000, 3000, 7000, 50});
+    const auto value = [](const UTXO& utxo) { return utxo.amount - 1000; };
+
+    auto candidates = InputSelector<UTXO>::selectCandidates(utxos, 3, value);
+    EXPECT_TRUE(verifySelectedUTXOs(candidates.inputs, {5000, 9000, 7000}));
+    EXPECT_EQ(candidates.dustCount, 2);
+    EXPECT_EQ(candidates.truncatedCount, 2);
+    EXPECT_EQ(candidates.truncatedAmount, 6000);
+
+    // on equal value, the earlier is kept
+    candidates = InputSelector<UTXO>::selectCandidates(utxos, 4, value);
+    EXPECT_TRUE(verifySelectedUTXOs(candidates.inputs, {5000, 3000, 9000, 7000}));
+    EXPECT_EQ(candidates.truncatedCount, 1);
+    EXPECT_EQ(candidates.truncatedAmount, 3000);
+
+    candidates = InputSelector<UTXO>::selectCandidates(utxos, 10, value);
+    EXPECT_TRUE(verifySelectedUTXOs(candidates.inputs, {5000, 3000, 9000, 3000, 7000}));
+    EXPECT_EQ(candidates.dustCount, 2);
+    EXPECT_EQ(candidates.truncatedCount, 0);
+
+    candidates = InputSelector<UTXO>::selectCandidates(utxos, 0, value);
+    EXPECT_TRUE(verifySelectedUTXOs(candidates.inputs, {}));
+    EXPECT_EQ(candidates.truncatedCount, 5);
+    EXPECT_EQ(candidates.truncatedAmount, 27000);
+}
@@ -0,0 +1,236 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/OpCodes.h"
+#include "Bitcoin/Script.h"
+#include "Bitcoin/SignatureBuilder.h"
+#include "Bitcoin/SigHashType.h"
+#include "Bitcoin/SizeEstimator.h"
+#include "Bitcoin/Transaction.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+const auto key0 = PrivateKey(parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866"));
+const auto key1 = PrivateKey(parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9"));
+const auto key2 = PrivateKey(parse_hex("eb696a065ef48a2192da5b28b694f87544b30fae8327c4510137a922f32c6dcf"));
+
+Data pubKey(const PrivateKey& key) {
+    return key.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
+}
+
+Data pubKeyHash(const PrivateKey& key) {
+    return Hash::sha256ripemd(pubKey(key).data(), PublicKey::secp256k1Size);
+}
+
+Script multisig2of3() {
+    Script script;
+    script.bytes.push_back(OP_2);
+    for (const auto& key : {key0, key1, key2}) {
+        script.bytes.push_back(PublicKey::secp256k1Size);
+        append(script.bytes, pubKey(key));
+    }
+    script.bytes.push_back(OP_3);
+    script.bytes.push_back(OP_CHECKMULTISIG);
+    return script;
+}
+
+SigningInput buildInput(const std::vector<Script>& scripts, bool withKeys = true) {
+    SigningInput input;
+    input.hashType = hashTypeForCoin(TWCoinTypeBitcoin);
+    input.amount = 10'000;
+    input.byteFee = 1;
+    input.toAddress = "bc1q2dsdlq3343vk29runkgv4yc292hmq53jedfjmp";
+    input.changeAddress = "1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU";
+    input.coinType = TWCoinTypeBitcoin;
+    if (withKeys) {
+        input.privateKeys = {key0, key1, key2};
+    }
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        UTXO utxo;
+        utxo.script = scripts[i];
+        utxo.amount = 100'000;
+        utxo.outPoint = OutPoint(parse_hex("1e0f8c0d0bf9a4b95ac4c9ae8e3f9a7d22c3b0b8dbd1d1b2a0c8a7f6e5d4c3b2"), static_cast<uint32_t>(i), UINT32_MAX);
+        input.utxos.push_back(utxo);
+    }
+    return input;
+}
+
+/// Virtual size of the transaction signed in size-estimation mode, measured from its encoding
+uint64_t signedVirtualSize(const SigningInput& input, bool hasChange) {
+    TransactionPlan plan;
+    plan.utxos = input.utxos;
+    plan.availableAmount = InputSelector<UTXO>::sum(plan.utxos);
+    plan.amount = plan.availableAmount - (hasChange ? 20'000 : 0);
+    plan.change = hasChange ? 20'000 : 0;
+    plan.outputOpReturn = input.outputOpReturn;
+    auto inputWithPlan = input;
+    inputWithPlan.plan = plan;
+
+    auto result = TransactionSigner<Transaction, TransactionBuilder>::sign(inputWithPlan, SigningMode_SizeEstimationOnly);
+    EXPECT_TRUE(result);
+    const auto transaction = result.payload();
+    Data dataNonSegwit;
+    transaction.encode(dataNonSegwit, Transaction::SegwitFormatMode::NonSegwit);
+    if (!transaction.hasWitness()) {
+        return dataNonSegwit.size();
+    }
+    Data dataWitness;
+    transaction.encodeWitness(dataWitness);
+    const auto witnessSize = 2 + dataWitness.size();
+    return dataNonSegwit.size() + witnessSize / 4 + (witnessSize % 4 != 0);
+}
+
+void expectMatchesSigner(const SigningInput& input) {
+    for (const auto hasChange : {false, true}) {
+        const auto vSize = SizeEstimator(input).virtualSize(input.utxos, hasChange);
+        ASSERT_TRUE(vSize.has_value());
+        EXPECT_EQ(vSize.value(), signedVirtualSize(input, hasChange));
+    }
+}
+
+} // namespace
+
+TEST(BitcoinSizeEstimator, P2WPKH) {
+    const auto script = Script::buildPayToWitnessPublicKeyHash(pubKeyHash(key0));
+    expectMatchesSigner(buildInput({script}));
+    expectMatchesSigner(buildInput({script, script, script}));
+    expectMatchesSigner(buildInput({script, script}, false));
+
+    const auto input = buildInput({script});
+    EXPECT_EQ(SizeEstimator(input).virtualSize(input.utxos, true).value(), 144);
+    const auto inputSize = SizeEstimator(input).inputSize(script).value();
+    EXPECT_EQ(inputSize.scriptSig, 0);
+    EXPECT_EQ(inputSize.witness, 108);
+    EXPECT_TRUE(inputSize.hasWitness);
+}
+
+TEST(BitcoinSizeEstimator, P2PKH) {
+    const auto script = Script::buildPayToPublicKeyHash(pubKeyHash(key1));
+    expectMatchesSigner(buildInput({script}));
+    expectMatchesSigner(buildInput({script, script}, false));
+
+    const auto input = buildInput({script});
+    const auto inputSize = SizeEstimator(input).inputSize(script).value();
+    EXPECT_EQ(inputSize.scriptSig, 107);
+    EXPECT_FALSE(inputSize.hasWitness);
+
+    // spent with the uncompressed public key
+    const auto extendedKey = key2.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes;
+    const auto uncompressed = Script::buildPayToPublicKeyHash(Hash::sha256ripemd(extendedKey.data(), extendedKey.size()));
+    expectMatchesSigner(buildInput({uncompressed, script}));
+    EXPECT_EQ(SizeEstimator(input).inputSize(uncompressed).value().scriptSig, 139);
+    EXPECT_EQ(SizeEstimator(buildInput({}, false)).inputSize(uncompressed).value().scriptSig, 107);
+}
+
+TEST(BitcoinSizeEstimator, P2PK) {
+    expectMatchesSigner(buildInput({Script::buildPayToPublicKey(pubKey(key2))}));
+}
+
+TEST(BitcoinSizeEstimator, P2SHP2WPKH) {
+    const auto redeemScript = Script::buildPayToWitnessPublicKeyHash(pubKeyHash(key0));
+    const auto scriptHash = Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size());
+    auto input = buildInput({Script::buildPayToScriptHash(scriptHash)});
+    input.scripts[hex(scriptHash)] = redeemScript;
+    expectMatchesSigner(input);
+
+    const auto inputSize = SizeEstimator(input).inputSize(input.utxos[0].script).value();
+    EXPECT_EQ(inputSize.scriptSig, 23);
+    EXPECT_EQ(inputSize.witness, 108);
+}
+
+TEST(BitcoinSizeEstimator, P2SHMultisig) {
+    const auto redeemScript = multisig2of3();
+    const auto scriptHash = Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size());
+    auto input = buildInput({Script::buildPayToScriptHash(scriptHash)});
+    input.scripts[hex(scriptHash)] = redeemScript;
+    expectMatchesSigner(input);
+}
+
+TEST(BitcoinSizeEstimator, P2WSHMultisig) {
+    const auto witnessScript = multisig2of3();
+    const auto witnessProgram = Hash::sha256(witnessScript.bytes);
+    auto input = buildInput({Script::buildPayToWitnessScriptHash(witnessProgram)});
+    input.scripts[hex(Hash::ripemd(witnessProgram))] = witnessScript;
+    expectMatchesSigner(input);
+
+    // nested in P2SH
+    const auto redeemScript = Script::buildPayToWitnessScriptHash(witnessProgram);
+    const auto scriptHash = Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size());
+    input.utxos.push_back(input.utxos[0]);
+    input.utxos[1].script = Script::buildPayToScriptHash(scriptHash);
+    input.scripts[hex(scriptHash)] = redeemScript;
+    expectMatchesSigner(input);
+}
+
+TEST(BitcoinSizeEstimator, BareMultisig) {
+    expectMatchesSigner(buildInput({multisig2of3()}, false));
+}
+
+TEST(BitcoinSizeEstimator, MixedWithOpReturn) {
+    const auto p2wpkh = Script::buildPayToWitnessPublicKeyHash(pubKeyHash(key0));
+    const auto p2pkh = Script::buildPayToPublicKeyHash(pubKeyHash(key1));
+    auto input = buildInput({p2pkh, p2wpkh, p2pkh, p2wpkh});
+    input.outputOpReturn = data("memo");
+    expectMatchesSigner(input);
+
+    input.outputOpReturn = Data(100, 0x42);
+    expectMatchesSigner(input);
+}
+
+TEST(BitcoinSizeEstimator, ManyInputs) {
+    const auto p2wpkh = Script::buildPayToWitnessPublicKeyHash(pubKeyHash(key0));
+    const auto p2pkh = Script::buildPayToPublicKeyHash(pubKeyHash(key1));
+    std::vector<Script> scripts;
+    for (auto i = 0; i < 300; ++i) {
+        scripts.push_back(i % 3 == 0 ? p2pkh : p2wpkh);
+    }
+    expectMatchesSigner(buildInput(scripts, false));
+}
+
+TEST(BitcoinSizeEstimator, HashTypeSingle) {
+    const auto script = Script::buildPayToWitnessPublicKeyHash(pubKeyHash(key0));
+    auto input = buildInput({script, script, script});
+    input.hashType = TWBitcoinSigHashTypeSingle;
+    expectMatchesSigner(input);
+}
+
+TEST(BitcoinSizeEstimator, P2TR) {
+    const auto script = Script::buildPayToV1WitnessProgram(parse_hex("a60869f0dbcf1dc659c9cecbaf8050135ea9e8cdc487053f1dc6880949dc684c"));
+    const auto input = buildInput({script});
+    const auto inputSize = SizeEstimator(input).inputSize(script).value();
+    EXPECT_EQ(inputSize.scriptSig, 0);
+    EXPECT_EQ(inputSize.witness, 66);
+    EXPECT_EQ(SizeEstimator(input).virtualSize(input.utxos, false).value(), 99);
+}
+
+TEST(BitcoinSizeEstimator, Unsignable) {
+    // missing redeem script
+    const auto redeemScript = multisig2of3();
+    const auto scriptHash = Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size());
+    const auto input = buildInput({Script::buildPayToScriptHash(scriptHash)});
+    EXPECT_FALSE(SizeEstimator(input).inputSize(input.utxos[0].script).has_value());
+    EXPECT_FALSE(SizeEstimator(input).virtualSize(input.utxos, false).has_value());
+
+    // unknown witness program
+    const auto witnessV2 = Script(parse_hex("5210751e76e8199196d454941c45d1b3a323"));
+    EXPECT_FALSE(SizeEstimator(input).inputSize(witnessV2).has_value());
+
+    // invalid destination
+    auto invalidAddress = buildInput({Script::buildPayToWitnessPublicKeyHash(pubKeyHash(key0))});
+    invalidAddress.toAddress = "invalid";
+    EXPECT_FALSE(SizeEstimator(invalidAddress).virtualSize(invalidAddress.utxos, false).has_value());
+    EXPECT_FALSE(SizeEstimator(input).virtualSize({}, false).has_value());
+}
@@ -652,6 +652,86 @@ TEST(TransactionPlan, ManyUtxosMax_5000_simple) {
     EXPECT_EQ(filteredValues.size(), 3000);
     EXPECT_EQ(filteredValueSum, 454'350'000);
     EXPECT_TRUE(verifyPlan(txPlan, filteredValues, 449'909'560, 4'440'440));
+    // the cut off UTXOs are reported
+    EXPECT_EQ(txPlan.truncatedUtxoCount, 1986);
+    EXPECT_EQ(txPlan.truncatedAmount, 795'889'500);
+    EXPECT_EQ(txPlan.dustUtxoCount, 0);
+}
+
+TEST(TransactionPlan, ManyUtxosMax_5000_candidateLimit) {
+    const auto n = 5000;
+    const auto byteFee = 10;
+    std::vector<int64_t> values;
+    for (int i = 0; i < n; ++i) {
+        values.push_back((i + 1) * 100);
+    }
+
+    auto utxos = buildTestUTXOs(values);
+    auto sigingInput = buildSigningInput(0, byteFee, utxos, true, TWCoinTypeRavencoin);
+    sigingInput.maxCandidateUtxos = 4000;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    // the 4000 largest are selected, beyond the fixed limit of 3000
+    const std::vector<int64_t> largest(values.end() - 4000, values.end());
+    EXPECT_EQ(sumUTXOs(buildTestUTXOs(largest)), 1'200'200'000);
+    EXPECT_TRUE(verifyPlan(txPlan, largest, 1'194'279'560, 5'920'440));
+    // 14 up to the dust limit of 1480, and the 986 after them are left out
+    EXPECT_EQ(txPlan.dustUtxoCount, 14);
+    EXPECT_EQ(txPlan.truncatedUtxoCount, 986);
+    EXPECT_EQ(txPlan.truncatedAmount, 50'039'500);
+
+    const auto proto = txPlan.proto();
+    EXPECT_EQ(proto.dust_utxo_count(), 14);
+    EXPECT_EQ(proto.truncated_utxo_count(), 986);
+    EXPECT_EQ(proto.truncated_amount(), 50'039'500);
+}
+
+TEST(TransactionPlan, ManyUtxosNonmax_100000_candidateLimit) {
+    const auto n = 100'000;
+    const auto byteFee = 1;
+    std::vector<int64_t> values;
+    for (int i = 0; i < n; ++i) {
+        // mostly small UTXOs, some dust
+        values.push_back(50 + (i * 7919) % 20'000);
+    }
+
+    auto utxos = buildTestUTXOs(values);
+    auto sigingInput = buildSigningInput(2'000'000, byteFee, utxos);
+    sigingInput.maxCandidateUtxos = 500;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    EXPECT_EQ(txPlan.error, Common::Proto::OK);
+    EXPECT_GT(txPlan.utxos.size(), 0);
+    EXPECT_LE(txPlan.utxos.size(), 500);
+    EXPECT_EQ(txPlan.amount, 2'000'000);
+    EXPECT_EQ(txPlan.amount + txPlan.fee + txPlan.change, txPlan.availableAmount);
+    EXPECT_EQ(txPlan.dustUtxoCount + txPlan.truncatedUtxoCount, n - 500);
+    // only the largest are candidates
+    for (const auto& utxo : txPlan.utxos) {
+        EXPECT_GE(utxo.amount, 19'000);
+    }
+}
+
+TEST(TransactionPlan, CandidateLimitEffectiveValue) {
+    // same amounts, the P2WPKH UTXO is cheaper to spend than the P2PKH one
+    auto utxos = buildTestUTXOs({50'000, 50'000});
+    utxos[0].script = Script::buildPayToPublicKeyHash(parse_hex("1d0f172a0ecb48aee1be1f2687d2963ae33f71a1"));
+    auto sigingInput = buildSigningInput(10'000, 1, utxos);
+    sigingInput.maxCandidateUtxos = 1;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+    ASSERT_EQ(txPlan.utxos.size(), 1);
+    EXPECT_EQ(txPlan.utxos[0].script, utxos[0].script);
+    EXPECT_EQ(txPlan.truncatedUtxoCount, 1);
+
+    sigingInput.candidateOrdering = Proto::CandidateOrderingEffectiveValue;
+    txPlan = TransactionBuilder::plan(sigingInput);
+    ASSERT_EQ(txPlan.utxos.size(), 1);
+    EXPECT_EQ(txPlan.utxos[0].script, utxos[1].script);
+    EXPECT_EQ(txPlan.truncatedUtxoCount, 1);
+    EXPECT_EQ(txPlan.truncatedAmount, 50'000);
 }
 
 TEST(TransactionPlan, OpReturn) {
@@ -688,3 +768,29 @@ TEST(TransactionPlan, OpReturn) {
     EXPECT_EQ(feeCalculator.calculate(1, 2, byteFee), 174 * byteFee);
     EXPECT_EQ(feeCalculator.calculate(1, 3, byteFee), 205 * byteFee);
 }
+
+TEST(TransactionPlan, BranchAndBoundChangeless) {
+    auto utxos = buildTestUTXOs({4000, 2000, 6000, 1000, 11000, 12000});
+    auto sigingInput = buildSigningInput(9755, 1, utxos);
+    sigingInput.inputSelection = Proto::InputSelectionBranchAndBound;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    // no change, the remainder is fee
+    EXPECT_TRUE(verifyPlan(txPlan, {6000, 4000}, 9755, 245));
+    EXPECT_EQ(txPlan.change, 0);
+}
+
+TEST(TransactionPlan, BranchAndBoundFallback) {
+    auto utxos = buildTestUTXOs({4000, 2000, 6000, 1000, 11000, 12000});
+    auto sigingInput = buildSigningInput(5000, 1, utxos);
+    sigingInput.inputSelection = Proto::InputSelectionBranchAndBound;
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    // no changeless match, same as default selection
+    sigingInput.inputSelection = Proto::InputSelectionDefault;
+    auto defaultPlan = TransactionBuilder::plan(sigingInput);
+    EXPECT_TRUE(verifyPlan(txPlan, {11000}, 5000, defaultPlan.fee));
+    EXPECT_GT(txPlan.change, 0);
+}
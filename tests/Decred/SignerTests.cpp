@@ -120,6 +120,31 @@ TEST(DecredSigner, SignP2PKH) {
     EXPECT_EQ(hex(encoded), expectedEncoded);
 }
 
+TEST(DecredSigner, SigHashCache) {
+    auto transaction = Transaction();
+    transaction.inputs.emplace_back();
+    transaction.inputs[0].previousOutput = OutPoint(parse_hex("0ff6ff7c6774a56ccc51598b11724c9c441cadc52978ddb5f08f3511a0cc777a"), 0, 0);
+    transaction.inputs.emplace_back();
+    transaction.inputs[1].previousOutput = OutPoint(parse_hex("fdbfe9dd703f306794a467f175be5bd9748a7925033ea1cf9889d7cf4dd11550"), 2, 0);
+    transaction.inputs[1].sequence = 0xfffffffe;
+    transaction.outputs.emplace_back();
+    transaction.outputs[0].value = 100'000'000;
+    transaction.outputs[0].script = Bitcoin::Script(parse_hex("76a914f5eba6730a4052ba3171e5f1a4b2ae6b3e09c29b88ac"));
+    transaction.outputs.emplace_back();
+    transaction.outputs[1].value = 2'000'000;
+    transaction.outputs[1].script = Bitcoin::Script(parse_hex("76a914a75a6a2b3fdc98a1d4ad1bd4c1e56eb01e9a1f8788ac"));
+
+    const auto cache = transaction.getSigHashCache();
+    const auto scriptCode = Bitcoin::Script(parse_hex("76a914f5eba6730a4052ba3171e5f1a4b2ae6b3e09c29b88ac"));
+    for (auto hashType : {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeNone, TWBitcoinSigHashTypeSingle,
+                          TWBitcoinSigHashType(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)}) {
+        for (size_t index = 0; index < transaction.inputs.size(); ++index) {
+            EXPECT_EQ(hex(transaction.computeSignatureHash(scriptCode, index, hashType, &cache)),
+                      hex(transaction.computeSignatureHash(scriptCode, index, hashType)));
+        }
+    }
+}
+
 TEST(DecredSigner, SignP2SH) {
     const auto privateKey = PrivateKey(parse_hex("22a47fa09a223f2aa079edf85a7c2d4f8720ee63e502ee2869afab7de234b80c"));
     const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
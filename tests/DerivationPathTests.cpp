@@ -41,6 +41,24 @@ TEST(DerivationPath, InitWithString) {
 TEST(DerivationPath, InitInvalid) {
     ASSERT_THROW(DerivationPath("a/b/c"), std::invalid_argument);
     ASSERT_THROW(DerivationPath("m/44'/60''/"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/44'/-60'"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/44'/ 60'"), std::invalid_argument);
+    ASSERT_THROW(DerivationPath("m/44'/4294967296'"), std::invalid_argument);
+}
+
+TEST(DerivationPath, MaxDepth) {
+    const auto deepest = "m/0/1/2/3/4/5/6/7/8/4294967295'";
+    const auto path = DerivationPath(deepest);
+    ASSERT_EQ(path.indices.size(), DerivationPathIndices::maxDepth);
+    EXPECT_EQ(path.indices.back(), DerivationPathIndex(UINT32_MAX, /* hardened: */ true));
+    EXPECT_EQ(path.string(), deepest);
+
+    ASSERT_THROW(DerivationPath("m/0/1/2/3/4/5/6/7/8/9/10"), std::invalid_argument);
+    auto indices = path.indices;
+    ASSERT_THROW(indices.emplace_back(10), std::invalid_argument);
+
+    const auto longest = DerivationPath(std::vector<DerivationPathIndex>(DerivationPathIndices::maxDepth, DerivationPathIndex(UINT32_MAX)));
+    EXPECT_EQ(longest.string().size(), DerivationPath::maxStringSize);
 }
 
 TEST(DerivationPath, IndexOutOfBounds) {
@@ -64,6 +82,8 @@ TEST(DerivationPath, IndexOutOfBounds) {
 TEST(DerivationPath, String) {
     const auto path = DerivationPath("m/44'/60'/0'/0/0");
     ASSERT_EQ(path.string(), "m/44'/60'/0'/0/0");
+    ASSERT_EQ(DerivationPath().string(), "m");
+    ASSERT_EQ(DerivationPath("m/0/2147483648").string(), "m/0/2147483648");
 }
 
 TEST(DerivationPath, Equal) {
@@ -94,4 +114,22 @@ TEST(Derivation, alternativeDerivation) {
     EXPECT_EQ(std::string(TW::derivationName(TWCoinTypeSolana, TWDerivationSolanaSolana)), "solana");
 }
 
+TEST(Derivation, preparsedPaths) {
+    for (const auto coin : getCoinTypes()) {
+        const auto& info = getCoinInfo(coin);
+        ASSERT_GT(info.derivationCount, 0ul);
+        EXPECT_EQ(&info.defaultDerivation(), &info.derivations[0]);
+        for (size_t i = 0; i < info.derivationCount; ++i) {
+            const auto& derivation = info.derivations[i];
+            EXPECT_EQ(derivation.derivationPath(), DerivationPath(derivation.path)) << derivation.path;
+            EXPECT_EQ(TW::derivationPath(coin, derivation.name).string(), derivation.path);
+        }
+        EXPECT_EQ(&getCoinInfo(coin), &info);
+    }
+
+    const auto& missing = getCoinInfo(static_cast<TWCoinType>(0x7fffffff));
+    EXPECT_EQ(std::string(missing.id), "?");
+    EXPECT_EQ(missing.defaultDerivation().derivationPath(), DerivationPath());
+}
+
 } // namespace
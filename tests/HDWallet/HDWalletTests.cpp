@@ -18,6 +18,9 @@
 #include "../interface/TWTestUtilities.h"
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 extern std::string TESTS_ROOT;
 
@@ -104,17 +107,32 @@ TEST(HDWallet, entropyLength_createFromMnemonic) {
 
 TEST(HDWallet, createFromSpanishMnemonic) {
     {
-        EXPECT_EXCEPTION(HDWallet("llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut", ""), "Invalid mnemonic");
+        HDWallet wallet = HDWallet("llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut", "");
+        EXPECT_EQ(wallet.getMnemonic(), "llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut");
+        EXPECT_EQ(wallet.getPassphrase(), "");
+        EXPECT_EQ(hex(wallet.getEntropy()), "81d8185b64f0371457198b43c22b6c43");
+        EXPECT_EQ(hex(wallet.getSeed()), "ec8f8703432fc7d32e699ee056e9d84b1435e6a64a6a40ad63dbde11eab189a276ddcec20f3326d3c6ee39cbd018585b104fc3633b801c011063ae4c318fb9b6");
     }
     {
         HDWallet wallet = HDWallet("llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut", "", false);
-        EXPECT_EQ(wallet.getMnemonic(), "llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut");
-        EXPECT_EQ(wallet.getPassphrase(), "");
-        EXPECT_EQ(hex(wallet.getEntropy()), "");
+        EXPECT_EQ(hex(wallet.getEntropy()), "81d8185b64f0371457198b43c22b6c43");
         EXPECT_EQ(hex(wallet.getSeed()), "ec8f8703432fc7d32e699ee056e9d84b1435e6a64a6a40ad63dbde11eab189a276ddcec20f3326d3c6ee39cbd018585b104fc3633b801c011063ae4c318fb9b6");
     }
 }
 
+TEST(HDWallet, createFromJapaneseMnemonic) {
+    // composed, separated by ideographic spaces; checked mnemonics are kept and seeded in NFKD form
+    const std::string mnemonic = "あいこくしん　たきび　たまご　たおれる　こんかい　くしゃみ　おさえる　きのう　ねんまつ　しほう　せんゆう　わかれる";
+    HDWallet wallet = HDWallet(mnemonic, "");
+    EXPECT_EQ(wallet.getMnemonic(), "あいこくしん たきび たまご たおれる こんかい くしゃみ おさえる きのう ねんまつ しほう せんゆう わかれる");
+    EXPECT_EQ(hex(wallet.getEntropy()), "00112233445566778899aabbccddeeff");
+    EXPECT_EQ(hex(wallet.getSeed()), "194f622101e01567f7b0e21d072186c8f2467840a1921ba3a67ca7774f735503740bcf3f0414556ebe3c7101b8fa4395d2aff0d29b5f2749f2e74acc1cbaf05f");
+
+    const auto wallets = HDWallet::fromMnemonics({mnemonic}, "");
+    EXPECT_EQ(wallets[0].getMnemonic(), wallet.getMnemonic());
+    EXPECT_EQ(hex(wallets[0].getSeed()), "194f622101e01567f7b0e21d072186c8f2467840a1921ba3a67ca7774f735503740bcf3f0414556ebe3c7101b8fa4395d2aff0d29b5f2749f2e74acc1cbaf05f");
+}
+
 TEST(HDWallet, createFromMnemonicInvalid) {
     EXPECT_EXCEPTION(HDWallet("THIS IS AN INVALID MNEMONIC", passphrase), "Invalid mnemonic");
     EXPECT_EXCEPTION(HDWallet("", passphrase), "Invalid mnemonic");
@@ -286,6 +304,33 @@ TEST(HDWallet, Bip39Vectors) {
     }
 }
 
+TEST(HDWallet, FromMnemonics) {
+    const auto passphrase = "TREZOR";
+    const auto vectors = getVectors();
+    // 4 seeds at a time, with a partial last group
+    std::vector<std::string> mnemonics;
+    for (size_t i = 0; i < 23; ++i) {
+        mnemonics.push_back(vectors[i][1]);
+    }
+    const auto wallets = HDWallet::fromMnemonics(mnemonics, passphrase);
+    ASSERT_EQ(wallets.size(), mnemonics.size());
+    for (size_t i = 0; i < wallets.size(); ++i) {
+        const auto& v = vectors[i];
+        EXPECT_EQ(wallets[i].getMnemonic(), mnemonics[i]);
+        EXPECT_EQ(wallets[i].getPassphrase(), passphrase);
+        EXPECT_EQ(hex(wallets[i].getEntropy()), v[0]);
+        EXPECT_EQ(hex(wallets[i].getSeed()), v[2]);
+        EXPECT_EQ(wallets[i].getRootKey(TWCoinTypeBitcoin, TWHDVersionXPRV), v[3]);
+    }
+
+    const auto single = HDWallet::fromMnemonics({mnemonic1}, "");
+    ASSERT_EQ(single.size(), 1ul);
+    EXPECT_EQ(single[0].getSeed(), HDWallet(mnemonic1, "").getSeed());
+    EXPECT_EQ(single[0].deriveAddress(TWCoinTypeEthereum), HDWallet(mnemonic1, "").deriveAddress(TWCoinTypeEthereum));
+    EXPECT_TRUE(HDWallet::fromMnemonics({}, "").empty());
+    EXPECT_THROW(HDWallet::fromMnemonics({mnemonic1, "invalid mnemonic"}, ""), std::invalid_argument);
+}
+
 TEST(HDWallet, getExtendedPrivateKey) {
     const HDWallet wallet = HDWallet(mnemonic1, "");
     const auto purpose = TWPurposeBIP44;
@@ -397,4 +442,146 @@ TEST(HDWallet, Derive_XpubPub_vs_PrivPub) {
     }
 }
 
+TEST(HDWallet, DeriveCached) {
+    // Keys derived with cached intermediate nodes match derivation from the account extended key.
+    // More accounts than the cache capacity, so entries get evicted.
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    const auto coin = TWCoinTypeBitcoin;
+    for (uint32_t account = 0; account < 40; ++account) {
+        const auto zpriv = wallet.getExtendedPrivateKeyAccount(TWPurposeBIP84, coin, TWDerivationDefault, TWHDVersionZPRV, account);
+        for (uint32_t index = 0; index < 4; ++index) {
+            const auto path = DerivationPath(TWPurposeBIP84, coin, account, index % 2, index);
+            const auto expected = HDWallet::getPrivateKeyFromExtended(zpriv, coin, path);
+            ASSERT_TRUE(expected.has_value());
+            EXPECT_EQ(hex(wallet.getKey(coin, path).bytes), hex(expected->bytes));
+        }
+    }
+    // first account again, after eviction
+    EXPECT_EQ(hex(wallet.getKey(coin, DerivationPath("m/84'/0'/0'/0/2")).getPublicKey(TWPublicKeyTypeSECP256k1).bytes),
+              "031e1f64d2f6768dccb6814545b2e2d58e26ad5f91b7cbaffe881ed572c65060db");
+}
+
+TEST(HDWallet, DeriveCachedConcurrently) {
+    const auto coin = TWCoinTypeEthereum;
+    std::vector<std::string> expected;
+    {
+        const HDWallet wallet = HDWallet(mnemonic1, "");
+        for (uint32_t i = 0; i < 40; ++i) {
+            expected.push_back(wallet.deriveAddress(coin) + hex(wallet.getKey(coin, DerivationPath(TWPurposeBIP44, 60, i % 4, 0, i)).bytes));
+        }
+    }
+
+    // threads sharing the cache of a new wallet, each in a different order
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches = 0;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (uint32_t n = 0; n < 40; ++n) {
+                const auto i = (n * 7 + t * 11) % 40;
+                const auto actual = wallet.deriveAddress(coin) + hex(wallet.getKey(coin, DerivationPath(TWPurposeBIP44, 60, i % 4, 0, i)).bytes);
+                if (actual != expected[i]) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST(HDWallet, DeriveAddresses) {
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    for (const auto coin : {TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeCardano, TWCoinTypeAlgorand, TWCoinTypeWaves, TWCoinTypeNEO}) {
+        const auto addresses = wallet.deriveAddresses(coin, TWDerivationDefault, 1, 0, 3, 5);
+        ASSERT_EQ(addresses.size(), 5ul);
+        for (uint32_t i = 0; i < 5; ++i) {
+            auto path = TW::derivationPath(coin);
+            path.indices[2].value = 1;
+            path.indices[4].value = 3 + i;
+            EXPECT_EQ(addresses[i], TW::deriveAddress(coin, wallet.getKey(coin, path)));
+        }
+    }
+
+    const auto bitcoin = wallet.deriveAddresses(TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0, 3);
+    ASSERT_EQ(bitcoin.size(), 3ul);
+    EXPECT_EQ(bitcoin[0], "bc1qpsp72plnsqe6e2dvtsetxtww2cz36ztmfxghpd");
+    EXPECT_EQ(bitcoin[2], "bc1q7zddsunzaftf4zlsg9exhzlkvc5374a6v32jf6");
+    const auto legacy = wallet.deriveAddresses(TWCoinTypeBitcoin, TWDerivationBitcoinLegacy, 0, 0, 0, 1);
+    ASSERT_EQ(legacy.size(), 1ul);
+    EXPECT_EQ(legacy[0], wallet.deriveAddress(TWCoinTypeBitcoin, TWDerivationBitcoinLegacy));
+
+    // no address level in the derivation path
+    EXPECT_TRUE(wallet.deriveAddresses(TWCoinTypeSolana, TWDerivationDefault, 0, 0, 0, 5).empty());
+    // index overflow
+    EXPECT_TRUE(wallet.deriveAddresses(TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0x7fffffff, 2).empty());
+    EXPECT_TRUE(wallet.deriveAddresses(TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0, 0).empty());
+}
+
+TEST(HDWallet, DeriveAddressesHashedTogether) {
+    // Bitcoin-family and EVM key hashes are computed several keys at a time
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    const auto cases = {
+        std::make_pair(TWCoinTypeBitcoin, TWDerivationDefault),
+        std::make_pair(TWCoinTypeBitcoin, TWDerivationBitcoinLegacy),
+        std::make_pair(TWCoinTypeLitecoin, TWDerivationDefault),
+        std::make_pair(TWCoinTypeDogecoin, TWDerivationDefault),
+        std::make_pair(TWCoinTypeBitcoinCash, TWDerivationDefault),
+        std::make_pair(TWCoinTypeEthereum, TWDerivationDefault),
+        std::make_pair(TWCoinTypePolygon, TWDerivationDefault),
+    };
+    for (const auto& [coin, derivation] : cases) {
+        const auto addresses = wallet.deriveAddresses(coin, derivation, 0, 0, 0, 19);
+        ASSERT_EQ(addresses.size(), 19ul);
+        for (uint32_t i = 0; i < 19; ++i) {
+            auto path = TW::derivationPath(coin, derivation);
+            path.indices[4].value = i;
+            EXPECT_EQ(addresses[i], TW::deriveAddress(coin, wallet.getKey(coin, path), derivation)) << coin << " " << i;
+        }
+    }
+}
+
+TEST(HDWallet, DeriveAddressesFromExtended) {
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    const auto coin = TWCoinTypeBitcoin;
+    const auto zpub = wallet.getExtendedPublicKey(TWPurposeBIP84, coin, TWHDVersionZPUB);
+
+    const auto addresses = HDWallet::deriveAddressesFromExtended(zpub, coin, TWDerivationDefault, 1, 10, 20);
+    EXPECT_EQ(addresses, wallet.deriveAddresses(coin, TWDerivationDefault, 0, 1, 10, 20));
+    const auto receive = HDWallet::deriveAddressesFromExtended(zpub, coin, TWDerivationDefault, 0, 0, 3);
+    ASSERT_EQ(receive.size(), 3ul);
+    EXPECT_EQ(receive[0], "bc1qpsp72plnsqe6e2dvtsetxtww2cz36ztmfxghpd");
+    EXPECT_EQ(receive[2], "bc1q7zddsunzaftf4zlsg9exhzlkvc5374a6v32jf6");
+
+    const auto ethereum = HDWallet::deriveAddressesFromExtended(wallet.getExtendedPublicKey(TWPurposeBIP44, TWCoinTypeEthereum, TWHDVersionXPUB), TWCoinTypeEthereum, TWDerivationDefault, 0, 0, 4);
+    EXPECT_EQ(ethereum, wallet.deriveAddresses(TWCoinTypeEthereum, TWDerivationDefault, 0, 0, 0, 4));
+
+    EXPECT_TRUE(HDWallet::deriveAddressesFromExtended("xpub", coin, TWDerivationDefault, 0, 0, 3).empty());
+    // hardened change index
+    EXPECT_TRUE(HDWallet::deriveAddressesFromExtended(zpub, coin, TWDerivationDefault, 0x80000000, 0, 3).empty());
+}
+
+TEST(HDWallet, DeriveAddressesMultipleThreads) {
+    // Same addresses, in the same order, for any number of threads
+    const HDWallet wallet = HDWallet(mnemonic1, "");
+    for (const auto coin : {TWCoinTypeBitcoin, TWCoinTypeAlgorand, TWCoinTypeCardano}) {
+        const auto expected = wallet.deriveAddresses(coin, TWDerivationDefault, 0, 0, 100, 37);
+        ASSERT_EQ(expected.size(), 37ul);
+        for (const size_t threads : {2, 3, 8, 64}) {
+            EXPECT_EQ(wallet.deriveAddresses(coin, TWDerivationDefault, 0, 0, 100, 37, threads), expected);
+        }
+    }
+
+    const auto coin = TWCoinTypeBitcoin;
+    const auto zpub = wallet.getExtendedPublicKey(TWPurposeBIP84, coin, TWHDVersionZPUB);
+    const auto expected = HDWallet::deriveAddressesFromExtended(zpub, coin, TWDerivationDefault, 0, 0, 50);
+    EXPECT_EQ(expected, wallet.deriveAddresses(coin, TWDerivationDefault, 0, 0, 0, 50, 4));
+    for (const size_t threads : {0, 2, 7, 16}) {
+        EXPECT_EQ(HDWallet::deriveAddressesFromExtended(zpub, coin, TWDerivationDefault, 0, 0, 50, threads), expected);
+    }
+    EXPECT_TRUE(HDWallet::deriveAddressesFromExtended(zpub, coin, TWDerivationDefault, 0, 0, 0, 4).empty());
+}
+
 } // namespace
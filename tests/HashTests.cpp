@@ -9,6 +9,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 using namespace std;
 using namespace TW;
 
@@ -93,4 +97,111 @@ TEST(HashTests, allHashEnum) {
     }
 }
 
+TEST(HashTests, ContextMatchesOneShot) {
+    const auto message = TW::data(brownFox + brownFoxDot + brownFox + brownFoxDot);
+    // known answers where independently computed, otherwise the trezor one-shot functions,
+    // and composites spelled out from those, so that none of them goes through Hash::Context
+    const auto sha256 = parse_hex("efeabfb6cec275c59ca5a5e54ee9b2ad94a80f08c8d3f7fe38e8f40c054b5425");
+    const auto sha3_256 = parse_hex("a283af5fc56418d95fbc7a5386240840c1f337f00b33df0e57a008a727a9f0d1");
+    const auto blake256 = Hash::blake256(message);
+    const auto groestl512 = Hash::groestl512(message);
+    const std::vector<std::pair<Hash::Hasher, std::string>> expectations = {
+        {Hash::HasherSha1, "14295e834bd2bf06ed69948a449d4372b962b34a"},
+        {Hash::HasherSha256, hex(sha256)},
+        {Hash::HasherSha512, "97611145f3305ee7385c9128e407972dd114aa26c978c4994be3fb69ccaf83cb4b4a303cf59b6847f282e53e023e4ddd0743716de2ff05c77f3944b05ac887d7"},
+        {Hash::HasherSha512_256, "9ecb13ed213c4915483cb25522757259ccab7ab17acfe0ae2766e57ab5e1cc06"},
+        {Hash::HasherKeccak256, "3b878c7d155cea8e3c6a00fe7d9de2ad697d4983b101aec58f5b7906efbeb9dc"},
+        {Hash::HasherKeccak512, "ce8bd2bf0f741bc5151d4cd7a4df7c1eac7a067fa872880bf21215d96f17e0e7a28f3826576a25cffeff20ccd5f5282acb24e192511cb31344360d2ab4faaa55"},
+        {Hash::HasherSha3_256, hex(sha3_256)},
+        {Hash::HasherSha3_512, "ac4e1a0d9535dc8b1e286b4b60549d3b16e5ec31b3498ef17fcb256ae9a0e4eb9266f3b901f00824b99191d0b2c848f3f2d44ba3e182e83eb50ed095e091941f"},
+        {Hash::HasherRipemd, "c99c314ae6f0373d925aa8c11c67b646b6240482"},
+        {Hash::HasherBlake256, hex(blake256)},
+        {Hash::HasherGroestl512, hex(groestl512)},
+        {Hash::HasherSha256d, hex(Hash::sha256(sha256))},
+        {Hash::HasherSha256ripemd, hex(Hash::ripemd(sha256))},
+        {Hash::HasherSha3_256ripemd, hex(Hash::ripemd(sha3_256))},
+        {Hash::HasherBlake256d, hex(Hash::blake256(blake256))},
+        {Hash::HasherBlake256ripemd, hex(Hash::ripemd(blake256))},
+        {Hash::HasherGroestl512d, hex(Hash::groestl512(groestl512))},
+    };
+    for (const auto& [hasher, expected] : expectations) {
+        // fed in uneven chunks, straddling block boundaries
+        auto context = Hash::Context(hasher);
+        for (size_t offset = 0, chunk = 1; offset < message.size(); offset += chunk, chunk = chunk * 3 + 1) {
+            context.update(message.data() + offset, std::min(chunk, message.size() - offset));
+        }
+        EXPECT_EQ(context.size(), Hash::digestSize(hasher));
+        EXPECT_EQ(hex(context.final()), expected) << hasher;
+
+        // reusable after final
+        Hash::Digest<Hash::maxDigestSize> digest;
+        context.update(message).final(digest.data());
+        EXPECT_EQ(hex(digest.begin(), digest.begin() + context.size()), expected) << hasher;
+
+        context.update(TW::data("discarded"));
+        context.reset();
+        EXPECT_EQ(hex(context.update(message).final()), expected) << hasher;
+    }
+}
+
+TEST(HashTests, FixedSizeDigest) {
+    const auto sha256d = Hash::digest<Hash::HasherSha256d>(brownFox);
+    static_assert(std::tuple_size_v<decltype(sha256d)> == Hash::sha256Size);
+    EXPECT_EQ(hex(sha256d), "6d37795021e544d82b41850edf7aabab9a0ebe274e54a519840c4666f35b3937");
+
+    const auto hash160 = Hash::digest<Hash::HasherSha256ripemd>(brownFox);
+    static_assert(std::tuple_size_v<decltype(hash160)> == Hash::ripemdSize);
+    EXPECT_EQ(hex(hash160), "0e3397b4abc7a382b3ea2365883c3c7ca5f07600");
+
+    const auto empty = Hash::digest<Hash::HasherKeccak256>(Data());
+    EXPECT_EQ(hex(empty), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+}
+
+TEST(HashTests, Sha256ripemdBatch) {
+    // runs of equal-sized messages, hashed 8 at a time, and shorter runs hashed one by one
+    std::vector<Data> messages;
+    for (auto i = 0; i < 21; ++i) {
+        messages.push_back(Data(33, static_cast<TW::byte>(i)));
+    }
+    for (auto i = 0; i < 3; ++i) {
+        messages.push_back(Data(65 + i, static_cast<TW::byte>(i)));
+    }
+    for (auto i = 0; i < 9; ++i) {
+        messages.push_back(Data(i == 0 ? 0 : 120, static_cast<TW::byte>(i)));
+    }
+
+    const auto hashes = Hash::sha256ripemd(messages);
+    ASSERT_EQ(hashes.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(hex(hashes[i]), hex(Hash::sha256ripemd(messages[i].data(), messages[i].size()))) << i;
+    }
+
+    std::vector<const TW::byte*> keys;
+    for (size_t i = 0; i < 21; ++i) {
+        keys.push_back(messages[i].data());
+    }
+    const auto keyHashes = Hash::sha256ripemd(keys, 33);
+    ASSERT_EQ(keyHashes.size(), keys.size());
+    EXPECT_TRUE(std::equal(keyHashes.begin(), keyHashes.end(), hashes.begin()));
+    EXPECT_TRUE(Hash::sha256ripemd(std::vector<Data>()).empty());
+}
+
+TEST(HashTests, Keccak256Batch) {
+    std::vector<Data> messages;
+    std::vector<const TW::byte*> pointers;
+    for (auto i = 0; i < 11; ++i) {
+        messages.push_back(Data(64, static_cast<TW::byte>(i)));
+    }
+    for (const auto& message : messages) {
+        pointers.push_back(message.data());
+    }
+
+    const auto hashes = Hash::keccak256(pointers, 64);
+    ASSERT_EQ(hashes.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(hex(hashes[i]), hex(Hash::keccak256(messages[i]))) << i;
+    }
+    EXPECT_EQ(hex(Hash::keccak256(std::vector<const TW::byte*>(4, messages[0].data()), 0)[3]), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+}
+
 // More tests in TWHashTests
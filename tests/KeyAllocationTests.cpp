@@ -0,0 +1,121 @@
+// Copyright © 2017-2022 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HDWallet.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+
+// Counts the heap allocations of the current thread while enabled.
+// Replacing the global operator new applies to the whole test binary; array, nothrow and
+// aligned variants are not counted separately, the default array and nothrow ones call this one.
+namespace {
+thread_local bool countAllocations = false;
+thread_local size_t allocationCount = 0;
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (countAllocations) {
+        ++allocationCount;
+    }
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace TW {
+
+namespace {
+
+/// Returns the number of heap allocations made by `function`.
+template <typename Function>
+size_t allocations(Function function) {
+    allocationCount = 0;
+    countAllocations = true;
+    function();
+    countAllocations = false;
+    return allocationCount;
+}
+
+const auto keyBytes = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+const auto digest = Hash::sha256(TW::data("Hello"));
+
+} // namespace
+
+TEST(KeyAllocations, SignSecp256k1) {
+    byte signature[PrivateKey::maxSignatureSize];
+    size_t signatureSize = 0;
+    bool compressedEqual = false;
+    const auto count = allocations([&] {
+        const auto key = PrivateKey(keyBytes.data(), keyBytes.size());
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+        const auto compressed = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).compressed();
+        compressedEqual = publicKey == compressed;
+        signatureSize = key.sign(digest.data(), digest.size(), TWCurveSECP256k1, signature);
+    });
+    EXPECT_EQ(count, 0ul);
+    EXPECT_TRUE(compressedEqual);
+    ASSERT_EQ(signatureSize, 65ul);
+
+    const auto key = PrivateKey(keyBytes);
+    EXPECT_EQ(hex(signature, signature + signatureSize), hex(key.sign(digest, TWCurveSECP256k1)));
+    EXPECT_TRUE(key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).verify(TW::data(signature, signatureSize), digest));
+}
+
+TEST(KeyAllocations, SignEd25519) {
+    byte signature[PrivateKey::maxSignatureSize];
+    size_t signatureSize = 0;
+    const auto count = allocations([&] {
+        const auto key = PrivateKey(keyBytes.data(), keyBytes.size());
+        signatureSize = key.sign(digest.data(), digest.size(), TWCurveED25519, signature);
+    });
+    EXPECT_EQ(count, 0ul);
+    ASSERT_EQ(signatureSize, 64ul);
+
+    const auto key = PrivateKey(keyBytes);
+    EXPECT_EQ(hex(signature, signature + signatureSize), hex(key.sign(digest, TWCurveED25519)));
+    EXPECT_TRUE(key.getPublicKey(TWPublicKeyTypeED25519).verify(TW::data(signature, signatureSize), digest));
+}
+
+TEST(KeyAllocations, DeriveAndSign) {
+    const auto wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    const auto path = DerivationPath("m/84'/0'/0'/0/0");
+    const auto solanaPath = DerivationPath("m/44'/501'/0'");
+    // the first derivations fill the node cache
+    const auto first = wallet.getKey(TWCoinTypeBitcoin, path);
+    wallet.getKey(TWCoinTypeSolana, solanaPath);
+
+    byte signature[PrivateKey::maxSignatureSize];
+    auto nextPath = path;
+    nextPath.setAddress(1);
+    const auto count = allocations([&] {
+        const auto key = wallet.getKey(TWCoinTypeBitcoin, nextPath);
+        key.getPublicKey(TWPublicKeyTypeSECP256k1);
+        key.sign(digest.data(), digest.size(), TWCurveSECP256k1, signature);
+
+        const auto solanaKey = wallet.getKey(TWCoinTypeSolana, solanaPath);
+        solanaKey.sign(digest.data(), digest.size(), TWCurveED25519, signature);
+    });
+    EXPECT_EQ(count, 0ul);
+    EXPECT_NE(wallet.getKey(TWCoinTypeBitcoin, nextPath), first);
+}
+
+} // namespace TW
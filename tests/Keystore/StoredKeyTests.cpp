@@ -14,6 +14,7 @@
 #include "Bitcoin/Address.h"
 
 #include <stdexcept>
+#include <system_error>
 #include <gtest/gtest.h>
 
 extern std::string TESTS_ROOT;
@@ -485,6 +486,21 @@ TEST(StoredKey, CreateMinimalEncryptionParameters) {
     EXPECT_EQ(key2.wallet(password).getMnemonic(), string(mnemonic));
 }
 
+TEST(StoredKey, DecryptInvalidScryptCostFactor) {
+    const auto key = StoredKey::createWithMnemonic("name", password, mnemonic, TWStoredKeyEncryptionLevelMinimal);
+    auto json = key.json();
+    // scrypt rejects a cost factor that is not a power of 2, which no password can open
+    json["crypto"]["kdfparams"]["n"] = 4095;
+
+    const auto key2 = StoredKey::createWithJson(json);
+    try {
+        key2.payload.decrypt(password);
+        FAIL() << "Missing exception";
+    } catch (const DecryptionError& error) {
+        EXPECT_EQ(error, DecryptionError::invalidPassword);
+    }
+}
+
 TEST(StoredKey, CreateWeakEncryptionParameters) {
     const auto key = StoredKey::createWithMnemonic("name", password, mnemonic, TWStoredKeyEncryptionLevelWeak);
     EXPECT_EQ(key.type, StoredKeyType::mnemonicPhrase);
@@ -5,9 +5,14 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Mnemonic.h"
+#include "HexCoding.h"
+
+#include <TrezorCrypto/bip39.h>
 
 #include <gtest/gtest.h>
 
+#include <utility>
+
 namespace TW {
 
 std::vector<std::string> ValidInput = {
@@ -39,8 +44,6 @@ std::vector<std::string> InvalidInput = {
     "CREDIT expect life fade cover suit response wash pear what skull force",
     // back is invalid word
     "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn back",
-    // Spanish
-    "llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut",
 };
 
 TEST(Mnemonic, isValid) {
@@ -55,6 +58,91 @@ TEST(Mnemonic, invalid) {
     }
 }
 
+TEST(Mnemonic, isValidLanguage) {
+    ASSERT_TRUE(Mnemonic::hasWordlist(Mnemonic::Language::English));
+    for (auto m: ValidInput) {
+        EXPECT_TRUE(Mnemonic::isValid(m, Mnemonic::Language::English)) << "Expected valid " << m;
+        EXPECT_EQ(Mnemonic::detectLanguage(m), Mnemonic::Language::English) << m;
+
+        uint8_t bits[Mnemonic::MaxBitsSize];
+        uint8_t expected[Mnemonic::MaxBitsSize];
+        const auto count = mnemonic_to_bits(m.c_str(), expected);
+        ASSERT_EQ(Mnemonic::toBits(m, Mnemonic::Language::English, bits), count);
+        EXPECT_EQ(std::vector<uint8_t>(bits, bits + count / 8), std::vector<uint8_t>(expected, expected + count / 8));
+    }
+    for (auto m: InvalidInput) {
+        EXPECT_FALSE(Mnemonic::isValid(m, Mnemonic::Language::English)) << "Expected invalid " << m;
+        EXPECT_NE(Mnemonic::detectLanguage(m), Mnemonic::Language::English) << m;
+    }
+    EXPECT_FALSE(Mnemonic::isValid("", Mnemonic::Language::English));
+    EXPECT_FALSE(Mnemonic::detectLanguage(""));
+    const auto twentySeven = "abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+                             "abandon abandon abandon abandon abandon abandon abandon abandon abandon "
+                             "abandon abandon abandon abandon abandon abandon abandon abandon abandon";
+    EXPECT_FALSE(Mnemonic::isValid(twentySeven, Mnemonic::Language::English));
+}
+
+TEST(Mnemonic, wordIndex) {
+    // the generated English table matches the trezor-crypto wordlist
+    for (auto i = 0; i < BIP39_WORDS; ++i) {
+        EXPECT_EQ(Mnemonic::wordIndex(mnemonic_get_word(i), Mnemonic::Language::English), i);
+    }
+    EXPECT_EQ(Mnemonic::wordIndex("", Mnemonic::Language::English), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("aban", Mnemonic::Language::English), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("abandonx", Mnemonic::Language::English), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("Zoo", Mnemonic::Language::English), -1);
+    EXPECT_EQ(Mnemonic::wordIndex(std::string("zoo\0", 4), Mnemonic::Language::English), -1);
+}
+
+TEST(Mnemonic, normalize) {
+    EXPECT_EQ(Mnemonic::normalize("credit expect"), "credit expect");
+    EXPECT_EQ(Mnemonic::normalize(""), "");
+    // precomposed letters, compatibility characters and Hangul syllables decompose
+    EXPECT_EQ(Mnemonic::normalize("\u00e1baco"), "a\u0301baco");
+    EXPECT_EQ(Mnemonic::normalize("\ufb01n\u00b2"), "fin2");
+    EXPECT_EQ(Mnemonic::normalize("\u304c\u3000\u304c"), "\u304b\u3099 \u304b\u3099");
+    EXPECT_EQ(Mnemonic::normalize("\uac01"), "\u1100\u1161\u11a8");
+    EXPECT_EQ(Mnemonic::normalize("\U0001d400"), "A");
+    // combining marks are put in canonical order
+    EXPECT_EQ(Mnemonic::normalize("a\u0301\u0323b"), "a\u0323\u0301b");
+    EXPECT_EQ(Mnemonic::normalize("\u00e1\u0323"), "a\u0323\u0301");
+    // malformed UTF-8 is returned unchanged
+    EXPECT_EQ(Mnemonic::normalize("\xc3"), "\xc3");
+    EXPECT_EQ(Mnemonic::normalize("a\xed\xa0\x80"), "a\xed\xa0\x80");
+    EXPECT_EQ(Mnemonic::normalize("\xc0\xaf\u00e1"), "\xc0\xaf\u00e1");
+}
+
+TEST(Mnemonic, languageVectors) {
+    // entropy 00112233445566778899aabbccddeeff in each language, from the official wordlists;
+    // the phrases are composed (NFC), the Japanese one separated by ideographic spaces
+    const std::vector<std::pair<Mnemonic::Language, std::string>> vectors = {
+        {Mnemonic::Language::English, "abandon math mimic master filter design carbon crystal rookie group knife young"},
+        {Mnemonic::Language::Japanese, "あいこくしん　たきび　たまご　たおれる　こんかい　くしゃみ　おさえる　きのう　ねんまつ　しほう　せんゆう　わかれる"},
+        {Mnemonic::Language::Korean, "가격 어른 여덟 양파 부정 명예 길이 마늘 점검 석사 식량 흥분"},
+        {Mnemonic::Language::Spanish, "ábaco marco mente mapa favor cubo brillo coger proeza gripe látex zapato"},
+        {Mnemonic::Language::ChineseSimplified, "的 雄 粗 尺 载 属 海 酸 柯 沙 赶 艇"},
+        {Mnemonic::Language::ChineseTraditional, "的 雄 粗 尺 載 屬 海 酸 柯 沙 趕 艇"},
+        {Mnemonic::Language::French, "abaisser justice légume junior envahir crucial branche coincer pliage filière horizon xénon"},
+        {Mnemonic::Language::Italian, "abaco nessuno obbligo neofita fosso digerire buono cucire rogito inarcare mecenate zolla"},
+        {Mnemonic::Language::Czech, "abdikace olizovat oslepit okurka krvinka hvozd dosyta hodlat sesypat mazivo nozdra zvenku"},
+    };
+    for (const auto& [language, mnemonic] : vectors) {
+        ASSERT_TRUE(Mnemonic::hasWordlist(language)) << mnemonic;
+        EXPECT_TRUE(Mnemonic::isValid(mnemonic)) << mnemonic;
+        EXPECT_TRUE(Mnemonic::isValid(mnemonic, language)) << mnemonic;
+        EXPECT_EQ(Mnemonic::detectLanguage(mnemonic), language) << mnemonic;
+
+        uint8_t bits[Mnemonic::MaxBitsSize];
+        ASSERT_EQ(Mnemonic::toBits(mnemonic, language, bits), 12 * Mnemonic::BitsPerWord) << mnemonic;
+        EXPECT_EQ(hex(bits, bits + 16), "00112233445566778899aabbccddeeff") << mnemonic;
+
+        const auto firstWord = mnemonic.substr(0, std::min(mnemonic.find(' '), mnemonic.find("\u3000")));
+        EXPECT_EQ(Mnemonic::wordIndex(firstWord, language), 0) << mnemonic;
+        EXPECT_TRUE(Mnemonic::isValidWord(firstWord)) << mnemonic;
+    }
+    EXPECT_FALSE(Mnemonic::hasWordlist(Mnemonic::Language::Portuguese));
+}
+
 TEST(Mnemonic, isValidWord) {
     EXPECT_TRUE(Mnemonic::isValidWord("credit"));
     EXPECT_TRUE(Mnemonic::isValidWord("airport"));
@@ -64,6 +152,11 @@ TEST(Mnemonic, isValidWord) {
     EXPECT_FALSE(Mnemonic::isValidWord("CREDIT"));
     EXPECT_FALSE(Mnemonic::isValidWord("credit  "));
     EXPECT_FALSE(Mnemonic::isValidWord("back"));
+    EXPECT_FALSE(Mnemonic::isValidWord(""));
+    EXPECT_FALSE(Mnemonic::isValidWord("zoos"));
+    EXPECT_FALSE(Mnemonic::isValidWord(std::string("zoo\0", 4)));
+    EXPECT_TRUE(Mnemonic::isValidWord("abandon"));
+    EXPECT_TRUE(Mnemonic::isValidWord("zoo"));
 }
 
 TEST(Mnemonic, suggest) {
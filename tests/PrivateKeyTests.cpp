@@ -192,9 +192,15 @@ TEST(PrivateKey, PrivateKeyExtended) {
     EXPECT_EQ("639aadd8b6499ae39b78018b79255fbd8f585cbda9cbb9e907a72af86afb7a05", hex(privateKeyExt.secondKey()));
     EXPECT_EQ("d41a57c2dec9a6a19d6bf3b1fa784f334f3a0048d25ccb7b78a7b44066f9ba7b", hex(privateKeyExt.secondExtension()));
     EXPECT_EQ("ed7f28be986cbe06819165f2ee41b403678a098961013cf4a2f3e9ea61fb6c1a", hex(privateKeyExt.secondChainCode()));
+    // views point into the key
+    EXPECT_EQ(privateKeyExt.bytes.data() + 4*32, privateKeyExt.secondExtensionView().data());
+    EXPECT_EQ("d41a57c2dec9a6a19d6bf3b1fa784f334f3a0048d25ccb7b78a7b44066f9ba7b", hex(privateKeyExt.secondExtensionView()));
 
     auto publicKeyExt = privateKeyExt.getPublicKey(TWPublicKeyTypeED25519Extended);
     EXPECT_EQ(2*64, publicKeyExt.bytes.size());
+    EXPECT_EQ(privateKeyExt.chainCodeView(), publicKeyExt.chainCodeView());
+    EXPECT_EQ(privateKeyExt.secondChainCodeView(), publicKeyExt.secondChainCodeView());
+    EXPECT_EQ(publicKeyExt.bytes.data() + 2*32, publicKeyExt.secondKeyView().data());
 
     // Try other constructor for extended key
     auto privateKeyExtOne = PrivateKey(
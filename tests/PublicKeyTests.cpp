@@ -13,6 +13,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace TW;
 
 TEST(PublicKeyTests, CreateFromPrivateSecp256k1) {
@@ -189,6 +191,97 @@ TEST(PublicKeyTests, Verify) {
     }
 }
 
+TEST(PublicKeyTests, VerifyBatch) {
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> signatures;
+    std::vector<Data> messages;
+    // more than one internal chunk of signatures, mixed key types
+    for (auto i = 0; i < 80; ++i) {
+        auto keyData = Hash::sha256(TW::data("key" + std::to_string(i)));
+        const auto privateKey = PrivateKey(keyData);
+        const auto digest = Hash::sha256(TW::data("message" + std::to_string(i)));
+        switch (i % 4) {
+        case 0:
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1));
+            signatures.push_back(privateKey.sign(digest, TWCurveSECP256k1));
+            break;
+        case 1:
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+            signatures.push_back(privateKey.sign(digest, TWCurveSECP256k1));
+            break;
+        case 2:
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeNIST256p1));
+            signatures.push_back(privateKey.sign(digest, TWCurveNIST256p1));
+            break;
+        default:
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+            signatures.push_back(privateKey.sign(digest, TWCurveED25519));
+            break;
+        }
+        messages.push_back(digest);
+    }
+
+    auto results = PublicKey::verifyBatch(publicKeys, signatures, messages);
+    ASSERT_EQ(results.size(), 80ul);
+    for (auto i = 0; i < 80; ++i) {
+        EXPECT_TRUE(results[i]) << i;
+    }
+
+    // wrong message, corrupted signature, signature of another key, zero r
+    messages[4][0] ^= 1;
+    signatures[10][5] ^= 1;
+    signatures[41] = signatures[45];
+    std::fill(signatures[62].begin(), signatures[62].begin() + 32, 0);
+    signatures[7][1] ^= 1;
+    results = PublicKey::verifyBatch(publicKeys, signatures, messages);
+    for (auto i = 0; i < 80; ++i) {
+        EXPECT_EQ(results[i], publicKeys[i].verify(signatures[i], messages[i])) << i;
+        EXPECT_EQ(results[i], i != 4 && i != 10 && i != 41 && i != 62 && i != 7) << i;
+    }
+
+    EXPECT_TRUE(PublicKey::verifyBatch({}, {}, {}).empty());
+    EXPECT_THROW(PublicKey::verifyBatch(publicKeys, signatures, {}), std::invalid_argument);
+}
+
+TEST(PublicKeyTests, VerifyBatchEd25519) {
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> signatures;
+    std::vector<Data> messages;
+    // both Ed25519 variants, with messages of different sizes
+    for (auto i = 0; i < 150; ++i) {
+        const auto privateKey = PrivateKey(Hash::sha256(TW::data("key" + std::to_string(i))));
+        const auto message = TW::data("message " + std::string(i % 50, 'x'));
+        if (i % 3 == 0) {
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeED25519Blake2b));
+            signatures.push_back(privateKey.sign(message, TWCurveED25519Blake2bNano));
+        } else {
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+            signatures.push_back(privateKey.sign(message, TWCurveED25519));
+        }
+        messages.push_back(message);
+    }
+
+    auto results = PublicKey::verifyBatch(publicKeys, signatures, messages);
+    for (auto i = 0; i < 150; ++i) {
+        EXPECT_TRUE(results[i]) << i;
+    }
+
+    // each invalid signature is reported, and only those
+    const std::vector<int> invalid = {2, 3, 63, 64, 100, 149};
+    messages[2].push_back(0);
+    signatures[3][0] ^= 1;
+    signatures[63][63] |= 0x80;
+    signatures[64] = signatures[65];
+    messages[100][0] ^= 1;
+    signatures[149][40] ^= 1;
+    results = PublicKey::verifyBatch(publicKeys, signatures, messages);
+    for (auto i = 0; i < 150; ++i) {
+        const auto expected = std::find(invalid.begin(), invalid.end(), i) == invalid.end();
+        EXPECT_EQ(results[i], expected) << i;
+        EXPECT_EQ(results[i], publicKeys[i].verify(signatures[i], messages[i])) << i;
+    }
+}
+
 TEST(PublicKeyTests, VerifyAsDER) {
     const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
 
@@ -81,6 +81,31 @@ TEST(TWZcashTransaction, Encode) {
     ASSERT_EQ(hex(sighash.begin(), sighash.end()), "f3148f80dfab5e573d5edfe7a850f5fd39234f80b5429d3a57edcc11e34c585b");
 }
 
+TEST(TWZcashTransaction, SigHashCache) {
+    auto transaction = Zcash::Transaction();
+    transaction.lockTime = 0x0004b029;
+    transaction.expiryHeight = 0x0004b048;
+    transaction.branchId = Zcash::SaplingBranchID;
+    transaction.inputs.emplace_back(Bitcoin::OutPoint(parse_hex("a8c685478265f4c14dada651969c45a65e1aeb8cd6791f2f5bb6a1d9952104d9"), 1), Bitcoin::Script(), 0xfffffffe);
+    transaction.inputs.emplace_back(Bitcoin::OutPoint(parse_hex("53685b8809efc50dd7d5cb0906b307a1b8aa5157baa5fc1bd6fe2d0344dd193a"), 0), Bitcoin::Script(), 0xffffffff);
+    transaction.outputs.emplace_back(0x02625a00, Bitcoin::Script(parse_hex("76a9148132712c3ff19f3a151234616777420a6d7ef22688ac")));
+    transaction.outputs.emplace_back(0x0098958b, Bitcoin::Script(parse_hex("76a9145453e4698f02a38abdaa521cd1ff2dee6fac187188ac")));
+
+    const auto cache = transaction.getSigHashCache();
+    EXPECT_EQ(cache.hashPrevouts, transaction.getPrevoutHash());
+    EXPECT_EQ(cache.hashSequence, transaction.getSequenceHash());
+    EXPECT_EQ(cache.hashOutputs, transaction.getOutputsHash());
+
+    const auto scriptCode = Bitcoin::Script(parse_hex("76a914507173527b4c3318a2aecd793bf1cfed705950cf88ac"));
+    for (auto hashType : {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeNone, TWBitcoinSigHashTypeSingle,
+                          TWBitcoinSigHashType(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)}) {
+        for (size_t index = 0; index < transaction.inputs.size(); ++index) {
+            EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, index, hashType, 0x02faf080, Bitcoin::BASE, &cache)),
+                      hex(transaction.getSignatureHash(scriptCode, index, hashType, 0x02faf080, Bitcoin::BASE)));
+        }
+    }
+}
+
 TEST(TWZcashTransaction, SaplingSigning) {
     // tx on mainnet
     // https://explorer.zcha.in/transactions/ec9033381c1cc53ada837ef9981c03ead1c7c41700ff3a954389cfaddc949256
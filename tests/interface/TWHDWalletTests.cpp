@@ -10,6 +10,7 @@
 
 #include <TrustWalletCore/TWHash.h>
 #include <TrustWalletCore/TWData.h>
+#include <TrustWalletCore/TWDataVector.h>
 #include <TrustWalletCore/TWHDWallet.h>
 #include <TrustWalletCore/TWMnemonic.h>
 #include <TrustWalletCore/TWPrivateKey.h>
@@ -455,6 +456,36 @@ TEST(HDWallet, GetDerivedKey) {
     assertHexEqual(privateKeyData, "1901b5994f075af71397f65bd68a9fff8d3025d65f5a2c731cf90f5e259d6aac");
 }
 
+TEST(HDWallet, GetAddressesDerivation) {
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(words.get(), STRING("").get()));
+    const auto addresses = std::shared_ptr<TWDataVector>(TWHDWalletGetAddressesDerivation(wallet.get(), TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0, 3, 1), TWDataVectorDelete);
+    ASSERT_EQ(TWDataVectorSize(addresses.get()), 3ul);
+    const auto address2 = WRAPD(TWDataVectorGet(addresses.get(), 2));
+    EXPECT_EQ(std::string(TWDataBytes(address2.get()), TWDataBytes(address2.get()) + TWDataSize(address2.get())), "bc1q7zddsunzaftf4zlsg9exhzlkvc5374a6v32jf6");
+
+    const auto zpub = WRAPS(TWHDWalletGetExtendedPublicKey(wallet.get(), TWPurposeBIP84, TWCoinTypeBitcoin, TWHDVersionZPUB));
+    const auto fromZpub = std::shared_ptr<TWDataVector>(TWHDWalletGetAddressesFromExtended(zpub.get(), TWCoinTypeBitcoin, TWDerivationDefault, 0, 2, 1, 1), TWDataVectorDelete);
+    ASSERT_EQ(TWDataVectorSize(fromZpub.get()), 1ul);
+    const auto address = WRAPD(TWDataVectorGet(fromZpub.get(), 0));
+    EXPECT_EQ(std::string(TWDataBytes(address.get()), TWDataBytes(address.get()) + TWDataSize(address.get())), "bc1q7zddsunzaftf4zlsg9exhzlkvc5374a6v32jf6");
+
+    const auto invalid = std::shared_ptr<TWDataVector>(TWHDWalletGetAddressesFromExtended(STRING("xpub").get(), TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 3, 0), TWDataVectorDelete);
+    EXPECT_EQ(TWDataVectorSize(invalid.get()), 0ul);
+
+    // the same addresses on several threads, and on one per core
+    for (const auto threads : {3u, 0u}) {
+        const auto parallel = std::shared_ptr<TWDataVector>(TWHDWalletGetAddressesDerivation(wallet.get(), TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 0, 3, threads), TWDataVectorDelete);
+        ASSERT_EQ(TWDataVectorSize(parallel.get()), 3ul);
+        const auto parallelAddress2 = WRAPD(TWDataVectorGet(parallel.get(), 2));
+        EXPECT_EQ(std::string(TWDataBytes(parallelAddress2.get()), TWDataBytes(parallelAddress2.get()) + TWDataSize(parallelAddress2.get())), "bc1q7zddsunzaftf4zlsg9exhzlkvc5374a6v32jf6");
+
+        const auto parallelZpub = std::shared_ptr<TWDataVector>(TWHDWalletGetAddressesFromExtended(zpub.get(), TWCoinTypeBitcoin, TWDerivationDefault, 0, 0, 3, threads), TWDataVectorDelete);
+        ASSERT_EQ(TWDataVectorSize(parallelZpub.get()), 3ul);
+        const auto zpubAddress2 = WRAPD(TWDataVectorGet(parallelZpub.get(), 2));
+        EXPECT_EQ(std::string(TWDataBytes(zpubAddress2.get()), TWDataBytes(zpubAddress2.get()) + TWDataSize(zpubAddress2.get())), "bc1q7zddsunzaftf4zlsg9exhzlkvc5374a6v32jf6");
+    }
+}
+
 TEST(TWHDWallet, Derive_XpubPub_vs_PrivPub) {
     // Test different routes for deriving address from mnemonic, result should be the same:
     // - Direct: mnemonic -> seed -> privateKey -> publicKey -> address
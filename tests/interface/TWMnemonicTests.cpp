@@ -11,11 +11,13 @@
 TEST(TWMnemonic, IsValid) {
     EXPECT_TRUE(TWMnemonicIsValid(STRING("credit expect life fade cover suit response wash pear what skull force").get()));
     EXPECT_FALSE(TWMnemonicIsValid(STRING("ripple scissors hisc mammal hire column oak again sun offer wealth tomorrow").get())); // invalid word
+    EXPECT_TRUE(TWMnemonicIsValid(STRING("llanto radical atraer riesgo actuar masa fondo cielo dieta archivo sonrisa mamut").get())); // Spanish
 }
 
 TEST(TWMnemonic, isValidWord) {
     EXPECT_TRUE(TWMnemonicIsValidWord(STRING("credit").get()));
     EXPECT_FALSE(TWMnemonicIsValidWord(STRING("hybridous").get()));
+    EXPECT_TRUE(TWMnemonicIsValidWord(STRING("l\u00e9gume").get())); // French
 }
 
 TEST(TWMnemonic, suggest) {
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <tuple>
+
 using namespace TW;
 
 TEST(TWPublicKeyTests, Create) {
@@ -35,7 +37,7 @@ TEST(TWPublicKeyTests, CreateFromPrivateSecp256k1) {
     auto publicKeyData = WRAPD(TWPublicKeyData(publicKey.get()));
     EXPECT_EQ(hex(*((Data*)(publicKeyData.get()))), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
     EXPECT_EQ(*((std::string*)(WRAPS(TWPublicKeyDescription(publicKey.get())).get())), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
-    EXPECT_TRUE(TWPublicKeyIsValid(publicKey.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(publicKey.get())).get(), TWPublicKeyTypeSECP256k1));
     EXPECT_TRUE(TWPublicKeyIsCompressed(publicKey.get()));
 }
 
@@ -51,20 +53,20 @@ TEST(TWPublicKeyTests, CompressedExtended) {
     EXPECT_EQ(TWPublicKeyKeyType(publicKey.get()), TWPublicKeyTypeSECP256k1);
     EXPECT_EQ(publicKey.get()->impl.bytes.size(), 33);
     EXPECT_EQ(TWPublicKeyIsCompressed(publicKey.get()), true);
-    EXPECT_TRUE(TWPublicKeyIsValid(publicKey.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(publicKey.get())).get(), TWPublicKeyTypeSECP256k1));
 
     auto extended = WRAP(TWPublicKey, TWPublicKeyUncompressed(publicKey.get()));
     EXPECT_EQ(TWPublicKeyKeyType(extended.get()), TWPublicKeyTypeSECP256k1Extended);
     EXPECT_EQ(extended.get()->impl.bytes.size(), 65);
     EXPECT_EQ(TWPublicKeyIsCompressed(extended.get()), false);
-    EXPECT_TRUE(TWPublicKeyIsValid(extended.get(), TWPublicKeyTypeSECP256k1Extended));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(extended.get())).get(), TWPublicKeyTypeSECP256k1Extended));
 
     auto compressed = WRAP(TWPublicKey, TWPublicKeyCompressed(extended.get()));
     //EXPECT_TRUE(compressed == publicKey.get());
     EXPECT_EQ(TWPublicKeyKeyType(compressed.get()), TWPublicKeyTypeSECP256k1);
     EXPECT_EQ(compressed.get()->impl.bytes.size(), 33);
     EXPECT_EQ(TWPublicKeyIsCompressed(compressed.get()), true);
-    EXPECT_TRUE(TWPublicKeyIsValid(compressed.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(compressed.get())).get(), TWPublicKeyTypeSECP256k1));
 }
 
 TEST(TWPublicKeyTests, Verify) {
@@ -98,6 +100,82 @@ TEST(TWPublicKeyTests, VerifyAsDER) {
     ASSERT_FALSE(TWPublicKeyVerify(publicKey.get(), signature.get(), digest.get()));
 }
 
+TEST(TWPublicKeyTests, VerifyBatch) {
+    const PrivateKey key(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const PrivateKey key2(parse_hex("4f96ed80e9a7555a6f74b3d658afdd9c756b0a40d4ca30c42c2039eb449bb904"));
+
+    const auto digest = Hash::keccak256(TW::data("Hello"));
+    const auto digest2 = Hash::keccak256(TW::data("World"));
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto publicKey2 = key2.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto signature = key.sign(digest, TWCurveSECP256k1);
+    const auto signature2 = key2.sign(digest2, TWCurveSECP256k1);
+
+    auto publicKeys = WRAP(TWDataVector, TWDataVectorCreate());
+    auto signatures = WRAP(TWDataVector, TWDataVectorCreate());
+    auto messages = WRAP(TWDataVector, TWDataVectorCreate());
+    const auto verifyBatch = [&](TWPublicKeyType type, const TWDataVector* sigs) {
+        const auto results = TWPublicKeyVerifyBatch(publicKeys.get(), type, sigs, messages.get());
+        return results == nullptr ? std::string("null") : hex(*reinterpret_cast<const Data*>(WRAPD(results).get()));
+    };
+    EXPECT_EQ(verifyBatch(TWPublicKeyTypeSECP256k1, signatures.get()), "");
+
+    for (const auto& [k, s, m] : {std::make_tuple(publicKey, signature, digest), std::make_tuple(publicKey2, signature2, digest2)}) {
+        TWDataVectorAdd(publicKeys.get(), WRAPD(TWDataCreateWithBytes(k.bytes.data(), k.bytes.size())).get());
+        TWDataVectorAdd(signatures.get(), WRAPD(TWDataCreateWithBytes(s.data(), s.size())).get());
+        TWDataVectorAdd(messages.get(), WRAPD(TWDataCreateWithBytes(m.data(), m.size())).get());
+    }
+    EXPECT_EQ(verifyBatch(TWPublicKeyTypeSECP256k1, signatures.get()), "0101");
+    EXPECT_EQ(verifyBatch(TWPublicKeyTypeNIST256p1, signatures.get()), "0000");
+
+    // signatures swapped
+    auto swapped = WRAP(TWDataVector, TWDataVectorCreate());
+    TWDataVectorAdd(swapped.get(), WRAPD(TWDataCreateWithBytes(signature2.data(), signature2.size())).get());
+    TWDataVectorAdd(swapped.get(), WRAPD(TWDataCreateWithBytes(signature.data(), signature.size())).get());
+    EXPECT_EQ(verifyBatch(TWPublicKeyTypeSECP256k1, swapped.get()), "0000");
+
+    // only the second one is wrong
+    auto secondWrong = WRAP(TWDataVector, TWDataVectorCreate());
+    TWDataVectorAdd(secondWrong.get(), WRAPD(TWDataCreateWithBytes(signature.data(), signature.size())).get());
+    TWDataVectorAdd(secondWrong.get(), WRAPD(TWDataCreateWithBytes(signature.data(), signature.size())).get());
+    EXPECT_EQ(verifyBatch(TWPublicKeyTypeSECP256k1, secondWrong.get()), "0100");
+
+    // size mismatch
+    auto one = WRAP(TWDataVector, TWDataVectorCreate());
+    TWDataVectorAdd(one.get(), WRAPD(TWDataCreateWithBytes(signature.data(), signature.size())).get());
+    EXPECT_EQ(verifyBatch(TWPublicKeyTypeSECP256k1, one.get()), "null");
+}
+
+TEST(TWPublicKeyTests, VerifyBatchEd25519) {
+    auto publicKeys = WRAP(TWDataVector, TWDataVectorCreate());
+    auto signatures = WRAP(TWDataVector, TWDataVectorCreate());
+    auto messages = WRAP(TWDataVector, TWDataVectorCreate());
+    Data lastSignature;
+    for (auto i = 0; i < 10; ++i) {
+        const auto key = PrivateKey(Hash::sha256(TW::data("key" + std::to_string(i))));
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeED25519);
+        const auto message = TW::data("message" + std::to_string(i));
+        lastSignature = key.sign(message, TWCurveED25519);
+        TWDataVectorAdd(publicKeys.get(), WRAPD(TWDataCreateWithBytes(publicKey.bytes.data(), publicKey.bytes.size())).get());
+        TWDataVectorAdd(signatures.get(), WRAPD(TWDataCreateWithBytes(lastSignature.data(), lastSignature.size())).get());
+        TWDataVectorAdd(messages.get(), WRAPD(TWDataCreateWithBytes(message.data(), message.size())).get());
+    }
+    const auto verifyBatch = [&]() {
+        const auto results = WRAPD(TWPublicKeyVerifyBatch(publicKeys.get(), TWPublicKeyTypeED25519, signatures.get(), messages.get()));
+        return hex(*reinterpret_cast<const Data*>(results.get()));
+    };
+    EXPECT_EQ(verifyBatch(), "01010101010101010101");
+
+    // one more, signed by the previous key
+    const auto key = PrivateKey(Hash::sha256(TW::data("key10")));
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeED25519);
+    const auto message = TW::data("message9");
+    TWDataVectorAdd(publicKeys.get(), WRAPD(TWDataCreateWithBytes(publicKey.bytes.data(), publicKey.bytes.size())).get());
+    TWDataVectorAdd(signatures.get(), WRAPD(TWDataCreateWithBytes(lastSignature.data(), lastSignature.size())).get());
+    TWDataVectorAdd(messages.get(), WRAPD(TWDataCreateWithBytes(message.data(), message.size())).get());
+    EXPECT_EQ(verifyBatch(), "0101010101010101010100");
+}
+
 TEST(TWPublicKeyTests, VerifyEd25519) {
     const PrivateKey key(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
     const auto privateKey = WRAP(TWPrivateKey, new TWPrivateKey{ key });
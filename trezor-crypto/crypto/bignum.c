@@ -690,6 +690,408 @@ void bn_multiply_reduce(bignum256 *x, uint32_t res[2 * BN_LIMBS],
   }
 }
 
+#if USE_BN_INT128  // [wallet-core]
+
+// 64-bit words with 128-bit products, for 64-bit targets.  Numbers are
+// converted from and to the 29-bit limbs at the boundaries of bn_multiply.
+
+typedef unsigned __int128 bn_uint128;
+
+#define BN_WORDS 5  // 2**320 > 2**261, the largest normalized bignum256
+
+// Converts normalized x to little-endian 64-bit words
+static void bn_to_words(const bignum256 *x, uint64_t w[BN_WORDS]) {
+  const uint32_t *v = x->val;
+  w[0] = (uint64_t)v[0] | (uint64_t)v[1] << 29 | (uint64_t)v[2] << 58;
+  w[1] = (uint64_t)v[2] >> 6 | (uint64_t)v[3] << 23 | (uint64_t)v[4] << 52;
+  w[2] = (uint64_t)v[4] >> 12 | (uint64_t)v[5] << 17 | (uint64_t)v[6] << 46;
+  w[3] = (uint64_t)v[6] >> 18 | (uint64_t)v[7] << 11 | (uint64_t)v[8] << 40;
+  w[4] = (uint64_t)v[8] >> 24;
+}
+
+// Converts the little-endian 64-bit words w (< 2**261) to normalized x
+static void bn_from_words(const uint64_t w[BN_WORDS], bignum256 *x) {
+  uint32_t *v = x->val;
+  v[0] = w[0] & BN_LIMB_MASK;
+  v[1] = (w[0] >> 29) & BN_LIMB_MASK;
+  v[2] = (w[0] >> 58 | w[1] << 6) & BN_LIMB_MASK;
+  v[3] = (w[1] >> 23) & BN_LIMB_MASK;
+  v[4] = (w[1] >> 52 | w[2] << 12) & BN_LIMB_MASK;
+  v[5] = (w[2] >> 17) & BN_LIMB_MASK;
+  v[6] = (w[2] >> 46 | w[3] << 18) & BN_LIMB_MASK;
+  v[7] = (w[3] >> 11) & BN_LIMB_MASK;
+  v[8] = (w[3] >> 40 | w[4] << 24) & BN_LIMB_MASK;
+}
+
+// res = k * x, for k and x of `words` <= BN_WORDS words
+static void bn_multiply_words(const uint64_t *k, const uint64_t *x, int words,
+                              uint64_t res[2 * BN_WORDS]) {
+  for (int i = 0; i < 2 * BN_WORDS; i++) {
+    res[i] = 0;
+  }
+  for (int i = 0; i < words; i++) {
+    uint64_t carry = 0;
+    for (int j = 0; j < words; j++) {
+      const bn_uint128 t = (bn_uint128)k[i] * x[j] + res[i + j] + carry;
+      res[i + j] = (uint64_t)t;
+      carry = (uint64_t)(t >> 64);
+    }
+    res[i + words] = carry;
+  }
+}
+
+// Returns the number of bits of c = 2**256 - prime, and c in 4 words
+// Assumes prime is normalized, 2**256 - 2**224 <= prime <= 2**256
+static int bn_prime_complement(const bignum256 *prime, uint64_t c[4]) {
+  uint64_t p[BN_WORDS] = {0};
+  bn_to_words(prime, p);
+  if (p[4] != 0) {
+    // prime == 2**256
+    c[0] = c[1] = c[2] = c[3] = 0;
+    return 0;
+  }
+  // c = -p mod 2**256
+  uint64_t borrow = 0;
+  for (int i = 0; i < 4; i++) {
+    c[i] = 0 - p[i] - borrow;
+    borrow |= p[i] != 0;
+  }
+  for (int i = 3; i >= 0; i--) {
+    if (c[i] != 0) {
+      return 64 * i + 64 - __builtin_clzll(c[i]);
+    }
+  }
+  return 0;
+}
+
+// Reduces res modulo prime by folding: with res = h * 2**256 + l and
+// c = 2**256 - prime, res == l + h * c (mod prime)
+// Assumes res < 2**bits, bits <= 576, and c has cbits <= 192 bits
+// Guarantees res < 2**256 <= 2 * prime, only depends on bits and cbits
+static void bn_reduce_fold(uint64_t res[2 * BN_WORDS], const uint64_t c[4],
+                           int cbits, int bits) {
+  const int cwords = (cbits + 63) / 64;
+  while (bits > 257) {
+    const int hwords = (bits - 256 + 63) / 64;
+    // t = h * c
+    uint64_t t[2 * BN_WORDS] = {0};
+    for (int i = 0; i < hwords; i++) {
+      const uint64_t h = res[4 + i];
+      res[4 + i] = 0;
+      uint64_t carry = 0;
+      for (int j = 0; j < cwords; j++) {
+        const bn_uint128 p = (bn_uint128)h * c[j] + t[i + j] + carry;
+        t[i + j] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+      }
+      t[i + cwords] = carry;
+    }
+    // res = l + t
+    const int words = hwords + cwords > 4 ? hwords + cwords : 4;
+    uint64_t carry = 0;
+    for (int i = 0; i < words; i++) {
+      const bn_uint128 sum = (bn_uint128)res[i] + t[i] + carry;
+      res[i] = (uint64_t)sum;
+      carry = (uint64_t)(sum >> 64);
+    }
+    res[words] = carry;
+    // h * c < 2**(bits - 256 + cbits)
+    bits = (bits - 256 + cbits > 256 ? bits - 256 + cbits : 256) + 1;
+    memzero(t, sizeof(t));
+  }
+
+  // res < 2**257, h <= 1: res = l + h * c < 2**256 + c, and if that is
+  // still >= 2**256, one more fold gives res < 2 * c < 2**256
+  for (int pass = 0; pass < 2; pass++) {
+    const uint64_t mask = 0 - res[4];
+    res[4] = 0;
+    uint64_t carry = 0;
+    for (int i = 0; i < 4; i++) {
+      const bn_uint128 t = (bn_uint128)res[i] + (c[i] & mask) + carry;
+      res[i] = (uint64_t)t;
+      carry = (uint64_t)(t >> 64);
+    }
+    res[4] = carry;
+  }
+}
+
+// 2**256 - prime for the nist256p1 prime 2**256 - 2**224 + 2**192 + 2**96 - 1
+static const uint64_t bn_p256_complement[4] = {
+    0x1, 0xffffffff00000000, 0xffffffffffffffff, 0xfffffffe};
+
+// 2**512 modulo the nist256p1 prime in 32-bit words
+static const int64_t bn_p256_r512[8] = {
+    0x3, 0x0, 0xffffffff, 0xfffffffb, 0xfffffffe, 0xffffffff, 0xfffffffd, 0x4};
+
+// Propagates the carries of the signed 32-bit word sums w
+// Guarantees 0 <= w[i] < 2**32, returns the signed carry out of w[7]
+static int64_t bn_p256_carry(int64_t w[8]) {
+  int64_t carry = 0;
+  for (int i = 0; i < 8; i++) {
+    w[i] += carry;
+    // arithmetic shift, rounds towards minus infinity
+    carry = w[i] >> 32;
+    w[i] &= 0xffffffff;
+  }
+  return carry;
+}
+
+// Reduces res modulo the nist256p1 prime with the NIST fast reduction
+// (FIPS 186-4, D.2.3) on 32-bit words, bits 512 and up of res are added
+// as multiples of 2**512 modulo prime
+// Assumes res < 2**522
+// Guarantees res < 2**256 < 2 * prime, constant time
+static void bn_reduce_p256(uint64_t res[2 * BN_WORDS]) {
+  int64_t c[16] = {0}, w[8] = {0};
+  for (int i = 0; i < 8; i++) {
+    c[2 * i] = (int64_t)(res[i] & 0xffffffff);
+    c[2 * i + 1] = (int64_t)(res[i] >> 32);
+  }
+  const int64_t h = (int64_t)res[8];
+
+  // s1 + 2 s2 + 2 s3 + s4 + s5 - s6 - s7 - s8 - s9 by word
+  w[0] = c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+  w[1] = c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+  w[2] = c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+  w[3] = c[3] + 2 * (c[11] + c[12]) + c[13] - c[8] - c[9] - c[15];
+  w[4] = c[4] + 2 * (c[12] + c[13]) + c[14] - c[9] - c[10];
+  w[5] = c[5] + 2 * (c[13] + c[14]) + c[15] - c[10] - c[11];
+  w[6] = c[6] + c[13] + 3 * c[14] + 2 * c[15] - c[8] - c[9];
+  w[7] = c[7] + c[8] + 3 * c[15] - c[10] - c[11] - c[12] - c[13];
+  for (int i = 0; i < 8; i++) {
+    w[i] += h * bn_p256_r512[i];
+  }
+
+  // res == w + t * 2**256 with -4 <= t < 2**11, and
+  // 2**256 == 2**224 - 2**192 - 2**96 + 1 (mod prime).  The first fold
+  // leaves -1 <= t <= 1, two more leave t == 0.
+  int64_t t = bn_p256_carry(w);
+  for (int pass = 0; pass < 3; pass++) {
+    w[0] += t;
+    w[3] -= t;
+    w[6] -= t;
+    w[7] += t;
+    t = bn_p256_carry(w);
+  }
+
+  for (int i = 0; i < 4; i++) {
+    res[i] = (uint64_t)w[2 * i] | (uint64_t)w[2 * i + 1] << 32;
+  }
+  for (int i = 4; i < 2 * BN_WORDS; i++) {
+    res[i] = 0;
+  }
+  memzero(c, sizeof(c));
+  memzero(w, sizeof(w));
+}
+
+// Returns whether 2**256 - prime is the complement of the nist256p1 prime
+static int bn_is_p256_complement(const uint64_t c[4]) {
+  return memcmp(c, bn_p256_complement, sizeof(bn_p256_complement)) == 0;
+}
+
+// x = k * x % prime
+// Assumes k, x are normalized, k * x < 2**519
+// Guarantees x is normalized and partly reduced modulo prime
+// Assumes prime is normalized, 2**256 - 2**224 <= prime <= 2**256
+void bn_multiply(const bignum256 *k, bignum256 *x, const bignum256 *prime) {
+  uint64_t c[4] = {0};
+  const int cbits = bn_prime_complement(prime, c);
+  const int p256 = bn_is_p256_complement(c);
+  if (!p256 && cbits > 192) {
+    // 2**256 - prime is large and has no special form (nist256p1 order),
+    // folding would take many passes
+    uint32_t limbs[2 * BN_LIMBS] = {0};
+    bn_multiply_long(k, x, limbs);
+    bn_multiply_reduce(x, limbs, prime);
+    memzero(limbs, sizeof(limbs));
+    return;
+  }
+
+  uint64_t kw[BN_WORDS] = {0}, xw[BN_WORDS] = {0};
+  uint64_t res[2 * BN_WORDS] = {0};
+  bn_to_words(k, kw);
+  bn_to_words(x, xw);
+  bn_multiply_words(kw, xw, BN_WORDS, res);
+  if (p256) {
+    // nist256p1 prime
+    bn_reduce_p256(res);
+  } else {
+    // 2**256 - prime is small (secp256k1 prime and order)
+    bn_reduce_fold(res, c, cbits, 2 * 261);
+  }
+  bn_from_words(res, x);
+
+  memzero(kw, sizeof(kw));
+  memzero(xw, sizeof(xw));
+  memzero(res, sizeof(res));
+}
+
+// Initializes field for prime
+// Assumes prime is normalized and either the nist256p1 prime or
+//   2**256 - 2**192 <= prime < 2**256
+void bn_word_field_init(bn_word_field *field, const bignum256 *prime) {
+  uint64_t p[BN_WORDS] = {0};
+  bn_to_words(prime, p);
+  memcpy(field->prime, p, sizeof(field->prime));
+  field->complement_bits = bn_prime_complement(prime, field->complement);
+  field->p256 = bn_is_p256_complement(field->complement);
+  assert(p[4] == 0);
+  assert(field->p256 || field->complement_bits <= 192);
+}
+
+// x = x - prime if x + carry * 2**256 >= prime else x
+// Assumes carry is 0 or 1, x + carry * 2**256 < 2 * prime
+// Guarantees x < prime, constant time
+static void bn_word_reduce_once(uint64_t x[4], uint64_t carry,
+                                const bn_word_field *field) {
+  uint64_t t[4] = {0};
+  uint64_t borrow = 0;
+  for (int i = 0; i < 4; i++) {
+    const bn_uint128 d = (bn_uint128)x[i] - field->prime[i] - borrow;
+    t[i] = (uint64_t)d;
+    borrow = (uint64_t)(d >> 64) & 1;
+  }
+  // x >= prime unless the subtraction borrowed more than the carry
+  const uint64_t mask = 0 - ((carry | (borrow ^ 1)) & 1);
+  for (int i = 0; i < 4; i++) {
+    x[i] = (t[i] & mask) | (x[i] & ~mask);
+  }
+}
+
+// res = x % prime
+// Assumes x is normalized and partly reduced modulo prime
+// Guarantees res is fully reduced modulo prime
+void bn_to_word256(const bignum256 *x, bn_word256 *res,
+                   const bn_word_field *field) {
+  uint64_t w[BN_WORDS] = {0};
+  bn_to_words(x, w);
+  bn_word_reduce_once(w, w[4], field);
+  memcpy(res->w, w, sizeof(res->w));
+  memzero(w, sizeof(w));
+}
+
+// res = x
+// Guarantees res is normalized
+void bn_from_word256(const bn_word256 *x, bignum256 *res) {
+  const uint64_t w[BN_WORDS] = {x->w[0], x->w[1], x->w[2], x->w[3], 0};
+  bn_from_words(w, res);
+}
+
+// x = k * x % prime
+// Assumes k, x are fully reduced modulo prime
+// Guarantees x is fully reduced modulo prime, constant time
+void bn_word_multiply(const bn_word256 *k, bn_word256 *x,
+                      const bn_word_field *field) {
+  uint64_t res[2 * BN_WORDS] = {0};
+  bn_multiply_words(k->w, x->w, 4, res);
+  if (field->p256) {
+    bn_reduce_p256(res);
+  } else {
+    bn_reduce_fold(res, field->complement, field->complement_bits, 512);
+  }
+  // res < 2**256 < 2 * prime
+  bn_word_reduce_once(res, 0, field);
+  memcpy(x->w, res, sizeof(x->w));
+  memzero(res, sizeof(res));
+}
+
+// x = (x + y) % prime
+// Assumes x, y are fully reduced modulo prime
+// Guarantees x is fully reduced modulo prime
+void bn_word_addmod(bn_word256 *x, const bn_word256 *y,
+                    const bn_word_field *field) {
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; i++) {
+    const bn_uint128 t = (bn_uint128)x->w[i] + y->w[i] + carry;
+    x->w[i] = (uint64_t)t;
+    carry = (uint64_t)(t >> 64);
+  }
+  bn_word_reduce_once(x->w, carry, field);
+}
+
+// res = (x - y) % prime
+// Assumes x, y are fully reduced modulo prime
+// Guarantees res is fully reduced modulo prime
+// Works properly even if &x == &y or &res == &x or &res == &y
+void bn_word_subtractmod(const bn_word256 *x, const bn_word256 *y,
+                         bn_word256 *res, const bn_word_field *field) {
+  uint64_t borrow = 0;
+  for (int i = 0; i < 4; i++) {
+    const bn_uint128 d = (bn_uint128)x->w[i] - y->w[i] - borrow;
+    res->w[i] = (uint64_t)d;
+    borrow = (uint64_t)(d >> 64) & 1;
+  }
+  // add prime back if x < y
+  const uint64_t mask = 0 - borrow;
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; i++) {
+    const bn_uint128 t =
+        (bn_uint128)res->w[i] + (field->prime[i] & mask) + carry;
+    res->w[i] = (uint64_t)t;
+    carry = (uint64_t)(t >> 64);
+  }
+}
+
+// x = x / 2 % prime
+// Explicitly x = x / 2 if is_even(x) else (x + prime) / 2
+// Assumes x is fully reduced modulo prime
+// Guarantees x is fully reduced modulo prime
+void bn_word_mult_half(bn_word256 *x, const bn_word_field *field) {
+  const uint64_t mask = 0 - (x->w[0] & 1);
+  uint64_t carry = 0;
+  for (int i = 0; i < 4; i++) {
+    const bn_uint128 t =
+        (bn_uint128)x->w[i] + (field->prime[i] & mask) + carry;
+    x->w[i] = (uint64_t)t;
+    carry = (uint64_t)(t >> 64);
+  }
+  for (int i = 0; i < 3; i++) {
+    x->w[i] = x->w[i] >> 1 | x->w[i + 1] << 63;
+  }
+  x->w[3] = x->w[3] >> 1 | carry << 63;
+}
+
+// x = (-x) % prime if cond else x
+// Assumes x is fully reduced modulo prime, cond is either 1 or 0
+// Guarantees x is fully reduced modulo prime
+void bn_word_cnegate(uint32_t cond, bn_word256 *x,
+                     const bn_word_field *field) {
+  bn_word256 t = {0};
+  uint64_t borrow = 0;
+  for (int i = 0; i < 4; i++) {
+    const bn_uint128 d = (bn_uint128)field->prime[i] - x->w[i] - borrow;
+    t.w[i] = (uint64_t)d;
+    borrow = (uint64_t)(d >> 64) & 1;
+  }
+  // t == prime if x == 0
+  bn_word_reduce_once(t.w, 0, field);
+  bn_word_cmov(x, cond, &t, x);
+  memzero(&t, sizeof(t));
+}
+
+// res = truecase if cond else falsecase
+// Assumes cond is either 0 or 1
+// Works properly even if &res == &truecase or &res == &falsecase
+void bn_word_cmov(bn_word256 *res, uint32_t cond, const bn_word256 *truecase,
+                  const bn_word256 *falsecase) {
+  assert((int)(cond == 1) | (cond == 0));
+  const uint64_t tmask = 0 - (uint64_t)cond;
+  for (int i = 0; i < 4; i++) {
+    res->w[i] = (truecase->w[i] & tmask) | (falsecase->w[i] & ~tmask);
+  }
+}
+
+// Returns 1 if x is zero, 0 otherwise, constant time
+uint32_t bn_word_is_zero(const bn_word256 *x) {
+  uint64_t acc = 0;
+  for (int i = 0; i < 4; i++) {
+    acc |= x->w[i];
+  }
+  return (uint32_t)(((acc | (0 - acc)) >> 63) ^ 1);
+}
+
+#else
+
 // x = k * x % prime
 // Assumes k, x are normalized, k * x < 2**519
 // Guarantees x is normalized and partly reduced modulo prime
@@ -703,6 +1105,8 @@ void bn_multiply(const bignum256 *k, bignum256 *x, const bignum256 *prime) {
   memzero(res, sizeof(res));
 }
 
+#endif
+
 // Partly reduces x modulo prime
 // Assumes limbs of x except the last (the most significant) one are normalized
 // Assumes prime is normalized and 2^256 - 2^224 <= prime <= 2^256
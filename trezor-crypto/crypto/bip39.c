@@ -143,21 +143,18 @@ int mnemonic_to_bits(const char *mnemonic, uint8_t *bits) {
     if (mnemonic[i] != 0) {
       i++;
     }
-    k = 0;
-    for (;;) {
-      if (!wordlist[k]) {  // word not found
-        return 0;
-      }
-      if (strcmp(current_word, wordlist[k]) == 0) {  // word found on index k
-        for (ki = 0; ki < 11; ki++) {
-          if (k & (1 << (10 - ki))) {
-            result[bi / 8] |= 1 << (7 - (bi % 8));
-          }
-          bi++;
-        }
-        break;
+    // [wallet-core] indexed lookup instead of a linear scan
+    const int word_index = mnemonic_find_word(current_word);
+    if (word_index < 0) {  // word not found
+      memzero(result, sizeof(result));
+      return 0;
+    }
+    k = (uint32_t)word_index;
+    for (ki = 0; ki < 11; ki++) {
+      if (k & (1 << (10 - ki))) {
+        result[bi / 8] |= 1 << (7 - (bi % 8));
       }
-      k++;
+      bi++;
     }
   }
   if (bi != n * 11) {
@@ -247,9 +244,152 @@ void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
 #endif
 }
 
+// [wallet-core] Seeds of 4 mnemonics at once, bypassing the cache
+void mnemonic_to_seed_x4(const char *const mnemonic[4],
+                         const char *const passphrase[4],
+                         uint8_t seed[4][512 / 8]) {
+  uint8_t salt[4][8 + 256];
+  const uint8_t *pass[4];
+  const uint8_t *salts[4];
+  int passlen[4];
+  int saltlen[4];
+  for (int l = 0; l < 4; l++) {
+    const int passphraselen = strnlen(passphrase[l], 256);
+    memcpy(salt[l], "mnemonic", 8);
+    memcpy(salt[l] + 8, passphrase[l], passphraselen);
+    pass[l] = (const uint8_t *)mnemonic[l];
+    passlen[l] = strlen(mnemonic[l]);
+    salts[l] = salt[l];
+    saltlen[l] = passphraselen + 8;
+  }
+  pbkdf2_hmac_sha512_x4(pass, passlen, salts, saltlen, BIP39_PBKDF2_ROUNDS,
+                        seed);
+  memzero(salt, sizeof(salt));
+}
+
+// [wallet-core] Index of the first word of each two-letter prefix, "aa" to
+// "zz", followed by the word count: the words starting with letters x and y
+// are [bip39_prefix_index[i], bip39_prefix_index[i + 1]) with
+// i = (x - 'a') * 26 + (y - 'a'). Generated from the sorted wordlist, checked
+// by test_mnemonic_prefix_range.
+static const uint16_t bip39_prefix_index[26 * 26 + 1] = {
+  // a
+     0,    0,   10,   24,   33,   34,   37,   41,   42,   46,   46,   46,   61,
+    66,   82,   82,   88,   88,  106,  113,  119,  126,  129,  135,  136,  136,
+  // b
+   136,  155,  155,  155,  155,  175,  175,  175,  175,  183,  183,  183,  197,
+   197,  197,  214,  214,  214,  234,  234,  234,  253,  253,  253,  253,  253,
+  // c
+   253,  295,  295,  295,  295,  302,  302,  302,  327,  333,  333,  333,  357,
+   357,  357,  398,  398,  398,  427,  427,  427,  438,  438,  438,  438,  439,
+  // d
+   439,  449,  449,  449,  449,  487,  487,  487,  487,  514,  514,  514,  514,
+   514,  514,  527,  527,  527,  542,  542,  542,  549,  549,  550,  550,  551,
+  // e
+   551,  559,  559,  562,  565,  565,  566,  567,  567,  569,  569,  569,  578,
+   586,  607,  607,  608,  610,  616,  620,  622,  622,  626,  626,  649,  651,
+  // f
+   651,  673,  673,  673,  673,  685,  685,  685,  685,  705,  705,  705,  720,
+   720,  720,  739,  739,  739,  751,  751,  751,  757,  757,  757,  757,  757,
+  // g
+   757,  774,  774,  774,  774,  780,  780,  780,  781,  788,  788,  788,  800,
+   800,  800,  810,  810,  810,  826,  826,  826,  832,  832,  832,  832,  833,
+  // h
+   833,  848,  848,  848,  848,  859,  859,  859,  859,  866,  866,  866,  866,
+   866,  866,  884,  884,  884,  884,  884,  884,  896,  896,  896,  896,  897,
+  // i
+   897,  897,  897,  899,  902,  902,  902,  903,  903,  903,  903,  903,  906,
+   914,  946,  946,  946,  946,  947,  950,  951,  951,  952,  952,  952,  952,
+  // j
+   952,  956,  956,  956,  956,  960,  960,  960,  960,  960,  960,  960,  960,
+   960,  960,  965,  965,  965,  965,  965,  965,  972,  972,  972,  972,  972,
+  // k
+   972,  973,  973,  973,  973,  977,  977,  977,  977,  988,  988,  988,  988,
+   988,  992,  992,  992,  992,  992,  992,  992,  992,  992,  992,  992,  992,
+  // l
+   992, 1012, 1012, 1012, 1012, 1030, 1030, 1030, 1030, 1047, 1047, 1047, 1047,
+  1047, 1047, 1061, 1061, 1061, 1061, 1061, 1061, 1067, 1067, 1067, 1067, 1068,
+  // m
+  1068, 1101, 1101, 1101, 1101, 1122, 1122, 1122, 1122, 1139, 1139, 1139, 1139,
+  1139, 1139, 1160, 1160, 1160, 1160, 1160, 1160, 1170, 1170, 1170, 1170, 1173,
+  // n
+  1173, 1180, 1180, 1180, 1180, 1195, 1195, 1195, 1195, 1197, 1197, 1197, 1197,
+  1197, 1197, 1210, 1210, 1210, 1210, 1210, 1210, 1214, 1214, 1214, 1214, 1214,
+  // o
+  1214, 1215, 1222, 1225, 1226, 1226, 1230, 1230, 1230, 1231, 1231, 1232, 1235,
+  1236, 1241, 1241, 1246, 1246, 1255, 1256, 1257, 1261, 1264, 1266, 1267, 1268,
+  // p
+  1269, 1294, 1294, 1294, 1294, 1308, 1308, 1308, 1312, 1326, 1326, 1326, 1336,
+  1336, 1336, 1355, 1355, 1355, 1384, 1384, 1384, 1400, 1400, 1400, 1400, 1401,
+  // q
+  1401, 1401, 1401, 1401, 1401, 1401, 1401, 1401, 1401, 1401, 1401, 1401, 1401,
+  1401, 1401, 1401, 1401, 1401, 1401, 1401, 1401, 1409, 1409, 1409, 1409, 1409,
+  // r
+  1409, 1430, 1430, 1430, 1430, 1478, 1478, 1478, 1479, 1495, 1495, 1495, 1495,
+  1495, 1495, 1510, 1510, 1510, 1510, 1510, 1510, 1517, 1517, 1517, 1517, 1517,
+  // s
+  1517, 1536, 1536, 1551, 1551, 1574, 1574, 1574, 1597, 1616, 1616, 1623, 1635,
+  1640, 1645, 1666, 1691, 1694, 1694, 1694, 1727, 1752, 1752, 1763, 1763, 1767,
+  // t
+  1767, 1780, 1780, 1780, 1780, 1790, 1790, 1790, 1805, 1816, 1816, 1816, 1816,
+  1816, 1816, 1844, 1844, 1844, 1872, 1872, 1872, 1880, 1880, 1886, 1886, 1888,
+  // u
+  1888, 1888, 1888, 1888, 1888, 1888, 1888, 1889, 1889, 1889, 1889, 1889, 1889,
+  1890, 1908, 1908, 1914, 1914, 1916, 1922, 1923, 1923, 1923, 1923, 1923, 1923,
+  // v
+  1923, 1935, 1935, 1935, 1935, 1946, 1946, 1946, 1946, 1962, 1962, 1962, 1962,
+  1962, 1962, 1969, 1969, 1969, 1969, 1969, 1969, 1969, 1969, 1969, 1969, 1969,
+  // w
+  1969, 1985, 1985, 1985, 1985, 1997, 1997, 1997, 2005, 2022, 2022, 2022, 2022,
+  2022, 2022, 2032, 2032, 2032, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038,
+  // x
+  2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038,
+  2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038, 2038,
+  // y
+  2038, 2039, 2039, 2039, 2039, 2041, 2041, 2041, 2041, 2041, 2041, 2041, 2041,
+  2041, 2041, 2044, 2044, 2044, 2044, 2044, 2044, 2044, 2044, 2044, 2044, 2044,
+  // z
+  2044, 2044, 2044, 2044, 2044, 2046, 2046, 2046, 2046, 2046, 2046, 2046, 2046,
+  2046, 2046, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048,
+  2048,
+};
+
+// [wallet-core] Narrows the search to the words sharing the first one or two
+// letters of prefix; returns false if no word can match
+static bool mnemonic_prefix_bucket(const char *prefix, int len, int *begin,
+                                   int *end) {
+  if (len <= 0) {
+    *begin = 0;
+    *end = BIP39_WORDS;
+    return true;
+  }
+  if (prefix[0] < 'a' || prefix[0] > 'z') {
+    return false;
+  }
+  const int first = (prefix[0] - 'a') * 26;
+  if (len == 1) {
+    *begin = bip39_prefix_index[first];
+    *end = bip39_prefix_index[first + 26];
+    return true;
+  }
+  if (prefix[1] < 'a' || prefix[1] > 'z') {
+    return false;
+  }
+  const int i = first + (prefix[1] - 'a');
+  *begin = bip39_prefix_index[i];
+  *end = bip39_prefix_index[i + 1];
+  return true;
+}
+
 // binary search for finding the word in the wordlist
+// [wallet-core] within the words sharing its first two letters
 int mnemonic_find_word(const char *word) {
-  int lo = 0, hi = BIP39_WORDS - 1;
+  int lo = 0, hi = 0;
+  if (word[0] == 0 ||
+      !mnemonic_prefix_bucket(word, word[1] == 0 ? 1 : 2, &lo, &hi)) {
+    return -1;
+  }
+  hi--;
   while (lo <= hi) {
     int mid = lo + (hi - lo) / 2;
     int cmp = strcmp(word, wordlist[mid]);
@@ -265,15 +405,45 @@ int mnemonic_find_word(const char *word) {
   return -1;
 }
 
-const char *mnemonic_complete_word(const char *prefix, int len) {
-  // we need to perform linear search,
-  // because we want to return the first match
-  for (const char *const *w = wordlist; *w != 0; w++) {
-    if (strncmp(*w, prefix, len) == 0) {
-      return *w;
+// [wallet-core]
+void mnemonic_prefix_range(const char *prefix, int len, int *begin, int *end) {
+  int lo = 0, hi = 0;
+  if (!mnemonic_prefix_bucket(prefix, len, &lo, &hi)) {
+    *begin = *end = 0;
+    return;
+  }
+  if (len > 2) {
+    // lower bound, then upper bound of the words starting with prefix
+    int first = lo, last = hi;
+    while (first < last) {
+      const int mid = first + (last - first) / 2;
+      if (strncmp(wordlist[mid], prefix, len) < 0) {
+        first = mid + 1;
+      } else {
+        last = mid;
+      }
+    }
+    lo = first;
+    last = hi;
+    while (first < last) {
+      const int mid = first + (last - first) / 2;
+      if (strncmp(wordlist[mid], prefix, len) <= 0) {
+        first = mid + 1;
+      } else {
+        last = mid;
+      }
     }
+    hi = first;
   }
-  return NULL;
+  *begin = lo;
+  *end = hi;
+}
+
+const char *mnemonic_complete_word(const char *prefix, int len) {
+  // [wallet-core] the first match is the start of the prefix range
+  int begin = 0, end = 0;
+  mnemonic_prefix_range(prefix, len, &begin, &end);
+  return begin < end ? wordlist[begin] : NULL;
 }
 
 const char *mnemonic_get_word(int index) {
@@ -289,10 +459,12 @@ uint32_t mnemonic_word_completion_mask(const char *prefix, int len) {
     return 0x3ffffff;  // all letters (bits 1-26 set)
   }
   uint32_t res = 0;
-  for (const char *const *w = wordlist; *w != 0; w++) {
-    const char *word = *w;
-    if (strncmp(word, prefix, len) == 0 && word[len] >= 'a' &&
-        word[len] <= 'z') {
+  // [wallet-core] only the words of the prefix range
+  int begin = 0, end = 0;
+  mnemonic_prefix_range(prefix, len, &begin, &end);
+  for (int i = begin; i < end; i++) {
+    const char *word = wordlist[i];
+    if (word[len] >= 'a' && word[len] <= 'z') {
       res |= 1 << (word[len] - 'a');
     }
   }
@@ -33,11 +33,16 @@
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/hmac.h>
 #include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/nist256p1.h>
 #include <TrezorCrypto/rand.h>
 #include <TrezorCrypto/rfc6979.h>
 #include <TrezorCrypto/secp256k1.h>
 #include <TrezorCrypto/schnorr.h>
 
+#if USE_PRECOMPUTED_CP_SERVER  // [wallet-core]
+#include <stdatomic.h>
+#endif
+
 // Set cp2 = cp1
 void point_copy(const curve_point *cp1, curve_point *cp2) { *cp2 = *cp1; }
 
@@ -403,6 +408,260 @@ void point_jacobian_double(jacobian_curve_point *p, const ecdsa_curve *curve) {
   bn_fast_mod(&p->y, prime);
 }
 
+// [wallet-core]
+// The accumulator of the scalar multiplication ladders.  With 64-bit words
+// its coordinates stay in bn_word256 from the first to the last point
+// operation, instead of being converted in every bn_multiply.
+#if USE_BN_INT128
+
+typedef struct {
+  bn_word256 x, y, z;
+} jacobian_word_point;
+
+typedef struct {
+  bn_word_field field;
+  jacobian_word_point p;
+} ladder_point;
+
+// x = k * x % prime for a small public k >= 1
+static void bn_word_mult_k(bn_word256 *x, int k, const bn_word_field *field) {
+  const bn_word256 t = *x;
+  for (int i = 1; i < k; i++) {
+    bn_word_addmod(x, &t, field);
+  }
+}
+
+// point_jacobian_add with fully reduced coordinates in words
+static void point_jacobian_add_words(const curve_point *p1,
+                                     jacobian_word_point *p2,
+                                     const ecdsa_curve *curve,
+                                     const bn_word_field *field) {
+  bn_word256 x1 = {0}, y1 = {0};
+  bn_word256 r = {0}, h = {0}, r2 = {0};
+  bn_word256 hcby = {0}, hsqx = {0};
+  bn_word256 xz = {0}, yz = {0}, az = {0};
+  uint32_t is_doubling = 0;
+  const int a = curve->a;
+
+  assert(-3 <= a && a <= 0);
+  bn_to_word256(&p1->x, &x1, field);
+  bn_to_word256(&p1->y, &y1, field);
+
+  xz = p2->z;
+  bn_word_multiply(&xz, &xz, field);  // xz = z2^2
+  yz = p2->z;
+  bn_word_multiply(&xz, &yz, field);  // yz = z2^3
+
+  if (a != 0) {
+    az = xz;
+    bn_word_multiply(&az, &az, field);  // az = z2^4
+    bn_word_mult_k(&az, -a, field);     // az = -az2^4
+  }
+
+  bn_word_multiply(&x1, &xz, field);  // xz = x1' = x1*z2^2;
+  bn_word_subtractmod(&xz, &p2->x, &h, field);
+  // h = x1' - x2;
+
+  bn_word_addmod(&xz, &p2->x, field);
+  // xz = x1' + x2
+
+  is_doubling = bn_word_is_zero(&h);
+
+  bn_word_multiply(&y1, &yz, field);  // yz = y1' = y1*z2^3;
+  bn_word_subtractmod(&yz, &p2->y, &r, field);
+  // r = y1' - y2;
+
+  bn_word_addmod(&yz, &p2->y, field);
+  // yz = y1' + y2
+
+  r2 = p2->x;
+  bn_word_multiply(&r2, &r2, field);
+  bn_word_mult_k(&r2, 3, field);
+
+  if (a != 0) {
+    // subtract -a z2^4, i.e, add a z2^4
+    bn_word_subtractmod(&r2, &az, &r2, field);
+  }
+  bn_word_cmov(&r, is_doubling, &r2, &r);
+  bn_word_cmov(&h, is_doubling, &yz, &h);
+
+  // hsqx = h^2
+  hsqx = h;
+  bn_word_multiply(&hsqx, &hsqx, field);
+
+  // hcby = h^3
+  hcby = h;
+  bn_word_multiply(&hsqx, &hcby, field);
+
+  // hsqx = h^2 * (x1 + x2)
+  bn_word_multiply(&xz, &hsqx, field);
+
+  // hcby = h^3 * (y1 + y2)
+  bn_word_multiply(&yz, &hcby, field);
+
+  // z3 = h*z2
+  bn_word_multiply(&h, &p2->z, field);
+
+  // x3 = r^2 - h^2 (x1 + x2)
+  p2->x = r;
+  bn_word_multiply(&p2->x, &p2->x, field);
+  bn_word_subtractmod(&p2->x, &hsqx, &p2->x, field);
+
+  // y3 = 1/2 (r*(h^2 (x1 + x2) - 2x3) - h^3 (y1 + y2))
+  bn_word_subtractmod(&hsqx, &p2->x, &p2->y, field);
+  bn_word_subtractmod(&p2->y, &p2->x, &p2->y, field);
+  bn_word_multiply(&r, &p2->y, field);
+  bn_word_subtractmod(&p2->y, &hcby, &p2->y, field);
+  bn_word_mult_half(&p2->y, field);
+
+  memzero(&x1, sizeof(x1));
+  memzero(&y1, sizeof(y1));
+  memzero(&r, sizeof(r));
+  memzero(&h, sizeof(h));
+  memzero(&r2, sizeof(r2));
+  memzero(&hcby, sizeof(hcby));
+  memzero(&hsqx, sizeof(hsqx));
+  memzero(&xz, sizeof(xz));
+  memzero(&yz, sizeof(yz));
+  memzero(&az, sizeof(az));
+}
+
+// point_jacobian_double with fully reduced coordinates in words
+static void point_jacobian_double_words(jacobian_word_point *p,
+                                        const ecdsa_curve *curve,
+                                        const bn_word_field *field) {
+  bn_word256 az4 = {0}, m = {0}, msq = {0}, ysq = {0}, xysq = {0};
+
+  assert(-3 <= curve->a && curve->a <= 0);
+
+  // m = (3*x^2 + a z^4) / 2
+  m = p->x;
+  bn_word_multiply(&m, &m, field);
+  bn_word_mult_k(&m, 3, field);
+
+  if (curve->a != 0) {
+    az4 = p->z;
+    bn_word_multiply(&az4, &az4, field);
+    bn_word_multiply(&az4, &az4, field);
+    bn_word_mult_k(&az4, -curve->a, field);
+    bn_word_subtractmod(&m, &az4, &m, field);
+  }
+  bn_word_mult_half(&m, field);
+
+  // msq = m^2
+  msq = m;
+  bn_word_multiply(&msq, &msq, field);
+  // ysq = y^2
+  ysq = p->y;
+  bn_word_multiply(&ysq, &ysq, field);
+  // xysq = xy^2
+  xysq = p->x;
+  bn_word_multiply(&ysq, &xysq, field);
+
+  // z3 = yz
+  bn_word_multiply(&p->y, &p->z, field);
+
+  // x3 = m^2 - 2*xy^2
+  p->x = xysq;
+  bn_word_addmod(&p->x, &xysq, field);
+  bn_word_subtractmod(&msq, &p->x, &p->x, field);
+
+  // y3 = m*(xy^2 - x3) - y^4
+  bn_word_subtractmod(&xysq, &p->x, &p->y, field);
+  bn_word_multiply(&m, &p->y, field);
+  bn_word_multiply(&ysq, &ysq, field);
+  bn_word_subtractmod(&p->y, &ysq, &p->y, field);
+
+  memzero(&az4, sizeof(az4));
+  memzero(&m, sizeof(m));
+  memzero(&msq, sizeof(msq));
+  memzero(&ysq, sizeof(ysq));
+  memzero(&xysq, sizeof(xysq));
+}
+
+// res = p with a random z coordinate
+static void ladder_init(ladder_point *res, const curve_point *p,
+                        const ecdsa_curve *curve) {
+  jacobian_curve_point jp = {0};
+  curve_to_jacobian(p, &jp, &curve->prime);
+  bn_word_field_init(&res->field, &curve->prime);
+  bn_to_word256(&jp.x, &res->p.x, &res->field);
+  bn_to_word256(&jp.y, &res->p.y, &res->field);
+  bn_to_word256(&jp.z, &res->p.z, &res->field);
+  memzero(&jp, sizeof(jp));
+}
+
+static void ladder_double(ladder_point *p, const ecdsa_curve *curve) {
+  point_jacobian_double_words(&p->p, curve, &p->field);
+}
+
+// p = p + q
+static void ladder_add(const curve_point *q, ladder_point *p,
+                       const ecdsa_curve *curve) {
+  point_jacobian_add_words(q, &p->p, curve, &p->field);
+}
+
+// p = -p if cond, negating the y or the z coordinate
+static void ladder_cnegate_y(uint32_t cond, ladder_point *p,
+                             const ecdsa_curve *curve) {
+  (void)curve;
+  bn_word_cnegate(cond, &p->p.y, &p->field);
+}
+
+static void ladder_cnegate_z(uint32_t cond, ladder_point *p,
+                             const ecdsa_curve *curve) {
+  (void)curve;
+  bn_word_cnegate(cond, &p->p.z, &p->field);
+}
+
+// res = p in affine coordinates, clears p
+static void ladder_finish(ladder_point *p, curve_point *res,
+                          const ecdsa_curve *curve) {
+  jacobian_curve_point jp = {0};
+  bn_from_word256(&p->p.x, &jp.x);
+  bn_from_word256(&p->p.y, &jp.y);
+  bn_from_word256(&p->p.z, &jp.z);
+  jacobian_to_curve(&jp, res, &curve->prime);
+  memzero(&jp, sizeof(jp));
+  memzero(p, sizeof(*p));
+}
+
+#else
+
+typedef jacobian_curve_point ladder_point;
+
+static void ladder_init(ladder_point *res, const curve_point *p,
+                        const ecdsa_curve *curve) {
+  curve_to_jacobian(p, res, &curve->prime);
+}
+
+static void ladder_double(ladder_point *p, const ecdsa_curve *curve) {
+  point_jacobian_double(p, curve);
+}
+
+static void ladder_add(const curve_point *q, ladder_point *p,
+                       const ecdsa_curve *curve) {
+  point_jacobian_add(q, p, curve);
+}
+
+static void ladder_cnegate_y(uint32_t cond, ladder_point *p,
+                             const ecdsa_curve *curve) {
+  bn_cnegate(cond, &p->y, &curve->prime);
+}
+
+static void ladder_cnegate_z(uint32_t cond, ladder_point *p,
+                             const ecdsa_curve *curve) {
+  bn_cnegate(cond, &p->z, &curve->prime);
+}
+
+static void ladder_finish(ladder_point *p, curve_point *res,
+                          const ecdsa_curve *curve) {
+  jacobian_to_curve(p, res, &curve->prime);
+  memzero(p, sizeof(*p));
+}
+
+#endif
+
 // res = k * p
 void point_multiply(const ecdsa_curve *curve, const bignum256 *k,
                     const curve_point *p, curve_point *res) {
@@ -419,9 +678,8 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k,
   int ashift = 0;
   uint32_t is_even = (k->val[0] & 1) - 1;
   uint32_t bits = {0}, sign = {0}, nsign = {0};
-  CONFIDENTIAL jacobian_curve_point jres;
+  CONFIDENTIAL ladder_point jres;
   curve_point pmult[8] = {0};
-  const bignum256 *prime = &curve->prime;
 
   // is_even = 0xffffffff if k is even, 0 otherwise.
 
@@ -483,16 +741,16 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k,
   sign = (bits >> 4) - 1;
   bits ^= sign;
   bits &= 15;
-  curve_to_jacobian(&pmult[bits >> 1], &jres, prime);
+  ladder_init(&jres, &pmult[bits >> 1], curve);
   for (i = 62; i >= 0; i--) {
     // sign = sign(a[i+1])  (0xffffffff for negative, 0 for positive)
     // invariant jres = (-1)^sign sum_{j=i+1..63} (a[j] * 16^{j-i-1} * p)
     // abits >> (ashift - 4) = lowbits(a >> (i*4))
 
-    point_jacobian_double(&jres, curve);
-    point_jacobian_double(&jres, curve);
-    point_jacobian_double(&jres, curve);
-    point_jacobian_double(&jres, curve);
+    ladder_double(&jres, curve);
+    ladder_double(&jres, curve);
+    ladder_double(&jres, curve);
+    ladder_double(&jres, curve);
 
     // get lowest 5 bits of a >> (i*4).
     ashift -= 4;
@@ -513,32 +771,112 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k,
 
     // negate last result to make signs of this round and the
     // last round equal.
-    bn_cnegate((sign ^ nsign) & 1, &jres.z, prime);
+    ladder_cnegate_z((sign ^ nsign) & 1, &jres, curve);
 
     // add odd factor
-    point_jacobian_add(&pmult[bits >> 1], &jres, curve);
+    ladder_add(&pmult[bits >> 1], &jres, curve);
     sign = nsign;
   }
-  bn_cnegate(sign & 1, &jres.z, prime);
-  jacobian_to_curve(&jres, res, prime);
+  ladder_cnegate_z(sign & 1, &jres, curve);
+  ladder_finish(&jres, res, curve);
   memzero(&a, sizeof(a));
-  memzero(&jres, sizeof(jres));
 }
 
 #if USE_PRECOMPUTED_CP
 
-// res = k * G
-// k must be a normalized number with 0 <= k < curve->order
-void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k,
-                     curve_point *res) {
+#if USE_PRECOMPUTED_CP_SERVER  // [wallet-core]
+
+// Larger fixed-base tables for servers, built on first use:
+//   cp_server[i][j] = (2*j+1) * 256^i * G,  i = 0..31, j = 0..127
+// that is 288 KiB per curve, and 32 point additions per multiplication
+// instead of 64.  Only secp256k1 and nist256p1 have one.
+#define CP_SERVER_WINDOW_BITS 8
+#define CP_SERVER_WINDOWS (256 / CP_SERVER_WINDOW_BITS)
+#define CP_SERVER_POINTS (1 << (CP_SERVER_WINDOW_BITS - 1))
+
+typedef curve_point cp_server_table[CP_SERVER_WINDOWS][CP_SERVER_POINTS];
+
+static atomic_int cp_server_enabled = 1;
+static _Atomic(cp_server_table *) cp_server_secp256k1 = NULL;
+static _Atomic(cp_server_table *) cp_server_nist256p1 = NULL;
+
+void ecdsa_set_server_tables(int enabled) {
+  atomic_store(&cp_server_enabled, enabled != 0);
+}
+
+int ecdsa_server_tables_enabled(void) {
+  return atomic_load(&cp_server_enabled);
+}
+
+static cp_server_table *cp_server_build(const ecdsa_curve *curve) {
+  cp_server_table *table = malloc(sizeof(cp_server_table));
+  if (table == NULL) {
+    return NULL;
+  }
+  curve_point base = curve->G, twice = {0};
+  for (int i = 0; i < CP_SERVER_WINDOWS; i++) {
+    // base = 256^i * G
+    twice = base;
+    point_double(curve, &twice);
+    (*table)[i][0] = base;
+    for (int j = 1; j < CP_SERVER_POINTS; j++) {
+      (*table)[i][j] = (*table)[i][j - 1];
+      point_add(curve, &twice, &(*table)[i][j]);
+    }
+    for (int j = 0; j < CP_SERVER_WINDOW_BITS; j++) {
+      point_double(curve, &base);
+    }
+  }
+  return table;
+}
+
+// Returns the table of the curve, building it if needed; NULL if disabled
+// or not available.  Concurrent first calls may both build it, only one is
+// kept.
+static const curve_point *cp_server_get(const ecdsa_curve *curve) {
+  if (!atomic_load_explicit(&cp_server_enabled, memory_order_relaxed)) {
+    return NULL;
+  }
+  _Atomic(cp_server_table *) *slot = NULL;
+  if (curve == &secp256k1) {
+    slot = &cp_server_secp256k1;
+  } else if (curve == &nist256p1) {
+    slot = &cp_server_nist256p1;
+  } else {
+    return NULL;
+  }
+  cp_server_table *table = atomic_load_explicit(slot, memory_order_acquire);
+  if (table == NULL) {
+    cp_server_table *built = cp_server_build(curve);
+    if (built == NULL) {
+      return NULL;
+    }
+    if (atomic_compare_exchange_strong(slot, &table, built)) {
+      table = built;
+    } else {
+      free(built);
+    }
+  }
+  return &(*table)[0][0];
+}
+
+#endif
+
+// res = k * G, using a table of odd multiples of G with windows of `bits`
+// bits: cp[i * 2^(bits-1) + j] = (2*j+1) * 2^(bits*i) * G.  bits divides 256.
+static void scalar_multiply_window(const ecdsa_curve *curve,
+                                   const bignum256 *k, curve_point *res,
+                                   const curve_point *cp, int bits) {
   assert(bn_is_less(k, &curve->order));
 
   int i = {0}, j = {0};
   CONFIDENTIAL bignum256 a;
   uint32_t is_even = (k->val[0] & 1) - 1;
   uint32_t lowbits = 0;
-  CONFIDENTIAL jacobian_curve_point jres;
-  const bignum256 *prime = &curve->prime;
+  CONFIDENTIAL ladder_point jres;
+  const int windows = 256 / bits;
+  const int points = 1 << (bits - 1);
+  const uint32_t mask = (1u << bits) - 1;
 
   // is_even = 0xffffffff if k is even, 0 otherwise.
 
@@ -565,53 +903,65 @@ void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k,
   // Now a = k + 2^256 (mod curve->order) and a is odd.
   //
   // The idea is to bring the new a into the form.
-  // sum_{i=0..64} a[i] 16^i,  where |a[i]| < 16 and a[i] is odd.
-  // a[0] is odd, since a is odd.  If a[i] would be even, we can
-  // add 1 to it and subtract 16 from a[i-1].  Afterwards,
-  // a[64] = 1, which is the 2^256 that we added before.
+  // sum_{i=0..windows} a[i] B^i,  where B = 2^bits, |a[i]| < B and a[i] is
+  // odd.  a[0] is odd, since a is odd.  If a[i] would be even, we can
+  // add 1 to it and subtract B from a[i-1].  Afterwards,
+  // a[windows] = 1, which is the 2^256 that we added before.
   //
   // Since k = a - 2^256 (mod curve->order), we can compute
-  //   k*G = sum_{i=0..63} a[i] 16^i * G
+  //   k*G = sum_{i=0..windows-1} a[i] B^i * G
   //
-  // We have a big table curve->cp that stores all possible
-  // values of |a[i]| 16^i * G.
-  // curve->cp[i][j] = (2*j+1) * 16^i * G
+  // The table cp stores all possible values of |a[i]| B^i * G.
+  // With bits = 4 this is curve->cp[i][j] = (2*j+1) * 16^i * G
 
-  // now compute  res = sum_{i=0..63} a[i] * 16^i * G step by step.
-  // initial res = |a[0]| * G.  Note that a[0] = a & 0xf if (a&0x10) != 0
-  // and - (16 - (a & 0xf)) otherwise.   We can compute this as
-  //   ((a ^ (((a >> 4) & 1) - 1)) & 0xf) >> 1
+  // now compute  res = sum_{i=0..windows-1} a[i] * B^i * G step by step.
+  // initial res = |a[0]| * G.  Note that a[0] = a & mask if (a&B) != 0
+  // and - (B - (a & mask)) otherwise.   We can compute this as
+  //   ((a ^ (((a >> bits) & 1) - 1)) & mask) >> 1
   // since a is odd.
-  lowbits = a.val[0] & ((1 << 5) - 1);
-  lowbits ^= (lowbits >> 4) - 1;
-  lowbits &= 15;
-  curve_to_jacobian(&curve->cp[0][lowbits >> 1], &jres, prime);
-  for (i = 1; i < 64; i++) {
-    // invariant res = sign(a[i-1]) sum_{j=0..i-1} (a[j] * 16^j * G)
-
-    // shift a by 4 places.
+  lowbits = a.val[0] & ((1u << (bits + 1)) - 1);
+  lowbits ^= (lowbits >> bits) - 1;
+  lowbits &= mask;
+  ladder_init(&jres, &cp[lowbits >> 1], curve);
+  for (i = 1; i < windows; i++) {
+    // invariant res = sign(a[i-1]) sum_{j=0..i-1} (a[j] * B^j * G)
+
+    // shift a by bits places.
     for (j = 0; j < 8; j++) {
-      a.val[j] =
-          (a.val[j] >> 4) | ((a.val[j + 1] & 0xf) << (BN_BITS_PER_LIMB - 4));
+      a.val[j] = (a.val[j] >> bits) |
+                 ((a.val[j + 1] & mask) << (BN_BITS_PER_LIMB - bits));
     }
-    a.val[j] >>= 4;
-    // a = old(a)>>(4*i)
+    a.val[j] >>= bits;
+    // a = old(a)>>(bits*i)
     // a is even iff sign(a[i-1]) = -1
 
-    lowbits = a.val[0] & ((1 << 5) - 1);
-    lowbits ^= (lowbits >> 4) - 1;
-    lowbits &= 15;
+    lowbits = a.val[0] & ((1u << (bits + 1)) - 1);
+    lowbits ^= (lowbits >> bits) - 1;
+    lowbits &= mask;
     // negate last result to make signs of this round and the
     // last round equal.
-    bn_cnegate(~lowbits & 1, &jres.y, prime);
+    ladder_cnegate_y(~lowbits & 1, &jres, curve);
 
     // add odd factor
-    point_jacobian_add(&curve->cp[i][lowbits >> 1], &jres, curve);
+    ladder_add(&cp[i * points + (lowbits >> 1)], &jres, curve);
   }
-  bn_cnegate(~(a.val[0] >> 4) & 1, &jres.y, prime);
-  jacobian_to_curve(&jres, res, prime);
+  ladder_cnegate_y(~(a.val[0] >> bits) & 1, &jres, curve);
+  ladder_finish(&jres, res, curve);
   memzero(&a, sizeof(a));
-  memzero(&jres, sizeof(jres));
+}
+
+// res = k * G
+// k must be a normalized number with 0 <= k < curve->order
+void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k,
+                     curve_point *res) {
+#if USE_PRECOMPUTED_CP_SERVER  // [wallet-core]
+  const curve_point *cp_server = cp_server_get(curve);
+  if (cp_server != NULL) {
+    scalar_multiply_window(curve, k, res, cp_server, CP_SERVER_WINDOW_BITS);
+    return;
+  }
+#endif
+  scalar_multiply_window(curve, k, res, &curve->cp[0][0], 4);
 }
 
 #else
@@ -1090,6 +1440,362 @@ int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key,
   return result;
 }
 
+// [wallet-core]
+// Batch verification.  Signatures are verified in chunks of
+// ECDSA_BATCH_SIZE: the inverses of all s and the affine tables of odd
+// multiples of all public keys are computed with a single modular inversion
+// each (Montgomery's trick), and u1 * G + u2 * Q is computed with one
+// doubling chain (Strauss-Shamir) using width-w NAFs of u1 and u2.  The
+// result is compared in jacobian coordinates, so no inversion is needed per
+// signature.  Only public data is processed, nothing here is constant time.
+#define ECDSA_BATCH_SIZE 32
+// odd multiples Q, 3Q, ..., 15Q of each public key, for NAFs of width 5
+#define ECDSA_BATCH_WINDOW 5
+#define ECDSA_BATCH_POINTS (1 << (ECDSA_BATCH_WINDOW - 2))
+// a NAF has at most one digit more than the number has bits
+#define ECDSA_NAF_DIGITS 257
+
+typedef struct {
+  size_t index[ECDSA_BATCH_SIZE];
+  curve_point pub[ECDSA_BATCH_SIZE + 1];
+  bignum256 r[ECDSA_BATCH_SIZE], u1[ECDSA_BATCH_SIZE], u2[ECDSA_BATCH_SIZE];
+  // table[i][j] = (2*j+1) * pub[i]; pub[count] is G if there are no
+  // precomputed tables
+  curve_point table[ECDSA_BATCH_SIZE + 1][ECDSA_BATCH_POINTS];
+  // scratch space
+  jacobian_curve_point jp[(ECDSA_BATCH_SIZE + 1) * ECDSA_BATCH_POINTS];
+  curve_point affine[(ECDSA_BATCH_SIZE + 1) * ECDSA_BATCH_POINTS];
+  bignum256 inv[(ECDSA_BATCH_SIZE + 1) * ECDSA_BATCH_POINTS];
+  bignum256 tmp[(ECDSA_BATCH_SIZE + 1) * ECDSA_BATCH_POINTS];
+  int16_t naf1[ECDSA_NAF_DIGITS], naf2[ECDSA_NAF_DIGITS];
+} ecdsa_batch;
+
+// x[i] = 1/x[i] % prime for i = 0..n-1, with a single inversion
+// Assumes x[i] are normalized and nonzero modulo prime, tmp has n elements
+// Guarantees x[i] are normalized and fully reduced modulo prime
+static void bn_inverse_batch(bignum256 *x, bignum256 *tmp, size_t n,
+                             const bignum256 *prime) {
+  if (n == 0) {
+    return;
+  }
+  // tmp[i] = x[0] * ... * x[i]
+  tmp[0] = x[0];
+  for (size_t i = 1; i < n; i++) {
+    tmp[i] = x[i];
+    bn_multiply(&tmp[i - 1], &tmp[i], prime);
+  }
+  bignum256 inv = tmp[n - 1], t = {0};
+  bn_inverse(&inv, prime);
+  for (size_t i = n - 1; i > 0; i--) {
+    // inv = 1 / (x[0] * ... * x[i])
+    t = tmp[i - 1];
+    bn_multiply(&inv, &t, prime);
+    bn_multiply(&x[i], &inv, prime);
+    x[i] = t;
+    bn_mod(&x[i], prime);
+  }
+  x[0] = inv;
+  bn_mod(&x[0], prime);
+}
+
+// b->affine[i] = b->jp[i] in affine coordinates for i = 0..n-1
+// Assumes none of the points is the point at infinity
+static void ecdsa_batch_to_affine(ecdsa_batch *b, size_t n,
+                                  const bignum256 *prime) {
+  for (size_t i = 0; i < n; i++) {
+    b->inv[i] = b->jp[i].z;
+  }
+  bn_inverse_batch(b->inv, b->tmp, n, prime);
+  for (size_t i = 0; i < n; i++) {
+    bignum256 zz = b->inv[i];
+    bn_multiply(&zz, &zz, prime);  // zz = z^-2
+    b->affine[i].x = b->jp[i].x;
+    bn_multiply(&zz, &b->affine[i].x, prime);
+    bn_multiply(&b->inv[i], &zz, prime);  // zz = z^-3
+    b->affine[i].y = b->jp[i].y;
+    bn_multiply(&zz, &b->affine[i].y, prime);
+    bn_mod(&b->affine[i].x, prime);
+    bn_mod(&b->affine[i].y, prime);
+  }
+}
+
+// b->table[i] = odd multiples of b->pub[i] for i = 0..n-1
+static void ecdsa_batch_tables(const ecdsa_curve *curve, size_t n,
+                               ecdsa_batch *b) {
+  const bignum256 *prime = &curve->prime;
+  const size_t odd = ECDSA_BATCH_POINTS - 1;
+
+  // affine[i] = 2 * pub[i]
+  for (size_t i = 0; i < n; i++) {
+    b->jp[i].x = b->pub[i].x;
+    b->jp[i].y = b->pub[i].y;
+    bn_one(&b->jp[i].z);
+    point_jacobian_double(&b->jp[i], curve);
+  }
+  ecdsa_batch_to_affine(b, n, prime);
+  // use the last table column for 2 * pub[i] until it is overwritten below
+  for (size_t i = 0; i < n; i++) {
+    b->table[i][odd] = b->affine[i];
+  }
+
+  // jp[i * odd + j - 1] = (2*j+1) * pub[i] = (2*j-1) * pub[i] + 2 * pub[i]
+  for (size_t i = 0; i < n; i++) {
+    jacobian_curve_point *jp = &b->jp[i * odd];
+    const curve_point *twice = &b->table[i][odd];
+    jp[0].x = b->pub[i].x;
+    jp[0].y = b->pub[i].y;
+    bn_one(&jp[0].z);
+    point_jacobian_add(twice, &jp[0], curve);
+    for (size_t j = 1; j < odd; j++) {
+      jp[j] = jp[j - 1];
+      point_jacobian_add(twice, &jp[j], curve);
+    }
+  }
+  ecdsa_batch_to_affine(b, n * odd, prime);
+  for (size_t i = 0; i < n; i++) {
+    b->table[i][0] = b->pub[i];
+    for (size_t j = 1; j <= odd; j++) {
+      b->table[i][j] = b->affine[i * odd + j - 1];
+    }
+  }
+}
+
+// Computes the width-w NAF of k: k = sum_i naf[i] * 2^i, where naf[i] is
+// zero or odd with |naf[i]| < 2^(w-1), and at most one of any w consecutive
+// digits is nonzero.  Returns the number of digits.
+// Assumes k is normalized and k < 2^256, 2 <= w <= 15
+static int ecdsa_naf(const bignum256 *k, int w,
+                     int16_t naf[ECDSA_NAF_DIGITS]) {
+  uint8_t buf[32] = {0};
+  uint32_t a[9] = {0};
+  const uint32_t mask = (1u << w) - 1;
+  int len = 0;
+
+  bn_write_le(k, buf);
+  for (int i = 0; i < 8; i++) {
+    a[i] = (uint32_t)buf[4 * i] | (uint32_t)buf[4 * i + 1] << 8 |
+           (uint32_t)buf[4 * i + 2] << 16 | (uint32_t)buf[4 * i + 3] << 24;
+  }
+  for (int i = 0; i < ECDSA_NAF_DIGITS; i++) {
+    int32_t digit = 0;
+    if (a[0] & 1) {
+      digit = (int32_t)(a[0] & mask);
+      if (digit >> (w - 1)) {
+        digit -= (int32_t)(mask + 1);
+      }
+      // a = a - digit, which makes the lowest w bits zero
+      uint64_t carry = 0;
+      if (digit > 0) {
+        carry = (uint64_t)a[0] - (uint32_t)digit;
+        a[0] = (uint32_t)carry;
+        for (int j = 1; j < 9 && (carry >> 32) != 0; j++) {
+          carry = (uint64_t)a[j] - 1;
+          a[j] = (uint32_t)carry;
+        }
+      } else {
+        carry = (uint64_t)a[0] + (uint32_t)-digit;
+        a[0] = (uint32_t)carry;
+        for (int j = 1; j < 9 && (carry >> 32) != 0; j++) {
+          carry = (uint64_t)a[j] + 1;
+          a[j] = (uint32_t)carry;
+        }
+      }
+      len = i + 1;
+    }
+    naf[i] = (int16_t)digit;
+    // a = a >> 1
+    for (int j = 0; j < 8; j++) {
+      a[j] = (a[j] >> 1) | (a[j + 1] << 31);
+    }
+    a[8] >>= 1;
+  }
+  memzero(buf, sizeof(buf));
+  return len;
+}
+
+// res = res + digit * table[|digit| / 2]; infinity is res->z == 0
+static void ecdsa_batch_add(const ecdsa_curve *curve,
+                            const curve_point *table, int digit,
+                            jacobian_curve_point *res) {
+  curve_point p = table[(digit < 0 ? -digit : digit) >> 1];
+  if (digit < 0) {
+    bn_subtract(&curve->prime, &p.y, &p.y);
+  }
+  if (bn_is_zero(&res->z)) {
+    res->x = p.x;
+    res->y = p.y;
+    bn_one(&res->z);
+  } else {
+    point_jacobian_add(&p, res, curve);
+  }
+}
+
+// Checks that (u1 * G + u2 * Q).x == r modulo the order, where gtable and
+// qtable hold the odd multiples of G and Q for NAFs of width gwindow and
+// ECDSA_BATCH_WINDOW
+// returns 0 if the signature is valid
+static int ecdsa_batch_check(const ecdsa_curve *curve, const bignum256 *u1,
+                             const curve_point *gtable, int gwindow,
+                             const bignum256 *u2, const curve_point *qtable,
+                             const bignum256 *r, ecdsa_batch *b) {
+  const bignum256 *prime = &curve->prime;
+  jacobian_curve_point res = {0};
+  bignum256 zz = {0}, x = {0}, rz = {0};
+
+  const int len1 = ecdsa_naf(u1, gwindow, b->naf1);
+  const int len2 = ecdsa_naf(u2, ECDSA_BATCH_WINDOW, b->naf2);
+  for (int i = (len1 > len2 ? len1 : len2) - 1; i >= 0; i--) {
+    if (!bn_is_zero(&res.z)) {
+      point_jacobian_double(&res, curve);
+    }
+    if (b->naf1[i] != 0) {
+      ecdsa_batch_add(curve, gtable, b->naf1[i], &res);
+    }
+    if (b->naf2[i] != 0) {
+      ecdsa_batch_add(curve, qtable, b->naf2[i], &res);
+    }
+  }
+
+  // R == Infinity, or an addition hit it halfway
+  bn_mod(&res.z, prime);
+  if (bn_is_zero(&res.z)) {
+    return 4;
+  }
+
+  // R.x == r mod order  <=>  x == r * z^2 or x == (r + order) * z^2 mod prime
+  zz = res.z;
+  bn_multiply(&zz, &zz, prime);
+  x = res.x;
+  bn_mod(&x, prime);
+  rz = *r;
+  bn_multiply(&zz, &rz, prime);
+  bn_mod(&rz, prime);
+  if (bn_is_equal(&x, &rz)) {
+    return 0;
+  }
+  rz = *r;
+  bn_add(&rz, &curve->order);
+  if (bn_is_less(&rz, prime)) {
+    bn_multiply(&zz, &rz, prime);
+    bn_mod(&rz, prime);
+    if (bn_is_equal(&x, &rz)) {
+      return 0;
+    }
+  }
+  return 5;
+}
+
+// Verifies the signatures at b->index[0..n-1], read into b, and stores the
+// results
+static void ecdsa_batch_verify(const ecdsa_curve *curve, size_t n,
+                               const uint8_t *const *pub_keys,
+                               const uint8_t *const *sigs,
+                               const uint8_t *const *digests, int *results,
+                               ecdsa_batch *b) {
+  const bignum256 *order = &curve->order;
+
+  // u2 = s^-1 for all signatures
+  bn_inverse_batch(b->u2, b->tmp, n, order);
+  for (size_t i = 0; i < n; i++) {
+    bn_multiply(&b->u2[i], &b->u1[i], order);  // u1 = z * s^-1
+    bn_mod(&b->u1[i], order);
+    bn_multiply(&b->r[i], &b->u2[i], order);  // u2 = r * s^-1
+    bn_mod(&b->u2[i], order);
+  }
+
+  const curve_point *gtable = NULL;
+  int gwindow = 0;
+#if USE_PRECOMPUTED_CP
+#if USE_PRECOMPUTED_CP_SERVER
+  // the first row holds (2*j+1) * G for j < 2^(CP_SERVER_WINDOW_BITS-1)
+  gtable = cp_server_get(curve);
+  gwindow = CP_SERVER_WINDOW_BITS + 1;
+#endif
+  if (gtable == NULL) {
+    // curve->cp[0][j] = (2*j+1) * G for j < 8
+    gtable = &curve->cp[0][0];
+    gwindow = 5;
+  }
+  ecdsa_batch_tables(curve, n, b);
+#else
+  b->pub[n] = curve->G;
+  ecdsa_batch_tables(curve, n + 1, b);
+  gtable = b->table[n];
+  gwindow = ECDSA_BATCH_WINDOW;
+#endif
+
+  for (size_t i = 0; i < n; i++) {
+    const size_t k = b->index[i];
+    results[k] = ecdsa_batch_check(curve, &b->u1[i], gtable, gwindow,
+                                   &b->u2[i], b->table[i], &b->r[i], b);
+    if (results[k] != 0) {
+      // Rejections, and the negligible case of an addition hitting a
+      // degenerate case, are settled by the single verification
+      results[k] = ecdsa_verify_digest(curve, pub_keys[k], sigs[k], digests[k]);
+    }
+  }
+}
+
+// Verifies count signatures, results[i] is the result of
+// ecdsa_verify_digest(curve, pub_keys[i], sigs[i], digests[i])
+// returns 0 if all signatures are valid
+int ecdsa_verify_digest_batch(const ecdsa_curve *curve, size_t count,
+                              const uint8_t *const *pub_keys,
+                              const uint8_t *const *sigs,
+                              const uint8_t *const *digests, int *results) {
+  ecdsa_batch *b = malloc(sizeof(ecdsa_batch));
+  int failed = 0;
+
+  for (size_t start = 0; start < count; start += ECDSA_BATCH_SIZE) {
+    const size_t end =
+        count - start < ECDSA_BATCH_SIZE ? count : start + ECDSA_BATCH_SIZE;
+    size_t n = 0;
+    for (size_t k = start; k < end; k++) {
+      if (b == NULL) {
+        results[k] =
+            ecdsa_verify_digest(curve, pub_keys[k], sigs[k], digests[k]);
+        continue;
+      }
+      // same checks as ecdsa_verify_digest
+      bignum256 s = {0}, z = {0};
+      results[k] = 0;
+      if (!ecdsa_read_pubkey(curve, pub_keys[k], &b->pub[n])) {
+        results[k] = 1;
+        continue;
+      }
+      bn_read_be(sigs[k], &b->r[n]);
+      bn_read_be(sigs[k] + 32, &s);
+      bn_read_be(digests[k], &z);
+      if (bn_is_zero(&b->r[n]) || bn_is_zero(&s) ||
+          (!bn_is_less(&b->r[n], &curve->order)) ||
+          (!bn_is_less(&s, &curve->order))) {
+        results[k] = 2;
+        continue;
+      }
+      if (bn_is_zero(&z)) {
+        results[k] = 3;
+        continue;
+      }
+      b->index[n] = k;
+      b->u1[n] = z;
+      b->u2[n] = s;
+      n++;
+    }
+    if (b != NULL) {
+      ecdsa_batch_verify(curve, n, pub_keys, sigs, digests, results, b);
+    }
+    for (size_t k = start; k < end; k++) {
+      failed |= results[k] != 0;
+    }
+  }
+
+  if (b != NULL) {
+    memzero(b, sizeof(ecdsa_batch));
+    free(b);
+  }
+  return failed;
+}
+
 int ecdsa_sig_to_der(const uint8_t *sig, uint8_t *der) {
   int i = 0;
   uint8_t *p = der, *len = NULL, *len1 = NULL, *len2 = NULL;
@@ -133,12 +133,10 @@ void pbkdf2_hmac_sha512_Init(PBKDF2_HMAC_SHA512_CTX *pctx, const uint8_t *pass,
 
 void pbkdf2_hmac_sha512_Update(PBKDF2_HMAC_SHA512_CTX *pctx,
                                uint32_t iterations) {
-  for (uint32_t i = pctx->first; i < iterations; i++) {
-    sha512_Transform(pctx->idig, pctx->g, pctx->g);
-    sha512_Transform(pctx->odig, pctx->g, pctx->g);
-    for (uint32_t j = 0; j < SHA512_DIGEST_LENGTH / sizeof(uint64_t); j++) {
-      pctx->f[j] ^= pctx->g[j];
-    }
+  // [wallet-core] g holds the previous digest, followed by its padding
+  if (iterations > (uint32_t)pctx->first) {
+    sha512_pbkdf2_iterate(pctx->idig, pctx->odig, pctx->g, pctx->f,
+                          iterations - pctx->first);
   }
   pctx->first = 0;
 }
@@ -177,3 +175,34 @@ void pbkdf2_hmac_sha512(const uint8_t *pass, int passlen, const uint8_t *salt,
     }
   }
 }
+
+// [wallet-core]
+void pbkdf2_hmac_sha512_x4(const uint8_t *const pass[4], const int passlen[4],
+                           const uint8_t *const salt[4], const int saltlen[4],
+                           uint32_t iterations,
+                           uint8_t key[4][SHA512_DIGEST_LENGTH]) {
+  PBKDF2_HMAC_SHA512_CTX pctx[4];
+  uint64_t idig[4][SHA512_DIGEST_LENGTH / sizeof(uint64_t)];
+  uint64_t odig[4][SHA512_DIGEST_LENGTH / sizeof(uint64_t)];
+  uint64_t g[4][SHA512_DIGEST_LENGTH / sizeof(uint64_t)];
+  uint64_t f[4][SHA512_DIGEST_LENGTH / sizeof(uint64_t)];
+  for (int l = 0; l < 4; l++) {
+    pbkdf2_hmac_sha512_Init(&pctx[l], pass[l], passlen[l], salt[l], saltlen[l],
+                            1);
+    memcpy(idig[l], pctx[l].idig, sizeof(idig[l]));
+    memcpy(odig[l], pctx[l].odig, sizeof(odig[l]));
+    memcpy(g[l], pctx[l].g, sizeof(g[l]));
+    memcpy(f[l], pctx[l].f, sizeof(f[l]));
+  }
+  if (iterations > 1) {
+    sha512_pbkdf2_iterate_x4(idig, odig, g, f, iterations - 1);
+  }
+  for (int l = 0; l < 4; l++) {
+    memcpy(pctx[l].f, f[l], sizeof(f[l]));
+    pbkdf2_hmac_sha512_Final(&pctx[l], key[l]);
+  }
+  memzero(idig, sizeof(idig));
+  memzero(odig, sizeof(odig));
+  memzero(g, sizeof(g));
+  memzero(f, sizeof(f));
+}
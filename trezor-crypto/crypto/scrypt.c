@@ -42,10 +42,28 @@
 #include <stdlib.h>
 #include <string.h>
 
+/*
+ * [wallet-core] salsa20/8 on 128-bit vectors (SSE2 on x86-64, NEON on ARM),
+ * written with compiler vector extensions.  As in the SSE2 implementation of
+ * the scrypt reference code, the words of each 64-byte block are kept in
+ * diagonal order during SMix: word i of a block holds word 5i mod 16 of the
+ * salsa20 state, so that the four words combined by each quarter-round step
+ * of both the column and the row rounds form one vector.
+ */
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON) || defined(__aarch64__))
+#define SCRYPT_SIMD 1
+#else
+#define SCRYPT_SIMD 0
+#endif
+
 static void blkcpy(void *, void *, size_t);
+#if !SCRYPT_SIMD
 static void blkxor(void *, void *, size_t);
 static void salsa20_8(uint32_t[16]);
+#endif
 static void blockmix_salsa8(uint32_t *, uint32_t *, uint32_t *, size_t);
+static void blockmix_salsa8_xor(uint32_t *, uint32_t *, uint32_t *, uint32_t *,
+    size_t);
 static uint64_t integerify(void *, size_t);
 static void smix(uint8_t *, size_t, uint64_t, uint32_t *, uint32_t *);
 
@@ -61,6 +79,7 @@ blkcpy(void * dest, void * src, size_t len)
 		D[i] = S[i];
 }
 
+#if !SCRYPT_SIMD
 static void
 blkxor(void * dest, void * src, size_t len)
 {
@@ -72,6 +91,145 @@ blkxor(void * dest, void * src, size_t len)
 	for (i = 0; i < L; i++)
 		D[i] ^= S[i];
 }
+#endif
+
+#if SCRYPT_SIMD
+
+typedef uint32_t scrypt_v4u32 __attribute__((vector_size(16)));
+
+#if defined(__clang__)
+#define SHUFFLE(x, a, b, c, d) __builtin_shufflevector((x), (x), a, b, c, d)
+#else
+#define SHUFFLE(x, a, b, c, d) __builtin_shuffle((x), (scrypt_v4u32){a, b, c, d})
+#endif
+
+static inline scrypt_v4u32
+load_v4(const uint32_t * p)
+{
+	scrypt_v4u32 v;
+
+	memcpy(&v, p, sizeof(v));
+	return (v);
+}
+
+static inline void
+store_v4(uint32_t * p, scrypt_v4u32 v)
+{
+
+	memcpy(p, &v, sizeof(v));
+}
+
+/**
+ * salsa20_8_v(X):
+ * Apply the salsa20/8 core to the block held by the four vectors X, in
+ * diagonal order.
+ */
+static inline void
+salsa20_8_v(scrypt_v4u32 X[4])
+{
+	scrypt_v4u32 X0 = X[0], X1 = X[1], X2 = X[2], X3 = X[3], T;
+	size_t i;
+
+	for (i = 0; i < 8; i += 2) {
+#define R(a,b) (((a) << (b)) | ((a) >> (32 - (b))))
+		/* Operate on "columns". */
+		T = X0 + X3;  X1 ^= R(T, 7);
+		T = X1 + X0;  X2 ^= R(T, 9);
+		T = X2 + X1;  X3 ^= R(T,13);
+		T = X3 + X2;  X0 ^= R(T,18);
+
+		/* Rearrange data. */
+		X1 = SHUFFLE(X1, 3, 0, 1, 2);
+		X2 = SHUFFLE(X2, 2, 3, 0, 1);
+		X3 = SHUFFLE(X3, 1, 2, 3, 0);
+
+		/* Operate on "rows". */
+		T = X0 + X1;  X3 ^= R(T, 7);
+		T = X3 + X0;  X2 ^= R(T, 9);
+		T = X2 + X3;  X1 ^= R(T,13);
+		T = X1 + X2;  X0 ^= R(T,18);
+
+		/* Rearrange data. */
+		X1 = SHUFFLE(X1, 1, 2, 3, 0);
+		X2 = SHUFFLE(X2, 2, 3, 0, 1);
+		X3 = SHUFFLE(X3, 3, 0, 1, 2);
+#undef R
+	}
+	X[0] += X0;
+	X[1] += X1;
+	X[2] += X2;
+	X[3] += X3;
+}
+
+/**
+ * blockmix_salsa8(Bin, Bout, X, r):
+ * Compute Bout = BlockMix_{salsa20/8, r}(Bin).  The input Bin must be 128r
+ * bytes in length; the output Bout must also be the same size.  X is kept
+ * in registers, the temporary space is unused.
+ */
+static void
+blockmix_salsa8(uint32_t * Bin, uint32_t * Bout, uint32_t * unused, size_t r)
+{
+	scrypt_v4u32 X[4];
+	size_t i, k;
+
+	(void)unused;
+
+	/* 1: X <-- B_{2r - 1} */
+	for (k = 0; k < 4; k++)
+		X[k] = load_v4(&Bin[(2 * r - 1) * 16 + 4 * k]);
+
+	/* 2: for i = 0 to 2r - 1 do */
+	for (i = 0; i < 2 * r; i++) {
+		/* 3: X <-- H(X \xor B_i) */
+		for (k = 0; k < 4; k++)
+			X[k] ^= load_v4(&Bin[i * 16 + 4 * k]);
+		salsa20_8_v(X);
+
+		/* 4: Y_i <-- X */
+		/* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
+		for (k = 0; k < 4; k++)
+			store_v4(&Bout[(i / 2 + (i & 1) * r) * 16 + 4 * k], X[k]);
+	}
+}
+
+/**
+ * blockmix_salsa8_xor(Bin1, Bin2, Bout, X, r):
+ * Compute Bout = BlockMix_{salsa20/8, r}(Bin1 xor Bin2), without writing
+ * the xor to memory.
+ */
+static void
+blockmix_salsa8_xor(uint32_t * Bin1, uint32_t * Bin2, uint32_t * Bout,
+    uint32_t * unused, size_t r)
+{
+	scrypt_v4u32 X[4];
+	size_t i, k;
+
+	(void)unused;
+
+	/* 1: X <-- B_{2r - 1} */
+	for (k = 0; k < 4; k++)
+		X[k] = load_v4(&Bin1[(2 * r - 1) * 16 + 4 * k]) ^
+		    load_v4(&Bin2[(2 * r - 1) * 16 + 4 * k]);
+
+	/* 2: for i = 0 to 2r - 1 do */
+	for (i = 0; i < 2 * r; i++) {
+		/* 3: X <-- H(X \xor B_i) */
+		for (k = 0; k < 4; k++)
+			X[k] ^= load_v4(&Bin1[i * 16 + 4 * k]) ^
+			    load_v4(&Bin2[i * 16 + 4 * k]);
+		salsa20_8_v(X);
+
+		/* 4: Y_i <-- X */
+		/* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
+		for (k = 0; k < 4; k++)
+			store_v4(&Bout[(i / 2 + (i & 1) * r) * 16 + 4 * k], X[k]);
+	}
+}
+
+#undef SHUFFLE
+
+#else /* !SCRYPT_SIMD */
 
 /**
  * salsa20_8(B):
@@ -151,6 +309,21 @@ blockmix_salsa8(uint32_t * Bin, uint32_t * Bout, uint32_t * X, size_t r)
 	}
 }
 
+/**
+ * blockmix_salsa8_xor(Bin1, Bin2, Bout, X, r):
+ * Compute Bout = BlockMix_{salsa20/8, r}(Bin1 xor Bin2), overwriting Bin1.
+ */
+static void
+blockmix_salsa8_xor(uint32_t * Bin1, uint32_t * Bin2, uint32_t * Bout,
+    uint32_t * X, size_t r)
+{
+
+	blkxor(Bin1, Bin2, 128 * r);
+	blockmix_salsa8(Bin1, Bout, X, r);
+}
+
+#endif /* SCRYPT_SIMD */
+
 /**
  * integerify(B, r):
  * Return the result of parsing B_{2r-1} as a little-endian integer.
@@ -160,9 +333,17 @@ integerify(void * B, size_t r)
 {
 	uint32_t * X = (void *)((uintptr_t)(B) + (2 * r - 1) * 64);
 
-	return (((uint64_t)(X[1]) << 32) + X[0]);
+	/* [wallet-core] word 1 of the block is stored at index 13 in diagonal order */
+	return (((uint64_t)(X[SCRYPT_SIMD ? 13 : 1]) << 32) + X[0]);
 }
 
+/* [wallet-core] Index in B of word k of X, see SCRYPT_SIMD */
+#if SCRYPT_SIMD
+#define SCRYPT_WORD(k) (((k) & ~(size_t)15) + (5 * (k)) % 16)
+#else
+#define SCRYPT_WORD(k) (k)
+#endif
+
 /**
  * smix(B, r, N, V, XY):
  * Compute B = SMix_r(B, N).  The input B must be 128r bytes in length;
@@ -183,7 +364,7 @@ smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
 
 	/* 1: X <-- B */
 	for (k = 0; k < 32 * r; k++)
-		X[k] = le32dec(&B[4 * k]);
+		X[k] = le32dec(&B[4 * SCRYPT_WORD(k)]);
 
 	/* 2: for i = 0 to N - 1 do */
 	for (i = 0; i < N; i += 2) {
@@ -206,20 +387,123 @@ smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
 		j = integerify(X, r) & (N - 1);
 
 		/* 8: X <-- H(X \xor V_j) */
-		blkxor(X, &V[j * (32 * r)], 128 * r);
-		blockmix_salsa8(X, Y, Z, r);
+		blockmix_salsa8_xor(X, &V[j * (32 * r)], Y, Z, r);
 
 		/* 7: j <-- Integerify(X) mod N */
 		j = integerify(Y, r) & (N - 1);
 
 		/* 8: X <-- H(X \xor V_j) */
-		blkxor(Y, &V[j * (32 * r)], 128 * r);
-		blockmix_salsa8(Y, X, Z, r);
+		blockmix_salsa8_xor(Y, &V[j * (32 * r)], X, Z, r);
 	}
 
 	/* 10: B' <-- X */
 	for (k = 0; k < 32 * r; k++)
-		le32enc(&B[4 * k], X[k]);
+		le32enc(&B[4 * SCRYPT_WORD(k)], X[k]);
+}
+
+/**
+ * smix_alloc(r, N, V0, V, XY0, XY):
+ * [wallet-core] Allocate the temporary storage V and XY of smix, aligned to
+ * 64 bytes.  Return 0 on success; or -1 on error, with errno set.
+ */
+static int
+smix_alloc(size_t r, uint64_t N, void ** V0, uint32_t ** V, void ** XY0,
+    uint32_t ** XY)
+{
+
+#ifdef HAVE_POSIX_MEMALIGN
+	if ((errno = posix_memalign(XY0, 64, 256 * r + 64)) != 0)
+		goto err0;
+	*XY = (uint32_t *)(*XY0);
+#ifndef MAP_ANON
+	if ((errno = posix_memalign(V0, 64, 128 * r * N)) != 0)
+		goto err1;
+	*V = (uint32_t *)(*V0);
+#endif
+#else
+	if ((*XY0 = malloc(256 * r + 64 + 63)) == NULL)
+		goto err0;
+	*XY = (uint32_t *)(((uintptr_t)(*XY0) + 63) & ~ (uintptr_t)(63));
+#ifndef MAP_ANON
+	if ((*V0 = malloc(128 * r * N + 63)) == NULL)
+		goto err1;
+	*V = (uint32_t *)(((uintptr_t)(*V0) + 63) & ~ (uintptr_t)(63));
+#endif
+#endif
+#ifdef MAP_ANON
+	if ((*V0 = mmap(NULL, 128 * r * N, PROT_READ | PROT_WRITE,
+#ifdef MAP_NOCORE
+	    MAP_ANON | MAP_PRIVATE | MAP_NOCORE,
+#else
+	    MAP_ANON | MAP_PRIVATE,
+#endif
+	    -1, 0)) == MAP_FAILED)
+		goto err1;
+	*V = (uint32_t *)(*V0);
+#endif
+	return (0);
+
+err1:
+	free(*XY0);
+err0:
+	return (-1);
+}
+
+/**
+ * smix_free(r, N, V0, XY0):
+ * [wallet-core] Free the storage allocated by smix_alloc.
+ * Return 0 on success; or -1 on error.
+ */
+static int
+smix_free(size_t r, uint64_t N, void * V0, void * XY0)
+{
+
+	free(XY0);
+#ifdef MAP_ANON
+	if (munmap(V0, 128 * r * N))
+		return (-1);
+#else
+	(void)r;
+	(void)N;
+	free(V0);
+#endif
+	return (0);
+}
+
+/* [wallet-core] Lanes of scrypt_parallel, split between workers */
+struct scrypt_lanes {
+	uint8_t * B;
+	size_t r;
+	uint64_t N;
+	uint32_t p;
+	uint32_t workers;
+	/* errno of each worker; 0 on success */
+	int * errors;
+};
+
+/**
+ * scrypt_worker(context, t):
+ * [wallet-core] Compute B_i <-- MF(B_i, N) for the lanes i of worker t, with
+ * temporary storage of its own.
+ */
+static void
+scrypt_worker(void * context, uint32_t t)
+{
+	struct scrypt_lanes * lanes = context;
+	const uint32_t first = (uint32_t)((uint64_t)t * lanes->p / lanes->workers);
+	const uint32_t last = (uint32_t)((uint64_t)(t + 1) * lanes->p / lanes->workers);
+	void * V0, * XY0;
+	uint32_t * V;
+	uint32_t * XY;
+	uint32_t i;
+
+	if (smix_alloc(lanes->r, lanes->N, &V0, &V, &XY0, &XY)) {
+		lanes->errors[t] = errno ? errno : ENOMEM;
+		return;
+	}
+	for (i = first; i < last; i++)
+		smix(&lanes->B[i * 128 * lanes->r], lanes->r, lanes->N, V, XY);
+	lanes->errors[t] = smix_free(lanes->r, lanes->N, V0, XY0) ? EINVAL : 0;
 }
 
 /**
@@ -236,6 +520,17 @@ scrypt(const uint8_t * passwd, size_t passwdlen,
     const uint8_t * salt, size_t saltlen, uint64_t N, uint32_t r, uint32_t p,
     uint8_t * buf, size_t buflen)
 {
+
+	return (scrypt_parallel(passwd, passwdlen, salt, saltlen, N, r, p, buf,
+	    buflen, 1, NULL, NULL));
+}
+
+int
+scrypt_parallel(const uint8_t * passwd, size_t passwdlen,
+    const uint8_t * salt, size_t saltlen, uint64_t N, uint32_t r, uint32_t p,
+    uint8_t * buf, size_t buflen, uint32_t workers,
+    scrypt_parallel_fn parallel, void * runner)
+{
 	void * B0, * V0, * XY0;
 	uint8_t * B;
 	uint32_t * V;
@@ -275,66 +570,58 @@ scrypt(const uint8_t * passwd, size_t passwdlen,
 	if ((errno = posix_memalign(&B0, 64, 128 * r * p)) != 0)
 		goto err0;
 	B = (uint8_t *)(B0);
-	if ((errno = posix_memalign(&XY0, 64, 256 * r + 64)) != 0)
-		goto err1;
-	XY = (uint32_t *)(XY0);
-#ifndef MAP_ANON
-	if ((errno = posix_memalign(&V0, 64, 128 * r * N)) != 0)
-		goto err2;
-	V = (uint32_t *)(V0);
-#endif
 #else
 	if ((B0 = malloc(128 * r * p + 63)) == NULL)
 		goto err0;
 	B = (uint8_t *)(((uintptr_t)(B0) + 63) & ~ (uintptr_t)(63));
-	if ((XY0 = malloc(256 * r + 64 + 63)) == NULL)
-		goto err1;
-	XY = (uint32_t *)(((uintptr_t)(XY0) + 63) & ~ (uintptr_t)(63));
-#ifndef MAP_ANON
-	if ((V0 = malloc(128 * r * N + 63)) == NULL)
-		goto err2;
-	V = (uint32_t *)(((uintptr_t)(V0) + 63) & ~ (uintptr_t)(63));
-#endif
-#endif
-#ifdef MAP_ANON
-	if ((V0 = mmap(NULL, 128 * r * N, PROT_READ | PROT_WRITE,
-#ifdef MAP_NOCORE
-	    MAP_ANON | MAP_PRIVATE | MAP_NOCORE,
-#else
-	    MAP_ANON | MAP_PRIVATE,
-#endif
-	    -1, 0)) == MAP_FAILED)
-		goto err2;
-	V = (uint32_t *)(V0);
 #endif
 
 	/* 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen) */
 	pbkdf2_hmac_sha256(passwd, passwdlen, salt, saltlen, 1, B, p * 128 * r);
 
 	/* 2: for i = 0 to p - 1 do */
-	for (i = 0; i < p; i++) {
-		/* 3: B_i <-- MF(B_i, N) */
-		smix(&B[i * 128 * r], r, N, V, XY);
+	if (workers > p)
+		workers = p;
+	if (parallel == NULL || workers <= 1) {
+		/* One lane at a time, sharing the temporary storage. */
+		if (smix_alloc(r, N, &V0, &V, &XY0, &XY))
+			goto err1;
+		for (i = 0; i < p; i++) {
+			/* 3: B_i <-- MF(B_i, N) */
+			smix(&B[i * 128 * r], r, N, V, XY);
+		}
+		if (smix_free(r, N, V0, XY0))
+			goto err1;
+	} else {
+		struct scrypt_lanes lanes;
+
+		if ((lanes.errors = calloc(workers, sizeof(int))) == NULL)
+			goto err1;
+		lanes.B = B;
+		lanes.r = r;
+		lanes.N = N;
+		lanes.p = p;
+		lanes.workers = workers;
+		parallel(scrypt_worker, &lanes, workers, runner);
+		for (i = 0; i < workers; i++) {
+			if (lanes.errors[i] != 0) {
+				errno = lanes.errors[i];
+				free(lanes.errors);
+				goto err1;
+			}
+		}
+		free(lanes.errors);
 	}
 
 	/* 5: DK <-- PBKDF2(P, B, 1, dkLen) */
 	pbkdf2_hmac_sha256(passwd, passwdlen, B, p * 128 * r, 1, buf, buflen);
 
 	/* Free memory. */
-#ifdef MAP_ANON
-	if (munmap(V0, 128 * r * N))
-		goto err2;
-#else
-	free(V0);
-#endif
-	free(XY0);
 	free(B0);
 
 	/* Success! */
 	return (0);
 
-err2:
-	free(XY0);
 err1:
 	free(B0);
 err0:
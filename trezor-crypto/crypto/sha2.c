@@ -33,6 +33,15 @@
 #include <TrezorCrypto/sha2.h>
 #include <TrezorCrypto/memzero.h>
 
+// [wallet-core]
+#include <stdatomic.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#endif
+
 /*
  * ASSERT NOTE:
  * Some sanity checking code is included using assert().  On my FreeBSD
@@ -332,7 +341,7 @@ void sha1_Init(SHA1_CTX* context) {
 	(b) = ROTL32(30, b);	\
 	j++;
 
-void sha1_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+static void sha1_Transform_generic(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a = 0, b = 0, c = 0, d = 0, e = 0;
 	sha2_word32	T1 = 0;
 	sha2_word32	W1[16] = {0};
@@ -450,7 +459,7 @@ void sha1_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_w
 
 #else  /* SHA2_UNROLL_TRANSFORM */
 
-void sha1_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+static void sha1_Transform_generic(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a = 0, b = 0, c = 0, d = 0, e = 0;
 	sha2_word32	T1 = 0;
 	sha2_word32	W1[16] = {0};
@@ -710,7 +719,7 @@ void sha256_Init(SHA256_CTX* context) {
 	(h) = T1 + Sigma0_256(a) + Maj((a), (b), (c)); \
 	j++
 
-void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+static void sha256_Transform_generic(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, s0 = 0, s1 = 0;
 	sha2_word32	T1 = 0;
 	sha2_word32 W256[16] = {0};
@@ -767,7 +776,7 @@ void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2
 
 #else /* SHA2_UNROLL_TRANSFORM */
 
-void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+static void sha256_Transform_generic(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, s0 = 0, s1 = 0;
 	sha2_word32	T1 = 0, T2 = 0 , W256[16] = {0};
 	int		j = 0;
@@ -838,6 +847,228 @@ void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2
 
 #endif /* SHA2_UNROLL_TRANSFORM */
 
+// [wallet-core] Hardware-accelerated SHA-1 and SHA-256 transforms, selected at runtime.
+// The message words passed to the transforms are already in host byte order, so the kernels
+// load them without the byte swap of the usual reference implementations.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA2_HW_X86 1
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define SHA2_HW_ARM 1
+#endif
+
+#if SHA2_HW_X86
+
+#define SHA2_HW_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+static int sha2_hw_detect(void) {
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	const int ssse3 = (ecx & (1u << 9)) != 0;
+	const int sse41 = (ecx & (1u << 19)) != 0;
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	const int sha = (ebx & (1u << 29)) != 0;
+	return ssse3 && sse41 && sha;
+}
+
+SHA2_HW_TARGET
+static void sha256_Transform_hw(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	__m128i msg[4];
+
+	/* Load the state as ABEF and CDGH */
+	__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state_in[0]), 0xB1);
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state_in[4]), 0x1B);
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+	const __m128i abef = state0;
+	const __m128i cdgh = state1;
+
+	for (int i = 0; i < 16; i++) {
+		__m128i m;
+		if (i < 4) {
+			m = _mm_loadu_si128((const __m128i*)(data + 4 * i));
+		} else {
+			m = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+			m = _mm_add_epi32(m, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+			m = _mm_sha256msg2_epu32(m, msg[(i + 3) & 3]);
+		}
+		msg[i & 3] = m;
+		__m128i k = _mm_add_epi32(m, _mm_loadu_si128((const __m128i*)&K256[4 * i]));
+		state1 = _mm_sha256rnds2_epu32(state1, state0, k);
+		k = _mm_shuffle_epi32(k, 0x0E);
+		state0 = _mm_sha256rnds2_epu32(state0, state1, k);
+	}
+
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+
+	/* Store the state back as ABCD and EFGH */
+	tmp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	_mm_storeu_si128((__m128i*)&state_out[0], _mm_blend_epi16(tmp, state1, 0xF0));
+	_mm_storeu_si128((__m128i*)&state_out[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+SHA2_HW_TARGET
+static void sha1_Transform_hw(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	__m128i msg[4];
+
+	__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state_in), 0x1B);
+	__m128i e0 = _mm_set_epi32((int)state_in[4], 0, 0, 0);
+	const __m128i abcd_save = abcd;
+	const __m128i e_save = e0;
+	__m128i e1 = e0;
+
+	for (int i = 0; i < 20; i++) {
+		__m128i m;
+		if (i < 4) {
+			m = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(data + 4 * i)), 0x1B);
+		} else {
+			m = _mm_sha1msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+			m = _mm_xor_si128(m, msg[(i + 2) & 3]);
+			m = _mm_sha1msg2_epu32(m, msg[(i + 3) & 3]);
+		}
+		msg[i & 3] = m;
+		e0 = i == 0 ? _mm_add_epi32(e0, m) : _mm_sha1nexte_epu32(e1, m);
+		e1 = abcd;
+		switch (i / 5) {
+			case 0: abcd = _mm_sha1rnds4_epu32(abcd, e0, 0); break;
+			case 1: abcd = _mm_sha1rnds4_epu32(abcd, e0, 1); break;
+			case 2: abcd = _mm_sha1rnds4_epu32(abcd, e0, 2); break;
+			default: abcd = _mm_sha1rnds4_epu32(abcd, e0, 3); break;
+		}
+	}
+
+	e0 = _mm_sha1nexte_epu32(e1, e_save);
+	abcd = _mm_shuffle_epi32(_mm_add_epi32(abcd, abcd_save), 0x1B);
+	_mm_storeu_si128((__m128i*)state_out, abcd);
+	state_out[4] = (sha2_word32)_mm_extract_epi32(e0, 3);
+}
+
+#elif SHA2_HW_ARM
+
+static int sha2_hw_detect(void) {
+	/* The crypto extension is required by the compilation target */
+	return 1;
+}
+
+static void sha256_Transform_hw(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	uint32x4_t msg[4];
+
+	uint32x4_t state0 = vld1q_u32(&state_in[0]);
+	uint32x4_t state1 = vld1q_u32(&state_in[4]);
+	const uint32x4_t abcd = state0;
+	const uint32x4_t efgh = state1;
+
+	for (int i = 0; i < 16; i++) {
+		if (i < 4) {
+			msg[i] = vld1q_u32(data + 4 * i);
+		} else {
+			msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]), msg[(i + 2) & 3], msg[(i + 3) & 3]);
+		}
+		const uint32x4_t k = vaddq_u32(msg[i & 3], vld1q_u32(&K256[4 * i]));
+		const uint32x4_t tmp = state0;
+		state0 = vsha256hq_u32(state0, state1, k);
+		state1 = vsha256h2q_u32(state1, tmp, k);
+	}
+
+	vst1q_u32(&state_out[0], vaddq_u32(state0, abcd));
+	vst1q_u32(&state_out[4], vaddq_u32(state1, efgh));
+}
+
+static void sha1_Transform_hw(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	static const sha2_word32 K1[4] = {K1_0_TO_19, K1_20_TO_39, K1_40_TO_59, K1_60_TO_79};
+	uint32x4_t msg[4];
+
+	uint32x4_t abcd = vld1q_u32(state_in);
+	uint32_t e0 = state_in[4];
+	const uint32x4_t abcd_save = abcd;
+	const uint32_t e_save = e0;
+
+	for (int i = 0; i < 20; i++) {
+		if (i < 4) {
+			msg[i] = vld1q_u32(data + 4 * i);
+		} else {
+			msg[i & 3] = vsha1su1q_u32(vsha1su0q_u32(msg[i & 3], msg[(i + 1) & 3], msg[(i + 2) & 3]), msg[(i + 3) & 3]);
+		}
+		const uint32x4_t k = vaddq_u32(msg[i & 3], vdupq_n_u32(K1[i / 5]));
+		const uint32_t e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+		if (i < 5) {
+			abcd = vsha1cq_u32(abcd, e0, k);
+		} else if (i < 10 || i >= 15) {
+			abcd = vsha1pq_u32(abcd, e0, k);
+		} else {
+			abcd = vsha1mq_u32(abcd, e0, k);
+		}
+		e0 = e1;
+	}
+
+	vst1q_u32(state_out, vaddq_u32(abcd, abcd_save));
+	state_out[4] = e0 + e_save;
+}
+
+#endif
+
+typedef void (*sha2_transform_fn)(const sha2_word32*, const sha2_word32*, sha2_word32*);
+
+static void sha1_Transform_select(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out);
+static void sha256_Transform_select(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out);
+
+#if !(SHA2_HW_X86 || SHA2_HW_ARM)
+/* Never selected, sha2_hw_supported returns 0 */
+#define sha1_Transform_hw sha1_Transform_generic
+#define sha256_Transform_hw sha256_Transform_generic
+#endif
+
+/*
+ * Resolved on the first call, unless sha2_hw_set_enabled chose first.  Transforms may run on
+ * several threads, so the pointers are atomic; they only refer to code, relaxed accesses suffice.
+ */
+static _Atomic(sha2_transform_fn) sha1_transform_impl = sha1_Transform_select;
+static _Atomic(sha2_transform_fn) sha256_transform_impl = sha256_Transform_select;
+
+int sha2_hw_supported(void) {
+#if SHA2_HW_X86 || SHA2_HW_ARM
+	return sha2_hw_detect();
+#else
+	return 0;
+#endif
+}
+
+void sha2_hw_set_enabled(int enabled) {
+	const int hw = enabled && sha2_hw_supported();
+	atomic_store_explicit(&sha1_transform_impl, hw ? sha1_Transform_hw : sha1_Transform_generic, memory_order_relaxed);
+	atomic_store_explicit(&sha256_transform_impl, hw ? sha256_Transform_hw : sha256_Transform_generic, memory_order_relaxed);
+}
+
+/* Replaces the selector by the default transform, unless sha2_hw_set_enabled stored one meanwhile */
+static sha2_transform_fn sha2_transform_resolve(_Atomic(sha2_transform_fn)* impl, sha2_transform_fn select, sha2_transform_fn generic, sha2_transform_fn hw) {
+	sha2_transform_fn resolved = sha2_hw_supported() ? hw : generic;
+	if (!atomic_compare_exchange_strong_explicit(impl, &select, resolved, memory_order_relaxed, memory_order_relaxed)) {
+		resolved = select;
+	}
+	return resolved;
+}
+
+static void sha1_Transform_select(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	sha2_transform_resolve(&sha1_transform_impl, sha1_Transform_select, sha1_Transform_generic, sha1_Transform_hw)(state_in, data, state_out);
+}
+
+static void sha256_Transform_select(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	sha2_transform_resolve(&sha256_transform_impl, sha256_Transform_select, sha256_Transform_generic, sha256_Transform_hw)(state_in, data, state_out);
+}
+
+void sha1_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	atomic_load_explicit(&sha1_transform_impl, memory_order_relaxed)(state_in, data, state_out);
+}
+
+void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+	atomic_load_explicit(&sha256_transform_impl, memory_order_relaxed)(state_in, data, state_out);
+}
+
 void sha256_Update(SHA256_CTX* context, const sha2_byte *data, size_t len) {
 	unsigned int	freespace = 0, usedspace = 0;
 
@@ -1315,3 +1546,356 @@ char* sha512_Data(const sha2_byte* data, size_t len, char digest[SHA512_DIGEST_S
 	sha512_Update(&context, data, len);
 	return sha512_End(&context, digest);
 }
+
+// [wallet-core] PBKDF2-HMAC-SHA512 iterations. Each iteration hashes the previous 64-byte digest
+// U after the precomputed key pad states, so both compressions take a block made of U and constant
+// padding; U stays in host-order words, and the constant half of the block is folded into the rounds.
+#define SHA512_DIGEST_BLOCK_BITS ((SHA512_BLOCK_LENGTH + SHA512_DIGEST_LENGTH) * 8)
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define SHA512_UNROLL_LOOP _Pragma("GCC unroll 16")
+#else
+#define SHA512_UNROLL_LOOP
+#endif
+
+/* Replaces the 8 words of `u` with the compression of `state` and the padded block of `u`. */
+#define SHA512_COMPRESS_DIGEST(T, state, u) do { \
+	T W[16]; \
+	T a = (state)[0], b = (state)[1], c = (state)[2], d = (state)[3]; \
+	T e = (state)[4], f = (state)[5], g = (state)[6], h = (state)[7]; \
+	T T1, T2; \
+	SHA512_UNROLL_LOOP \
+	for (int j = 0; j < 16; j++) { \
+		if (j < 8) { \
+			W[j] = (u)[j]; \
+			T1 = h + Sigma1_512(e) + Ch(e, f, g) + K512[j] + W[j]; \
+		} else { \
+			const sha2_word64 pad = j == 8 ? 0x8000000000000000ULL : j == 15 ? SHA512_DIGEST_BLOCK_BITS : 0; \
+			W[j] = ((T){0}) + pad; \
+			T1 = h + Sigma1_512(e) + Ch(e, f, g) + (K512[j] + pad); \
+		} \
+		T2 = Sigma0_512(a) + Maj(a, b, c); \
+		h = g; g = f; f = e; e = d + T1; d = c; c = b; b = a; a = T1 + T2; \
+	} \
+	SHA512_UNROLL_LOOP \
+	for (int j = 16; j < 80; j++) { \
+		W[j & 15] += sigma1_512(W[(j + 14) & 15]) + W[(j + 9) & 15] + sigma0_512(W[(j + 1) & 15]); \
+		T1 = h + Sigma1_512(e) + Ch(e, f, g) + K512[j] + W[j & 15]; \
+		T2 = Sigma0_512(a) + Maj(a, b, c); \
+		h = g; g = f; f = e; e = d + T1; d = c; c = b; b = a; a = T1 + T2; \
+	} \
+	(u)[0] = (state)[0] + a; (u)[1] = (state)[1] + b; (u)[2] = (state)[2] + c; (u)[3] = (state)[3] + d; \
+	(u)[4] = (state)[4] + e; (u)[5] = (state)[5] + f; (u)[6] = (state)[6] + g; (u)[7] = (state)[7] + h; \
+} while (0)
+
+void sha512_pbkdf2_iterate(const uint64_t istate[8], const uint64_t ostate[8], uint64_t u[8], uint64_t x[8], uint32_t iterations) {
+	for (uint32_t i = 0; i < iterations; i++) {
+		SHA512_COMPRESS_DIGEST(sha2_word64, istate, u);
+		SHA512_COMPRESS_DIGEST(sha2_word64, ostate, u);
+		for (int k = 0; k < 8; k++) {
+			x[k] ^= u[k];
+		}
+	}
+}
+
+// [wallet-core] Multi-buffer SHA-256 and SHA-512: 8 (resp. 4) independent messages of equal length
+// hashed together, with one message per vector lane. The kernels are written with compiler vector
+// extensions and lowered to AVX2 (selected at runtime), SSE2 or NEON depending on the target.
+#if defined(__GNUC__)
+
+typedef sha2_word32 sha2_v8u32 __attribute__((vector_size(32)));
+typedef sha2_word64 sha2_v4u64 __attribute__((vector_size(32)));
+
+#define ROTR_V(x, n, bits) (((x) >> (n)) | ((x) << ((bits) - (n))))
+
+static inline sha2_word32 load_be32(const sha2_byte* p) {
+	return ((sha2_word32)p[0] << 24) | ((sha2_word32)p[1] << 16) | ((sha2_word32)p[2] << 8) | p[3];
+}
+
+static inline sha2_word64 load_be64(const sha2_byte* p) {
+	return ((sha2_word64)load_be32(p) << 32) | load_be32(p + 4);
+}
+
+/*
+ * Writes the padding of the last `len % block` bytes of a message of `len` bytes to `tail`,
+ * which holds two blocks, and returns the number of tail blocks.
+ */
+static size_t sha2_multi_tail(const sha2_byte* data, size_t len, size_t block, size_t lengthSize, sha2_byte* tail) {
+	const size_t rest = len % block;
+	const size_t blocks = rest + 1 + lengthSize <= block ? 1 : 2;
+	const sha2_word64 bits = (sha2_word64)len << 3;
+	memset(tail, 0, 2 * block);
+	if (rest > 0) {
+		memcpy(tail, data + len - rest, rest);
+	}
+	tail[rest] = 0x80;
+	for (size_t i = 0; i < 8; i++) {
+		tail[blocks * block - 1 - i] = (sha2_byte)(bits >> (8 * i));
+	}
+	return blocks;
+}
+
+static inline __attribute__((always_inline)) void sha256_Raw_x8_body(const sha2_byte* const data[8], size_t len, sha2_byte digest[8][SHA256_DIGEST_LENGTH]) {
+	sha2_byte tail[8][2 * SHA256_BLOCK_LENGTH];
+	size_t blocks = len / SHA256_BLOCK_LENGTH;
+	size_t tailBlocks = 0;
+	for (int l = 0; l < 8; l++) {
+		tailBlocks = sha2_multi_tail(data[l], len, SHA256_BLOCK_LENGTH, 8, tail[l]);
+	}
+
+	sha2_v8u32 state[8];
+	for (int i = 0; i < 8; i++) {
+		state[i] = (sha2_v8u32){0} + sha256_initial_hash_value[i];
+	}
+
+	for (size_t b = 0; b < blocks + tailBlocks; b++) {
+		sha2_v8u32 W[16];
+		for (int l = 0; l < 8; l++) {
+			const sha2_byte* p = b < blocks ? data[l] + b * SHA256_BLOCK_LENGTH : tail[l] + (b - blocks) * SHA256_BLOCK_LENGTH;
+			for (int j = 0; j < 16; j++) {
+				W[j][l] = load_be32(p + 4 * j);
+			}
+		}
+
+		sha2_v8u32 a = state[0], b_ = state[1], c = state[2], d = state[3];
+		sha2_v8u32 e = state[4], f = state[5], g = state[6], h = state[7];
+		for (int j = 0; j < 64; j++) {
+			sha2_v8u32 w;
+			if (j < 16) {
+				w = W[j];
+			} else {
+				const sha2_v8u32 w15 = W[(j + 1) & 15], w2 = W[(j + 14) & 15];
+				const sha2_v8u32 s0 = ROTR_V(w15, 7, 32) ^ ROTR_V(w15, 18, 32) ^ (w15 >> 3);
+				const sha2_v8u32 s1 = ROTR_V(w2, 17, 32) ^ ROTR_V(w2, 19, 32) ^ (w2 >> 10);
+				w = W[j & 15] = W[j & 15] + s0 + W[(j + 9) & 15] + s1;
+			}
+			const sha2_v8u32 T1 = h + (ROTR_V(e, 6, 32) ^ ROTR_V(e, 11, 32) ^ ROTR_V(e, 25, 32)) +
+			                      ((e & f) ^ (~e & g)) + K256[j] + w;
+			const sha2_v8u32 T2 = (ROTR_V(a, 2, 32) ^ ROTR_V(a, 13, 32) ^ ROTR_V(a, 22, 32)) +
+			                      ((a & b_) ^ (a & c) ^ (b_ & c));
+			h = g;
+			g = f;
+			f = e;
+			e = d + T1;
+			d = c;
+			c = b_;
+			b_ = a;
+			a = T1 + T2;
+		}
+		state[0] += a;
+		state[1] += b_;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+	}
+
+	for (int l = 0; l < 8; l++) {
+		for (int i = 0; i < 8; i++) {
+			const sha2_word32 v = state[i][l];
+			digest[l][4 * i] = (sha2_byte)(v >> 24);
+			digest[l][4 * i + 1] = (sha2_byte)(v >> 16);
+			digest[l][4 * i + 2] = (sha2_byte)(v >> 8);
+			digest[l][4 * i + 3] = (sha2_byte)v;
+		}
+	}
+	for (int l = 0; l < 8; l++) {
+		memzero(tail[l], len % SHA256_BLOCK_LENGTH);
+	}
+}
+
+static inline __attribute__((always_inline)) void sha512_Raw_x4_body(const sha2_byte* const data[4], size_t len, sha2_byte digest[4][SHA512_DIGEST_LENGTH]) {
+	sha2_byte tail[4][2 * SHA512_BLOCK_LENGTH];
+	size_t blocks = len / SHA512_BLOCK_LENGTH;
+	size_t tailBlocks = 0;
+	for (int l = 0; l < 4; l++) {
+		tailBlocks = sha2_multi_tail(data[l], len, SHA512_BLOCK_LENGTH, 16, tail[l]);
+	}
+
+	sha2_v4u64 state[8];
+	for (int i = 0; i < 8; i++) {
+		state[i] = (sha2_v4u64){0} + sha512_initial_hash_value[i];
+	}
+
+	for (size_t b = 0; b < blocks + tailBlocks; b++) {
+		sha2_v4u64 W[16];
+		for (int l = 0; l < 4; l++) {
+			const sha2_byte* p = b < blocks ? data[l] + b * SHA512_BLOCK_LENGTH : tail[l] + (b - blocks) * SHA512_BLOCK_LENGTH;
+			for (int j = 0; j < 16; j++) {
+				W[j][l] = load_be64(p + 8 * j);
+			}
+		}
+
+		sha2_v4u64 a = state[0], b_ = state[1], c = state[2], d = state[3];
+		sha2_v4u64 e = state[4], f = state[5], g = state[6], h = state[7];
+		for (int j = 0; j < 80; j++) {
+			sha2_v4u64 w;
+			if (j < 16) {
+				w = W[j];
+			} else {
+				const sha2_v4u64 w15 = W[(j + 1) & 15], w2 = W[(j + 14) & 15];
+				const sha2_v4u64 s0 = ROTR_V(w15, 1, 64) ^ ROTR_V(w15, 8, 64) ^ (w15 >> 7);
+				const sha2_v4u64 s1 = ROTR_V(w2, 19, 64) ^ ROTR_V(w2, 61, 64) ^ (w2 >> 6);
+				w = W[j & 15] = W[j & 15] + s0 + W[(j + 9) & 15] + s1;
+			}
+			const sha2_v4u64 T1 = h + (ROTR_V(e, 14, 64) ^ ROTR_V(e, 18, 64) ^ ROTR_V(e, 41, 64)) +
+			                      ((e & f) ^ (~e & g)) + K512[j] + w;
+			const sha2_v4u64 T2 = (ROTR_V(a, 28, 64) ^ ROTR_V(a, 34, 64) ^ ROTR_V(a, 39, 64)) +
+			                      ((a & b_) ^ (a & c) ^ (b_ & c));
+			h = g;
+			g = f;
+			f = e;
+			e = d + T1;
+			d = c;
+			c = b_;
+			b_ = a;
+			a = T1 + T2;
+		}
+		state[0] += a;
+		state[1] += b_;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+	}
+
+	for (int l = 0; l < 4; l++) {
+		for (int i = 0; i < 8; i++) {
+			const sha2_word64 v = state[i][l];
+			for (int k = 0; k < 8; k++) {
+				digest[l][8 * i + k] = (sha2_byte)(v >> (56 - 8 * k));
+			}
+		}
+	}
+	for (int l = 0; l < 4; l++) {
+		memzero(tail[l], len % SHA512_BLOCK_LENGTH);
+	}
+}
+
+static inline __attribute__((always_inline)) void sha512_pbkdf2_iterate_x4_body(const uint64_t istate[4][8], const uint64_t ostate[4][8], uint64_t u[4][8], uint64_t x[4][8], uint32_t iterations) {
+	sha2_v4u64 is[8], os[8], vu[8], vf[8];
+	for (int i = 0; i < 8; i++) {
+		for (int l = 0; l < 4; l++) {
+			is[i][l] = istate[l][i];
+			os[i][l] = ostate[l][i];
+			vu[i][l] = u[l][i];
+			vf[i][l] = x[l][i];
+		}
+	}
+	for (uint32_t n = 0; n < iterations; n++) {
+		SHA512_COMPRESS_DIGEST(sha2_v4u64, is, vu);
+		SHA512_COMPRESS_DIGEST(sha2_v4u64, os, vu);
+		for (int k = 0; k < 8; k++) {
+			vf[k] ^= vu[k];
+		}
+	}
+	for (int i = 0; i < 8; i++) {
+		for (int l = 0; l < 4; l++) {
+			u[l][i] = vu[i][l];
+			x[l][i] = vf[i][l];
+		}
+	}
+	memzero(is, sizeof(is));
+	memzero(os, sizeof(os));
+	memzero(vu, sizeof(vu));
+	memzero(vf, sizeof(vf));
+}
+
+static void sha256_Raw_x8_generic(const sha2_byte* const data[8], size_t len, sha2_byte digest[8][SHA256_DIGEST_LENGTH]) {
+	sha256_Raw_x8_body(data, len, digest);
+}
+
+static void sha512_Raw_x4_generic(const sha2_byte* const data[4], size_t len, sha2_byte digest[4][SHA512_DIGEST_LENGTH]) {
+	sha512_Raw_x4_body(data, len, digest);
+}
+
+static void sha512_pbkdf2_iterate_x4_generic(const uint64_t istate[4][8], const uint64_t ostate[4][8], uint64_t u[4][8], uint64_t x[4][8], uint32_t iterations) {
+	sha512_pbkdf2_iterate_x4_body(istate, ostate, u, x, iterations);
+}
+
+#if SHA2_HW_X86 && defined(__x86_64__)
+#define SHA2_MULTI_AVX2 1
+
+__attribute__((target("avx2")))
+static void sha256_Raw_x8_avx2(const sha2_byte* const data[8], size_t len, sha2_byte digest[8][SHA256_DIGEST_LENGTH]) {
+	sha256_Raw_x8_body(data, len, digest);
+}
+
+__attribute__((target("avx2")))
+static void sha512_Raw_x4_avx2(const sha2_byte* const data[4], size_t len, sha2_byte digest[4][SHA512_DIGEST_LENGTH]) {
+	sha512_Raw_x4_body(data, len, digest);
+}
+
+__attribute__((target("avx2")))
+static void sha512_pbkdf2_iterate_x4_avx2(const uint64_t istate[4][8], const uint64_t ostate[4][8], uint64_t u[4][8], uint64_t x[4][8], uint32_t iterations) {
+	sha512_pbkdf2_iterate_x4_body(istate, ostate, u, x, iterations);
+}
+
+/* Detected on first use; racing threads store the same value */
+static int sha2_multi_avx2(void) {
+	static atomic_int avx2 = -1;
+	int supported = atomic_load_explicit(&avx2, memory_order_relaxed);
+	if (supported < 0) {
+		__builtin_cpu_init();
+		supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+		atomic_store_explicit(&avx2, supported, memory_order_relaxed);
+	}
+	return supported;
+}
+#endif
+
+void sha256_Raw_x8(const sha2_byte* const data[8], size_t len, uint8_t digest[8][SHA256_DIGEST_LENGTH]) {
+#if SHA2_MULTI_AVX2
+	if (sha2_multi_avx2()) {
+		sha256_Raw_x8_avx2(data, len, digest);
+		return;
+	}
+#endif
+	sha256_Raw_x8_generic(data, len, digest);
+}
+
+void sha512_Raw_x4(const sha2_byte* const data[4], size_t len, uint8_t digest[4][SHA512_DIGEST_LENGTH]) {
+#if SHA2_MULTI_AVX2
+	if (sha2_multi_avx2()) {
+		sha512_Raw_x4_avx2(data, len, digest);
+		return;
+	}
+#endif
+	sha512_Raw_x4_generic(data, len, digest);
+}
+
+void sha512_pbkdf2_iterate_x4(const uint64_t istate[4][8], const uint64_t ostate[4][8], uint64_t u[4][8], uint64_t x[4][8], uint32_t iterations) {
+#if SHA2_MULTI_AVX2
+	if (sha2_multi_avx2()) {
+		sha512_pbkdf2_iterate_x4_avx2(istate, ostate, u, x, iterations);
+		return;
+	}
+#endif
+	sha512_pbkdf2_iterate_x4_generic(istate, ostate, u, x, iterations);
+}
+
+#else /* !__GNUC__ */
+
+void sha256_Raw_x8(const sha2_byte* const data[8], size_t len, uint8_t digest[8][SHA256_DIGEST_LENGTH]) {
+	for (int l = 0; l < 8; l++) {
+		sha256_Raw(data[l], len, digest[l]);
+	}
+}
+
+void sha512_Raw_x4(const sha2_byte* const data[4], size_t len, uint8_t digest[4][SHA512_DIGEST_LENGTH]) {
+	for (int l = 0; l < 4; l++) {
+		sha512_Raw(data[l], len, digest[l]);
+	}
+}
+
+void sha512_pbkdf2_iterate_x4(const uint64_t istate[4][8], const uint64_t ostate[4][8], uint64_t u[4][8], uint64_t x[4][8], uint32_t iterations) {
+	for (int l = 0; l < 4; l++) {
+		sha512_pbkdf2_iterate(istate[l], ostate[l], u[l], x[l], iterations);
+	}
+}
+
+#endif /* __GNUC__ */
@@ -18,6 +18,7 @@
  */
 
 #include <assert.h>
+#include <stdatomic.h> // [wallet-core]
 #include <string.h>
 
 #include <TrezorCrypto/sha3.h>
@@ -93,115 +94,139 @@ void sha3_512_Init(SHA3_CTX *ctx)
 	keccak_Init(ctx, 512);
 }
 
-/* Keccak theta() transformation */
-static void keccak_theta(uint64_t *A)
-{
-	unsigned int x = 0;
-	uint64_t C[5] = {0}, D[5] = {0};
-
-	for (x = 0; x < 5; x++) {
-		C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
-	}
-	D[0] = ROTL64(C[1], 1) ^ C[4];
-	D[1] = ROTL64(C[2], 1) ^ C[0];
-	D[2] = ROTL64(C[3], 1) ^ C[1];
-	D[3] = ROTL64(C[4], 1) ^ C[2];
-	D[4] = ROTL64(C[0], 1) ^ C[3];
-
-	for (x = 0; x < 5; x++) {
-		A[x]      ^= D[x];
-		A[x + 5]  ^= D[x];
-		A[x + 10] ^= D[x];
-		A[x + 15] ^= D[x];
-		A[x + 20] ^= D[x];
-	}
-}
-
-/* Keccak pi() transformation */
-static void keccak_pi(uint64_t *A)
-{
-	uint64_t A1 = 0;
-	A1 = A[1];
-	A[ 1] = A[ 6];
-	A[ 6] = A[ 9];
-	A[ 9] = A[22];
-	A[22] = A[14];
-	A[14] = A[20];
-	A[20] = A[ 2];
-	A[ 2] = A[12];
-	A[12] = A[13];
-	A[13] = A[19];
-	A[19] = A[23];
-	A[23] = A[15];
-	A[15] = A[ 4];
-	A[ 4] = A[24];
-	A[24] = A[21];
-	A[21] = A[ 8];
-	A[ 8] = A[16];
-	A[16] = A[ 5];
-	A[ 5] = A[ 3];
-	A[ 3] = A[18];
-	A[18] = A[17];
-	A[17] = A[11];
-	A[11] = A[ 7];
-	A[ 7] = A[10];
-	A[10] = A1;
-	/* note: A[ 0] is left as is */
-}
-
-/* Keccak chi() transformation */
-static void keccak_chi(uint64_t *A)
-{
-	int i = 0;
-	for (i = 0; i < 25; i += 5) {
-		uint64_t A0 = A[0 + i], A1 = A[1 + i];
-		A[0 + i] ^= ~A1 & A[2 + i];
-		A[1 + i] ^= ~A[2 + i] & A[3 + i];
-		A[2 + i] ^= ~A[3 + i] & A[4 + i];
-		A[3 + i] ^= ~A[4 + i] & A0;
-		A[4 + i] ^= ~A0 & A1;
-	}
-}
+/*
+ * [wallet-core] Keccak-f[1600] unrolled over named lanes, with two rounds per iteration so that
+ * the state stays in registers, after the "lane complementing" optimised implementation of the
+ * Keccak team: the lanes be, bi, go, ki, mi and sa are kept complemented during the permutation,
+ * which saves most of the NOT operations of chi().
+ * Lanes are named after their row (b, g, k, m, s) and column (a, e, i, o, u); the macros work on
+ * uint64_t as well as on vectors of them, see keccak_256_x4().
+ */
+#define KECCAK_ROUND(A, E, rc) \
+	Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa; \
+	Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se; \
+	Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si; \
+	Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so; \
+	Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su; \
+	Da = Cu ^ ROTL64(Ce, 1); \
+	De = Ca ^ ROTL64(Ci, 1); \
+	Di = Ce ^ ROTL64(Co, 1); \
+	Do = Ci ^ ROTL64(Cu, 1); \
+	Du = Co ^ ROTL64(Ca, 1); \
+	B0 = A##ba ^ Da; \
+	B1 = ROTL64(A##ge ^ De, 44); \
+	B2 = ROTL64(A##ki ^ Di, 43); \
+	B3 = ROTL64(A##mo ^ Do, 21); \
+	B4 = ROTL64(A##su ^ Du, 14); \
+	E##ba = B0 ^ (B1 | B2) ^ (rc); \
+	E##be = B1 ^ (~B2 | B3); \
+	E##bi = B2 ^ (B3 & B4); \
+	E##bo = B3 ^ (B4 | B0); \
+	E##bu = B4 ^ (B0 & B1); \
+	B0 = ROTL64(A##bo ^ Do, 28); \
+	B1 = ROTL64(A##gu ^ Du, 20); \
+	B2 = ROTL64(A##ka ^ Da, 3); \
+	B3 = ROTL64(A##me ^ De, 45); \
+	B4 = ROTL64(A##si ^ Di, 61); \
+	E##ga = B0 ^ (B1 | B2); \
+	E##ge = B1 ^ (B2 & B3); \
+	E##gi = B2 ^ (B3 | ~B4); \
+	E##go = B3 ^ (B4 | B0); \
+	E##gu = B4 ^ (B0 & B1); \
+	B0 = ROTL64(A##be ^ De, 1); \
+	B1 = ROTL64(A##gi ^ Di, 6); \
+	B2 = ROTL64(A##ko ^ Do, 25); \
+	B3 = ROTL64(A##mu ^ Du, 8); \
+	B4 = ROTL64(A##sa ^ Da, 18); \
+	E##ka = B0 ^ (B1 | B2); \
+	E##ke = B1 ^ (B2 & B3); \
+	E##ki = B2 ^ (~B3 & B4); \
+	E##ko = B3 ^ ~(B4 | B0); \
+	E##ku = B4 ^ (B0 & B1); \
+	B0 = ROTL64(A##bu ^ Du, 27); \
+	B1 = ROTL64(A##ga ^ Da, 36); \
+	B2 = ROTL64(A##ke ^ De, 10); \
+	B3 = ROTL64(A##mi ^ Di, 15); \
+	B4 = ROTL64(A##so ^ Do, 56); \
+	E##ma = B0 ^ (B1 & B2); \
+	E##me = B1 ^ (B2 | B3); \
+	E##mi = B2 ^ (~B3 | B4); \
+	E##mo = B3 ^ ~(B4 & B0); \
+	E##mu = B4 ^ (B0 | B1); \
+	B0 = ROTL64(A##bi ^ Di, 62); \
+	B1 = ROTL64(A##go ^ Do, 55); \
+	B2 = ROTL64(A##ku ^ Du, 39); \
+	B3 = ROTL64(A##ma ^ Da, 41); \
+	B4 = ROTL64(A##se ^ De, 2); \
+	E##sa = B0 ^ (~B1 & B2); \
+	E##se = B1 ^ ~(B2 | B3); \
+	E##si = B2 ^ (B3 & B4); \
+	E##so = B3 ^ (B4 | B0); \
+	E##su = B4 ^ (B0 & B1);
+
+#define KECCAK_PERMUTATION(T, S) do { \
+	T Aba, Abe, Abi, Abo, Abu, Aga, Age, Agi, Ago, Agu, Aka, Ake, Aki, Ako, Aku, Ama, Ame, Ami, Amo, Amu, Asa, Ase, Asi, Aso, Asu; \
+	T Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku, Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu; \
+	T Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du, B0, B1, B2, B3, B4; \
+	Aba = (S)[0]; \
+	Abe = ~(S)[1]; \
+	Abi = ~(S)[2]; \
+	Abo = (S)[3]; \
+	Abu = (S)[4]; \
+	Aga = (S)[5]; \
+	Age = (S)[6]; \
+	Agi = (S)[7]; \
+	Ago = ~(S)[8]; \
+	Agu = (S)[9]; \
+	Aka = (S)[10]; \
+	Ake = (S)[11]; \
+	Aki = ~(S)[12]; \
+	Ako = (S)[13]; \
+	Aku = (S)[14]; \
+	Ama = (S)[15]; \
+	Ame = (S)[16]; \
+	Ami = ~(S)[17]; \
+	Amo = (S)[18]; \
+	Amu = (S)[19]; \
+	Asa = ~(S)[20]; \
+	Ase = (S)[21]; \
+	Asi = (S)[22]; \
+	Aso = (S)[23]; \
+	Asu = (S)[24]; \
+	for (int round = 0; round < NumberOfRounds; round += 2) { \
+		KECCAK_ROUND(A, E, keccak_round_constants[round]); \
+		KECCAK_ROUND(E, A, keccak_round_constants[round + 1]); \
+	} \
+	(S)[0] = Aba; \
+	(S)[1] = ~Abe; \
+	(S)[2] = ~Abi; \
+	(S)[3] = Abo; \
+	(S)[4] = Abu; \
+	(S)[5] = Aga; \
+	(S)[6] = Age; \
+	(S)[7] = Agi; \
+	(S)[8] = ~Ago; \
+	(S)[9] = Agu; \
+	(S)[10] = Aka; \
+	(S)[11] = Ake; \
+	(S)[12] = ~Aki; \
+	(S)[13] = Ako; \
+	(S)[14] = Aku; \
+	(S)[15] = Ama; \
+	(S)[16] = Ame; \
+	(S)[17] = ~Ami; \
+	(S)[18] = Amo; \
+	(S)[19] = Amu; \
+	(S)[20] = ~Asa; \
+	(S)[21] = Ase; \
+	(S)[22] = Asi; \
+	(S)[23] = Aso; \
+	(S)[24] = Asu; \
+} while (0)
 
 static void sha3_permutation(uint64_t *state)
 {
-	int round = 0;
-	for (round = 0; round < NumberOfRounds; round++)
-	{
-		keccak_theta(state);
-
-		/* apply Keccak rho() transformation */
-		state[ 1] = ROTL64(state[ 1],  1);
-		state[ 2] = ROTL64(state[ 2], 62);
-		state[ 3] = ROTL64(state[ 3], 28);
-		state[ 4] = ROTL64(state[ 4], 27);
-		state[ 5] = ROTL64(state[ 5], 36);
-		state[ 6] = ROTL64(state[ 6], 44);
-		state[ 7] = ROTL64(state[ 7],  6);
-		state[ 8] = ROTL64(state[ 8], 55);
-		state[ 9] = ROTL64(state[ 9], 20);
-		state[10] = ROTL64(state[10],  3);
-		state[11] = ROTL64(state[11], 10);
-		state[12] = ROTL64(state[12], 43);
-		state[13] = ROTL64(state[13], 25);
-		state[14] = ROTL64(state[14], 39);
-		state[15] = ROTL64(state[15], 41);
-		state[16] = ROTL64(state[16], 45);
-		state[17] = ROTL64(state[17], 15);
-		state[18] = ROTL64(state[18], 21);
-		state[19] = ROTL64(state[19],  8);
-		state[20] = ROTL64(state[20], 18);
-		state[21] = ROTL64(state[21],  2);
-		state[22] = ROTL64(state[22], 61);
-		state[23] = ROTL64(state[23], 56);
-		state[24] = ROTL64(state[24], 14);
-
-		keccak_pi(state);
-		keccak_chi(state);
-
-		/* apply iota(state, round) */
-		*state ^= keccak_round_constants[round];
-	}
+	KECCAK_PERMUTATION(uint64_t, state);
 }
 
 /**
@@ -378,6 +403,105 @@ void keccak_512(const unsigned char* data, size_t len, unsigned char* digest)
 	keccak_Update(&ctx, data, len);
 	keccak_Final(&ctx, digest);
 }
+
+// [wallet-core] 4-way Keccak-256: the permutation of 4 independent states, one per vector lane,
+// lowered to AVX2 (selected at runtime), SSE2 or NEON depending on the target.
+#if defined(__GNUC__)
+
+typedef uint64_t keccak_v4u64 __attribute__((vector_size(32)));
+
+static inline __attribute__((always_inline)) void keccak_256_x4_body(const unsigned char* const data[4], size_t len, unsigned char digest[4][sha3_256_hash_size])
+{
+	const size_t block_size = SHA3_256_BLOCK_LENGTH;
+	keccak_v4u64 state[sha3_max_permutation_size];
+	unsigned char tail[4][SHA3_256_BLOCK_LENGTH];
+	memset(state, 0, sizeof(state));
+
+	for (size_t offset = 0;; offset += block_size) {
+		const size_t rest = len - offset;
+		for (int l = 0; l < 4; l++) {
+			const unsigned char* block = data[l] + offset;
+			if (rest < block_size) {
+				/* keccak padding of the last block */
+				memset(tail[l], 0, block_size);
+				if (rest > 0) {
+					memcpy(tail[l], block, rest);
+				}
+				tail[l][rest] |= 0x01;
+				tail[l][block_size - 1] |= 0x80;
+				block = tail[l];
+			}
+			for (size_t i = 0; i < block_size / 8; i++) {
+				uint64_t word = 0;
+				memcpy(&word, block + 8 * i, 8);
+				state[i][l] ^= le2me_64(word);
+			}
+		}
+		KECCAK_PERMUTATION(keccak_v4u64, state);
+		if (rest < block_size) {
+			break;
+		}
+	}
+
+	for (int l = 0; l < 4; l++) {
+		for (int i = 0; i < sha3_256_hash_size / 8; i++) {
+			const uint64_t word = state[i][l];
+			me64_to_le_str(digest[l] + 8 * i, &word, 8);
+		}
+		memzero(tail[l], len % block_size);
+	}
+	memzero(state, sizeof(state));
+}
+
+static void keccak_256_x4_generic(const unsigned char* const data[4], size_t len, unsigned char digest[4][sha3_256_hash_size])
+{
+	keccak_256_x4_body(data, len, digest);
+}
+
+#if defined(__x86_64__)
+#define KECCAK_X4_AVX2 1
+
+__attribute__((target("avx2")))
+static void keccak_256_x4_avx2(const unsigned char* const data[4], size_t len, unsigned char digest[4][sha3_256_hash_size])
+{
+	keccak_256_x4_body(data, len, digest);
+}
+
+/* Detected on first use; racing threads store the same value */
+static int keccak_x4_avx2(void)
+{
+	static atomic_int avx2 = -1;
+	int supported = atomic_load_explicit(&avx2, memory_order_relaxed);
+	if (supported < 0) {
+		__builtin_cpu_init();
+		supported = __builtin_cpu_supports("avx2") ? 1 : 0;
+		atomic_store_explicit(&avx2, supported, memory_order_relaxed);
+	}
+	return supported;
+}
+#endif
+
+void keccak_256_x4(const unsigned char* const data[4], size_t len, unsigned char digest[4][sha3_256_hash_size])
+{
+#if KECCAK_X4_AVX2
+	if (keccak_x4_avx2()) {
+		keccak_256_x4_avx2(data, len, digest);
+		return;
+	}
+#endif
+	keccak_256_x4_generic(data, len, digest);
+}
+
+#else /* !__GNUC__ */
+
+void keccak_256_x4(const unsigned char* const data[4], size_t len, unsigned char digest[4][sha3_256_hash_size])
+{
+	for (int l = 0; l < 4; l++) {
+		keccak_256(data[l], len, digest[l]);
+	}
+}
+
+#endif /* __GNUC__ */
 #endif /* USE_KECCAK */
 
 void sha3_256(const unsigned char* data, size_t len, unsigned char* digest)
@@ -71,6 +71,7 @@
 #include <TrezorCrypto/sha3.h>
 #include <TrezorCrypto/shamir.h>
 #include <TrezorCrypto/schnorr.h> // [wallet-core]
+#include <TrezorCrypto/scrypt.h> // [wallet-core]
 //#include <TrezorCrypto/slip39.h> // [wallet-core]
 //#include <TrezorCrypto/slip39_wordlist.h>
 
@@ -952,6 +953,77 @@ START_TEST(test_bignum_sqrt) {
 }
 END_TEST
 
+#if USE_BN_INT128  // [wallet-core]
+// 29-bit limb implementation that bn_multiply replaces on 64-bit targets
+void bn_multiply_long(const bignum256 *k, const bignum256 *x,
+                      uint32_t res[2 * BN_LIMBS]);
+void bn_multiply_reduce(bignum256 *x, uint32_t res[2 * BN_LIMBS],
+                        const bignum256 *prime);
+
+START_TEST(test_bignum_multiply_int128) {
+  const bignum256 *primes[] = {&secp256k1.prime, &secp256k1.order,
+                               &nist256p1.prime, &nist256p1.order};
+  bignum256 a, b, c, expected, max, bound;
+  uint32_t res[2 * BN_LIMBS];
+  uint8_t buf[32];
+  bn_word_field field;
+  bn_word256 aw, bw;
+
+  memset(buf, 0xff, sizeof(buf));
+  bn_read_be(buf, &max);
+
+  for (size_t i = 0; i < sizeof(primes) / sizeof(*primes); i++) {
+    // the result must be partly reduced
+    bn_copy(primes[i], &bound);
+    bn_lshift(&bound);
+
+    for (int j = 0; j < 1000; j++) {
+      switch (j) {
+        case 0:  // largest normalized inputs
+          a = max;
+          b = max;
+          break;
+        case 1:  // (p - 1)^2
+          bn_copy(primes[i], &a);
+          bn_subi(&a, 1, primes[i]);
+          b = a;
+          break;
+        default:
+          random_buffer(buf, sizeof(buf));
+          bn_read_be(buf, &a);
+          random_buffer(buf, sizeof(buf));
+          bn_read_be(buf, &b);
+          break;
+      }
+
+      bn_multiply_long(&a, &b, res);
+      bn_multiply_reduce(&expected, res, primes[i]);
+      bn_mod(&expected, primes[i]);
+
+      if (primes[i] == &secp256k1.prime || primes[i] == &nist256p1.prime) {
+        // the same product in words, from fully reduced inputs
+        bn_word_field_init(&field, primes[i]);
+        bn_copy(&a, &c);
+        bn_mod(&c, primes[i]);
+        bn_to_word256(&c, &aw, &field);
+        bn_copy(&b, &c);
+        bn_mod(&c, primes[i]);
+        bn_to_word256(&c, &bw, &field);
+        bn_word_multiply(&aw, &bw, &field);
+        bn_from_word256(&bw, &c);
+        ck_assert_int_eq(bn_is_equal(&c, &expected), 1);
+      }
+
+      bn_multiply(&a, &b, primes[i]);
+      ck_assert_int_eq(bn_is_less(&b, &bound), 1);
+      bn_mod(&b, primes[i]);
+      ck_assert_int_eq(bn_is_equal(&b, &expected), 1);
+    }
+  }
+}
+END_TEST
+#endif
+
 // https://tools.ietf.org/html/rfc4648#section-10
 START_TEST(test_base32_rfc4648) {
   const struct {
@@ -3977,6 +4049,69 @@ START_TEST(test_sha1) {
 }
 END_TEST
 
+// [wallet-core]
+START_TEST(test_sha2_hw) {
+  // the SHA instructions, when available, must agree with the portable code
+  uint8_t data[300];
+  random_buffer(data, sizeof(data));
+
+  for (size_t len = 0; len <= sizeof(data); len += 7) {
+    uint8_t sha1_hw[SHA1_DIGEST_LENGTH], sha1_portable[SHA1_DIGEST_LENGTH];
+    uint8_t sha256_hw[SHA256_DIGEST_LENGTH],
+        sha256_portable[SHA256_DIGEST_LENGTH];
+
+    sha2_hw_set_enabled(1);
+    sha1_Raw(data, len, sha1_hw);
+    sha256_Raw(data, len, sha256_hw);
+    sha2_hw_set_enabled(0);
+    sha1_Raw(data, len, sha1_portable);
+    sha256_Raw(data, len, sha256_portable);
+
+    ck_assert_mem_eq(sha1_hw, sha1_portable, SHA1_DIGEST_LENGTH);
+    ck_assert_mem_eq(sha256_hw, sha256_portable, SHA256_DIGEST_LENGTH);
+  }
+
+  // the output state may alias the message block, as in hmac_drbg
+  uint32_t block[16], state[8];
+  memcpy(block, data, sizeof(block));
+  sha2_hw_set_enabled(0);
+  sha256_Transform(sha256_initial_hash_value, block, state);
+  sha2_hw_set_enabled(1);
+  sha256_Transform(sha256_initial_hash_value, block, block);
+  ck_assert_mem_eq(block, state, sizeof(state));
+}
+END_TEST
+
+// [wallet-core]
+START_TEST(test_sha2_multi) {
+  // every lane must agree with the single-message functions, for lengths
+  // with one and two padding blocks
+  uint8_t data[8][300];
+  random_buffer((uint8_t *)data, sizeof(data));
+  const uint8_t *messages[8];
+  for (int i = 0; i < 8; i++) {
+    messages[i] = data[i];
+  }
+
+  for (size_t len = 0; len <= sizeof(data[0]); len += 7) {
+    uint8_t sha256[8][SHA256_DIGEST_LENGTH], sha512[4][SHA512_DIGEST_LENGTH];
+    uint8_t expected[SHA512_DIGEST_LENGTH];
+
+    sha256_Raw_x8(messages, len, sha256);
+    for (int i = 0; i < 8; i++) {
+      sha256_Raw(data[i], len, expected);
+      ck_assert_mem_eq(sha256[i], expected, SHA256_DIGEST_LENGTH);
+    }
+
+    sha512_Raw_x4(messages, len, sha512);
+    for (int i = 0; i < 4; i++) {
+      sha512_Raw(data[i], len, expected);
+      ck_assert_mem_eq(sha512[i], expected, SHA512_DIGEST_LENGTH);
+    }
+  }
+}
+END_TEST
+
 #define TEST7_256 "\xbe\x27\x46\xc6\xdb\x52\x76\x5f\xdb\x2f\x88\x70\x0f\x9a\x73"
 #define TEST8_256 \
   "\xe3\xd7\x25\x70\xdc\xdd\x78\x7c\xe3\x88\x7a\xb2\xcd\x68\x46\x52"
@@ -4494,6 +4629,35 @@ START_TEST(test_keccak_256) {
 }
 END_TEST
 
+// [wallet-core]
+START_TEST(test_keccak_256_x4) {
+  // every lane must agree with keccak_256, for lengths around the block size
+  uint8_t data[4][300];
+  random_buffer((uint8_t *)data, sizeof(data));
+  const uint8_t *messages[4] = {data[0], data[1], data[2], data[3]};
+
+  for (size_t len = 0; len <= sizeof(data[0]); len += 7) {
+    uint8_t digests[4][SHA3_256_DIGEST_LENGTH];
+    uint8_t expected[SHA3_256_DIGEST_LENGTH];
+    keccak_256_x4(messages, len, digests);
+    for (int i = 0; i < 4; i++) {
+      keccak_256(data[i], len, expected);
+      ck_assert_mem_eq(digests[i], expected, SHA3_256_DIGEST_LENGTH);
+    }
+  }
+
+  const size_t boundaries[] = {SHA3_256_BLOCK_LENGTH - 1, SHA3_256_BLOCK_LENGTH,
+                               2 * SHA3_256_BLOCK_LENGTH};
+  for (size_t i = 0; i < sizeof(boundaries) / sizeof(boundaries[0]); i++) {
+    uint8_t digests[4][SHA3_256_DIGEST_LENGTH];
+    uint8_t expected[SHA3_256_DIGEST_LENGTH];
+    keccak_256_x4(messages, boundaries[i], digests);
+    keccak_256(data[3], boundaries[i], expected);
+    ck_assert_mem_eq(digests[3], expected, SHA3_256_DIGEST_LENGTH);
+  }
+}
+END_TEST
+
 // test vectors from
 // https://raw.githubusercontent.com/monero-project/monero/master/tests/hash/tests-extra-blake.txt
 START_TEST(test_blake256) {
@@ -4815,6 +4979,107 @@ START_TEST(test_pbkdf2_hmac_sha512) {
 }
 END_TEST
 
+// [wallet-core]
+START_TEST(test_pbkdf2_hmac_sha512_x4) {
+  const char *passwords[4] = {"password", "passwordPASSWORDpassword", "",
+                              "pass\x00word"};
+  const int passlen[4] = {8, 3 * 8, 0, 9};
+  const char *salts[4] = {"salt", "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+                          "salt", "sa\x00lt"};
+  const int saltlen[4] = {4, 9 * 4, 4, 5};
+  const uint8_t *pass[4], *salt[4];
+  for (int l = 0; l < 4; l++) {
+    pass[l] = (const uint8_t *)passwords[l];
+    salt[l] = (const uint8_t *)salts[l];
+  }
+  uint8_t keys[4][64], k[64];
+
+  pbkdf2_hmac_sha512_x4(pass, passlen, salt, saltlen, 4096, keys);
+  ck_assert_mem_eq(
+      keys[0],
+      fromhex(
+          "d197b1b33db0143e018b12f3d1d1479e6cdebdcc97c5c0f87f6902e072f457b5143f"
+          "30602641b3d55cd335988cb36b84376060ecd532e039b742a239434af2d5"),
+      64);
+  ck_assert_mem_eq(
+      keys[1],
+      fromhex(
+          "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71115b"
+          "59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b8"),
+      64);
+  for (uint32_t iterations = 1; iterations <= 3; iterations++) {
+    pbkdf2_hmac_sha512_x4(pass, passlen, salt, saltlen, iterations, keys);
+    for (int l = 0; l < 4; l++) {
+      pbkdf2_hmac_sha512(pass[l], passlen[l], salt[l], saltlen[l], iterations,
+                         k, 64);
+      ck_assert_mem_eq(keys[l], k, 64);
+    }
+  }
+}
+END_TEST
+
+// [wallet-core] Runs the scrypt workers one after the other, in reverse order
+static void scrypt_reverse_workers(scrypt_worker_fn work, void *context,
+                                   uint32_t workers, void *runner) {
+  *(uint32_t *)runner = workers;
+  for (uint32_t t = workers; t > 0; t--) {
+    work(context, t - 1);
+  }
+}
+
+// [wallet-core] test vectors from RFC 7914
+START_TEST(test_scrypt) {
+  uint8_t k[64];
+
+  ck_assert_int_eq(scrypt((const uint8_t *)"", 0, (const uint8_t *)"", 0, 16,
+                          1, 1, k, 64),
+                   0);
+  ck_assert_mem_eq(
+      k,
+      fromhex(
+          "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0"
+          "069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906"),
+      64);
+
+  const char *expected =
+      "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30"
+      "d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640";
+  ck_assert_int_eq(scrypt((const uint8_t *)"password", 8,
+                          (const uint8_t *)"NaCl", 4, 1024, 8, 16, k, 64),
+                   0);
+  ck_assert_mem_eq(k, fromhex(expected), 64);
+
+  for (uint32_t workers = 2; workers <= 32; workers *= 4) {
+    uint32_t called = 0;
+    memset(k, 0, sizeof(k));
+    ck_assert_int_eq(scrypt_parallel((const uint8_t *)"password", 8,
+                                     (const uint8_t *)"NaCl", 4, 1024, 8, 16,
+                                     k, 64, workers, scrypt_reverse_workers,
+                                     &called),
+                     0);
+    // at most one worker per lane
+    ck_assert_int_eq(called, workers < 16 ? workers : 16);
+    ck_assert_mem_eq(k, fromhex(expected), 64);
+  }
+
+  ck_assert_int_eq(
+      scrypt((const uint8_t *)"pleaseletmein", 13,
+             (const uint8_t *)"SodiumChloride", 14, 16384, 8, 1, k, 64),
+      0);
+  ck_assert_mem_eq(
+      k,
+      fromhex(
+          "7023bdcb3afd7348461c06cd81fd38ebfda8fbba904f8e3ea9b543f6545da1f2d543"
+          "2955613f0fcf62d49705242a9af9e61e85dc0d651e40dfcf017b45575887"),
+      64);
+
+  // invalid cost factor
+  ck_assert_int_eq(scrypt((const uint8_t *)"", 0, (const uint8_t *)"", 0, 15,
+                          1, 1, k, 64),
+                   -1);
+}
+END_TEST
+
 START_TEST(test_hmac_drbg) {
   char entropy[] =
       "06032cd5eed33f39265f49ecb142c511da9aff2af71203bffaf34a9ca5bd9c0d";
@@ -5304,6 +5569,62 @@ START_TEST(test_mnemonic_find_word) {
 }
 END_TEST
 
+// [wallet-core]
+START_TEST(test_mnemonic_prefix_range) {
+  ck_assert_int_eq(-1, mnemonic_find_word(""));
+  ck_assert_int_eq(-1, mnemonic_find_word("a"));
+  ck_assert_int_eq(-1, mnemonic_find_word("Abandon"));
+  ck_assert_int_eq(-1, mnemonic_find_word("abandonx"));
+  ck_assert_int_eq(2047, mnemonic_find_word("zoo"));
+
+  // every prefix of up to 3 letters against a linear scan
+  char prefix[4] = {0};
+  for (int len = 1; len <= 3; len++) {
+    const int count = len == 1 ? 27 : (len == 2 ? 27 * 27 : 27 * 27 * 27);
+    for (int p = 0; p < count; p++) {
+      // '{' follows 'z' and starts no word
+      for (int c = 0, rest = p; c < len; c++, rest /= 27) {
+        prefix[c] = 'a' + rest % 27;
+      }
+      int expected_begin = -1, expected_end = -1;
+      uint32_t expected_mask = 0;
+      for (int i = 0; i < BIP39_WORDS; i++) {
+        const char *word = mnemonic_get_word(i);
+        if (strncmp(word, prefix, len) == 0) {
+          if (expected_begin < 0) {
+            expected_begin = i;
+          }
+          expected_end = i + 1;
+          if (word[len] != 0) {
+            expected_mask |= 1 << (word[len] - 'a');
+          }
+        }
+      }
+      int begin = 0, end = 0;
+      mnemonic_prefix_range(prefix, len, &begin, &end);
+      if (expected_begin < 0) {
+        ck_assert_int_eq(begin, end);
+        ck_assert(mnemonic_complete_word(prefix, len) == NULL);
+      } else {
+        ck_assert_int_eq(begin, expected_begin);
+        ck_assert_int_eq(end, expected_end);
+        ck_assert_str_eq(mnemonic_complete_word(prefix, len),
+                         mnemonic_get_word(expected_begin));
+      }
+      ck_assert_int_eq(mnemonic_word_completion_mask(prefix, len),
+                        expected_mask);
+    }
+  }
+
+  int begin = -1, end = -1;
+  mnemonic_prefix_range("", 0, &begin, &end);
+  ck_assert_int_eq(begin, 0);
+  ck_assert_int_eq(end, BIP39_WORDS);
+  mnemonic_prefix_range(" a", 2, &begin, &end);
+  ck_assert_int_eq(begin, end);
+}
+END_TEST
+
 /* // [wallet-core]
 START_TEST(test_slip39_get_word) {
   const struct {
@@ -6135,6 +6456,100 @@ END_TEST
 START_TEST(test_scalar_mult_nist256p1) { test_scalar_mult_curve(&nist256p1); }
 END_TEST
 
+#if USE_PRECOMPUTED_CP_SERVER  // [wallet-core]
+static void test_scalar_mult_server_curve(const ecdsa_curve *curve) {
+  int i;
+  // get a "random" number
+  bignum256 a = curve->G.x;
+  curve_point p1, p2;
+  for (i = 0; i < 1000; i++) {
+    /* server tables give the same result as the default table */
+    bn_mod(&a, &curve->order);
+    ecdsa_set_server_tables(0);
+    scalar_multiply(curve, &a, &p1);
+    ecdsa_set_server_tables(1);
+    scalar_multiply(curve, &a, &p2);
+    ck_assert_mem_eq(&p1, &p2, sizeof(curve_point));
+    // new "random" number
+    a = p1.x;
+  }
+  ck_assert_int_eq(ecdsa_server_tables_enabled(), 1);
+  test_mult_border_cases_curve(curve);
+}
+
+START_TEST(test_scalar_mult_server_secp256k1) {
+  test_scalar_mult_server_curve(&secp256k1);
+}
+END_TEST
+START_TEST(test_scalar_mult_server_nist256p1) {
+  test_scalar_mult_server_curve(&nist256p1);
+}
+END_TEST
+#endif
+
+// [wallet-core]
+static void test_ecdsa_verify_batch_curve(const ecdsa_curve *curve) {
+  enum { COUNT = 70 };
+  static uint8_t priv_keys[COUNT][32], pub_keys[COUNT][65], sigs[COUNT][64],
+      digests[COUNT][32];
+  const uint8_t *pub_key_ptrs[COUNT], *sig_ptrs[COUNT], *digest_ptrs[COUNT];
+  int results[COUNT];
+  int i, res;
+
+  for (i = 0; i < COUNT; i++) {
+    memset(priv_keys[i], 0x11, 32);
+    priv_keys[i][31] = (uint8_t)i;
+    memset(digests[i], 0x22, 32);
+    digests[i][31] = (uint8_t)i;
+    if (i % 2) {
+      ecdsa_get_public_key33(curve, priv_keys[i], pub_keys[i]);
+    } else {
+      ecdsa_get_public_key65(curve, priv_keys[i], pub_keys[i]);
+    }
+    res = ecdsa_sign_digest(curve, priv_keys[i], digests[i], sigs[i], NULL,
+                            NULL);
+    ck_assert_int_eq(res, 0);
+    pub_key_ptrs[i] = pub_keys[i];
+    sig_ptrs[i] = sigs[i];
+    digest_ptrs[i] = digests[i];
+  }
+
+  res = ecdsa_verify_digest_batch(curve, COUNT, pub_key_ptrs, sig_ptrs,
+                                  digest_ptrs, results);
+  ck_assert_int_eq(res, 0);
+  for (i = 0; i < COUNT; i++) {
+    ck_assert_int_eq(results[i], 0);
+  }
+
+  // invalid public key, zero r, zero digest, wrong digest, wrong signature,
+  // signature of another key
+  pub_keys[3][0] = 0x05;
+  memset(sigs[10], 0, 32);
+  memset(digests[20], 0, 32);
+  digests[33][0] ^= 1;
+  sigs[40][63] ^= 1;
+  memcpy(pub_keys[50], pub_keys[52], 65);
+
+  res = ecdsa_verify_digest_batch(curve, COUNT, pub_key_ptrs, sig_ptrs,
+                                  digest_ptrs, results);
+  ck_assert_int_eq(res, 1);
+  for (i = 0; i < COUNT; i++) {
+    ck_assert_int_eq(results[i], ecdsa_verify_digest(curve, pub_keys[i],
+                                                     sigs[i], digests[i]));
+    ck_assert_int_eq(results[i] == 0, i != 3 && i != 10 && i != 20 &&
+                                          i != 33 && i != 40 && i != 50);
+  }
+}
+
+START_TEST(test_ecdsa_verify_batch_secp256k1) {
+  test_ecdsa_verify_batch_curve(&secp256k1);
+}
+END_TEST
+START_TEST(test_ecdsa_verify_batch_nist256p1) {
+  test_ecdsa_verify_batch_curve(&nist256p1);
+}
+END_TEST
+
 static void test_point_mult_curve(const ecdsa_curve *curve) {
   int i;
   // get two "random" numbers and a "random" point
@@ -9011,6 +9426,9 @@ Suite *test_suite(void) {
   tcase_add_test(tc, test_bignum_format);
   tcase_add_test(tc, test_bignum_format_uint64);
   tcase_add_test(tc, test_bignum_sqrt);
+#if USE_BN_INT128  // [wallet-core]
+  tcase_add_test(tc, test_bignum_multiply_int128);
+#endif
   suite_add_tcase(s, tc);
 
   tc = tcase_create("base32");
@@ -9110,12 +9528,15 @@ Suite *test_suite(void) {
   tcase_add_test(tc, test_sha1);
   tcase_add_test(tc, test_sha256);
   tcase_add_test(tc, test_sha512);
+  tcase_add_test(tc, test_sha2_hw);
+  tcase_add_test(tc, test_sha2_multi);
   suite_add_tcase(s, tc);
 
   tc = tcase_create("sha3");
   tcase_add_test(tc, test_sha3_256);
   tcase_add_test(tc, test_sha3_512);
   tcase_add_test(tc, test_keccak_256);
+  tcase_add_test(tc, test_keccak_256_x4);
   suite_add_tcase(s, tc);
 
   tc = tcase_create("blake");
@@ -9134,6 +9555,11 @@ Suite *test_suite(void) {
   tc = tcase_create("pbkdf2");
   tcase_add_test(tc, test_pbkdf2_hmac_sha256);
   tcase_add_test(tc, test_pbkdf2_hmac_sha512);
+  tcase_add_test(tc, test_pbkdf2_hmac_sha512_x4);
+  suite_add_tcase(s, tc);
+
+  tc = tcase_create("scrypt");
+  tcase_add_test(tc, test_scrypt);
   suite_add_tcase(s, tc);
 
   tc = tcase_create("hmac_drbg");
@@ -9145,6 +9571,7 @@ Suite *test_suite(void) {
   tcase_add_test(tc, test_mnemonic_check);
   tcase_add_test(tc, test_mnemonic_to_bits);
   tcase_add_test(tc, test_mnemonic_find_word);
+  tcase_add_test(tc, test_mnemonic_prefix_range);  // [wallet-core]
   suite_add_tcase(s, tc);
 
 /*
@@ -9184,6 +9611,19 @@ Suite *test_suite(void) {
   tcase_add_test(tc, test_scalar_mult_nist256p1);
   suite_add_tcase(s, tc);
 
+#if USE_PRECOMPUTED_CP_SERVER  // [wallet-core]
+  tc = tcase_create("scalar_mult_server");
+  tcase_add_test(tc, test_scalar_mult_server_secp256k1);
+  tcase_add_test(tc, test_scalar_mult_server_nist256p1);
+  suite_add_tcase(s, tc);
+#endif
+
+  // [wallet-core]
+  tc = tcase_create("ecdsa_verify_batch");
+  tcase_add_test(tc, test_ecdsa_verify_batch_secp256k1);
+  tcase_add_test(tc, test_ecdsa_verify_batch_nist256p1);
+  suite_add_tcase(s, tc);
+
   tc = tcase_create("point_mult");
   tcase_add_test(tc, test_point_mult_secp256k1);
   tcase_add_test(tc, test_point_mult_nist256p1);
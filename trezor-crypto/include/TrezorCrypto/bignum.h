@@ -125,6 +125,40 @@ size_t bn_format(const bignum256 *amount, const char *prefix,
                  const char *suffix, unsigned int decimals, int exponent,
                  bool trailing, char *output, size_t output_length);
 
+#if USE_BN_INT128  // [wallet-core]
+// Field elements in little-endian 64-bit words, fully reduced modulo the
+// prime of a bn_word_field.  Elliptic curve ladders keep their coordinates
+// in this form instead of converting them in every bn_multiply.
+typedef struct {
+  uint64_t w[4];
+} bn_word256;
+
+// A prime with 2**256 - 2**224 <= prime < 2**256 and how to reduce by it
+typedef struct {
+  uint64_t prime[4];
+  uint64_t complement[4];  // 2**256 - prime
+  int complement_bits;
+  int p256;  // the nist256p1 prime
+} bn_word_field;
+
+void bn_word_field_init(bn_word_field *field, const bignum256 *prime);
+void bn_to_word256(const bignum256 *x, bn_word256 *res,
+                   const bn_word_field *field);
+void bn_from_word256(const bn_word256 *x, bignum256 *res);
+void bn_word_multiply(const bn_word256 *k, bn_word256 *x,
+                      const bn_word_field *field);
+void bn_word_addmod(bn_word256 *x, const bn_word256 *y,
+                    const bn_word_field *field);
+void bn_word_subtractmod(const bn_word256 *x, const bn_word256 *y,
+                         bn_word256 *res, const bn_word_field *field);
+void bn_word_mult_half(bn_word256 *x, const bn_word_field *field);
+void bn_word_cnegate(uint32_t cond, bn_word256 *x,
+                     const bn_word_field *field);
+void bn_word_cmov(bn_word256 *res, uint32_t cond, const bn_word256 *truecase,
+                  const bn_word256 *falsecase);
+uint32_t bn_word_is_zero(const bn_word256 *x);
+#endif
+
 // Returns (uint32_t) in_number
 // Assumes in_number < 2**32
 // Assumes in_number is normalized
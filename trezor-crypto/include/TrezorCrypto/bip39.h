@@ -54,13 +54,24 @@ void mnemonic_to_seed(const char *mnemonic, const char *passphrase,
                       void (*progress_callback)(uint32_t current,
                                                 uint32_t total));
 
-#ifdef __cplusplus
-} /* extern "C" */
-#endif
+// [wallet-core] Same as mnemonic_to_seed for 4 mnemonics at once, without
+// cache or progress callback
+void mnemonic_to_seed_x4(const char *const mnemonic[4],
+                         const char *const passphrase[4],
+                         uint8_t seed[4][512 / 8]);
 
+// [wallet-core] Moved into the extern "C" block
 int mnemonic_find_word(const char *word);
 const char *mnemonic_complete_word(const char *prefix, int len);
 const char *mnemonic_get_word(int index);
 uint32_t mnemonic_word_completion_mask(const char *prefix, int len);
 
+// [wallet-core] Indices [begin, end) of the words starting with the first len
+// characters of prefix, all words if len <= 0
+void mnemonic_prefix_range(const char *prefix, int len, int *begin, int *end);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif
@@ -78,6 +78,12 @@ int point_is_equal(const curve_point *p, const curve_point *q);
 int point_is_negative_of(const curve_point *p, const curve_point *q);
 void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k,
                      curve_point *res);
+#if USE_PRECOMPUTED_CP_SERVER  // [wallet-core]
+// Enables (default) or disables the larger fixed-base tables used by
+// scalar_multiply; the tables are built on first use after enabling.
+void ecdsa_set_server_tables(int enabled);
+int ecdsa_server_tables_enabled(void);
+#endif
 int ecdh_multiply(const ecdsa_curve *curve, const uint8_t *priv_key,
                   const uint8_t *pub_key, uint8_t *session_key);
 void compress_coords(const curve_point *cp, uint8_t *compressed);
@@ -124,6 +130,11 @@ int ecdsa_verify(const ecdsa_curve *curve, HasherType hasher_sign,
                  uint32_t msg_len);
 int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key,
                         const uint8_t *sig, const uint8_t *digest);
+// [wallet-core]
+int ecdsa_verify_digest_batch(const ecdsa_curve *curve, size_t count,
+                              const uint8_t *const *pub_keys,
+                              const uint8_t *const *sigs,
+                              const uint8_t *const *digests, int *results);
 int ecdsa_recover_pub_from_sig(const ecdsa_curve *curve, uint8_t *pub_key,
                                const uint8_t *sig, const uint8_t *digest,
                                int recid);
@@ -36,6 +36,23 @@
 #define USE_PRECOMPUTED_CP 1
 #endif
 
+// use larger precomputed Curve Points for secp256k1 and nist256p1, built on
+// first use; can be switched off at runtime with ecdsa_set_server_tables
+// [wallet-core]
+#ifndef USE_PRECOMPUTED_CP_SERVER
+#define USE_PRECOMPUTED_CP_SERVER 0
+#endif
+
+// use 64-bit words and 128-bit products in bn_multiply on 64-bit targets
+// [wallet-core]
+#ifndef USE_BN_INT128
+#if defined(__SIZEOF_INT128__) && (defined(__x86_64__) || defined(__aarch64__))
+#define USE_BN_INT128 1
+#else
+#define USE_BN_INT128 0
+#endif
+#endif
+
 // use fast inverse method
 #ifndef USE_INVERSE_FAST
 #define USE_INVERSE_FAST 1
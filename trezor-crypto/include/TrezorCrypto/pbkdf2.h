@@ -66,6 +66,12 @@ void pbkdf2_hmac_sha512_Final(PBKDF2_HMAC_SHA512_CTX *pctx, uint8_t *key);
 void pbkdf2_hmac_sha512(const uint8_t *pass, int passlen, const uint8_t *salt,
                         int saltlen, uint32_t iterations, uint8_t *key,
                         int keylen);
+// [wallet-core] Derives 4 keys of one block (64 bytes) each at once, with the
+// iterations of the 4 passwords run together in vector lanes
+void pbkdf2_hmac_sha512_x4(const uint8_t *const pass[4], const int passlen[4],
+                           const uint8_t *const salt[4], const int saltlen[4],
+                           uint32_t iterations,
+                           uint8_t key[4][SHA512_DIGEST_LENGTH]);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -56,6 +56,26 @@ extern "C"{
 int scrypt(const uint8_t *, size_t, const uint8_t *, size_t, uint64_t,
     uint32_t, uint32_t, /*@out@*/ uint8_t *, size_t);
 
+/**
+ * [wallet-core] Parallel loop: must call work(context, t) once for each
+ * t < workers, possibly concurrently, and return once all calls completed.
+ */
+typedef void (*scrypt_worker_fn)(void * context, uint32_t t);
+typedef void (*scrypt_parallel_fn)(scrypt_worker_fn work, void * context,
+    uint32_t workers, void * runner);
+
+/**
+ * scrypt_parallel(passwd, passwdlen, salt, saltlen, N, r, p, buf, buflen,
+ *     workers, parallel, runner):
+ * [wallet-core] Same as scrypt, with the p independent SMix lanes split
+ * between up to `workers` workers run by parallel(..., runner).  Each worker
+ * allocates its own 128rN bytes.  With a single worker or a NULL parallel,
+ * the lanes run one after the other, as in scrypt.
+ */
+int scrypt_parallel(const uint8_t *, size_t, const uint8_t *, size_t,
+    uint64_t, uint32_t, uint32_t, /*@out@*/ uint8_t *, size_t, uint32_t,
+    scrypt_parallel_fn, void *);
+
 #ifdef __cplusplus
 }
 #endif
@@ -116,7 +116,21 @@ void sha512_Final(SHA512_CTX*, uint8_t[SHA512_DIGEST_LENGTH]);
 char* sha512_End(SHA512_CTX*, char[SHA512_DIGEST_STRING_LENGTH]);
 void sha512_Raw(const uint8_t*, size_t, uint8_t[SHA512_DIGEST_LENGTH]);
 // [wallet-core]
+void sha512_256_Init(SHA512_CTX*);
+// [wallet-core] Whether the CPU has SHA instructions used by sha1_Transform and sha256_Transform
+int sha2_hw_supported(void);
+// [wallet-core] Enables (default) or disables the SHA instructions, e.g. to compare with the portable code
+void sha2_hw_set_enabled(int enabled);
 void sha512_256_Raw(const uint8_t*, size_t, uint8_t[SHA256_DIGEST_LENGTH]);
+// [wallet-core] Hashes 8 messages of `len` bytes each at once, one per vector lane
+void sha256_Raw_x8(const uint8_t* const data[8], size_t len, uint8_t digest[8][SHA256_DIGEST_LENGTH]);
+// [wallet-core] Hashes 4 messages of `len` bytes each at once, one per vector lane
+void sha512_Raw_x4(const uint8_t* const data[4], size_t len, uint8_t digest[4][SHA512_DIGEST_LENGTH]);
+// [wallet-core] Runs `iterations` PBKDF2-HMAC-SHA512 iterations on host-order words: the previous
+// digest `u` is hashed after the ipad and opad states, and each new digest is xor-ed into `x`
+void sha512_pbkdf2_iterate(const uint64_t istate[8], const uint64_t ostate[8], uint64_t u[8], uint64_t x[8], uint32_t iterations);
+// [wallet-core] Runs sha512_pbkdf2_iterate on 4 independent states at once, one per vector lane
+void sha512_pbkdf2_iterate_x4(const uint64_t istate[4][8], const uint64_t ostate[4][8], uint64_t u[4][8], uint64_t x[4][8], uint32_t iterations);
 char* sha512_Data(const uint8_t*, size_t, char[SHA512_DIGEST_STRING_LENGTH]);
 
 #ifdef __cplusplus
@@ -77,6 +77,8 @@ void sha3_Final(SHA3_CTX *ctx, unsigned char* result);
 void keccak_Final(SHA3_CTX *ctx, unsigned char* result);
 void keccak_256(const unsigned char* data, size_t len, unsigned char* digest);
 void keccak_512(const unsigned char* data, size_t len, unsigned char* digest);
+// [wallet-core] Hashes 4 messages of `len` bytes each at once, one per vector lane
+void keccak_256_x4(const unsigned char* const data[4], size_t len, unsigned char digest[4][sha3_256_hash_size]);
 #endif
 
 void sha3_256(const unsigned char* data, size_t len, unsigned char* digest);